@@ -6,54 +6,116 @@
 #include "config.h"
 #include "system_logger.h" 
 #include "data_logger.h"
-#include "dht_sensor.h"
 #include "sleep_manager.h"
 #include "time_manager.h"
 #include "web_server.h"
 #include "oled_display.h"
 #include "wifi_manager.h"
-#include "esp_sleep.h"
 #include "settings_manager.h"
+#include "metrics.h"
+#include "subsystem.h"
+#include "live_data.h"
+#include "log_sampler.h"
+#include "scheduler.h"
+#include "trace.h"
+#include "hal/hal_clock.h"
+#include "hal/hal_power.h"
 
 #define LOG_TAG "CONTROLLER" // Define a tag for DataLogger module logs
 
 // --- External Global Variables ---
 extern uint64_t time_last_logged_ms; 
 extern int deep_sleep_count;
-extern "C" uint64_t esp_rtc_get_time_us(); 
 
 // --- STATE VARIABLES FOR UI TIMING ---
-// Used to handle the OLED transition without blocking (delay)
+// Deadlines themselves are scheduler timers (see scheduler.h)
 static bool s_isShowingNetworkInfo = false;
-static unsigned long s_networkInfoStartTime = 0;
+static unsigned long s_lastButtonMs = 0; // Debounce
 
 // --- Helper Functions ---
-static void setupHardware() {
-    
-    LOG_INFO(LOG_TAG, "Hardware: Setting up hardware...");
-    
-    // 1. Initialize NVS Settings First (Critical for WiFi)
-    Settings.begin();
-
-    // 2. Initialize Sensors and Storage
-    if(DHTSensor_init()) {
-        LOG_INFO(LOG_TAG, "Hardware: DHT Sensor initialized.");
-    } else {
-        LOG_ERROR(LOG_TAG, "Hardware: DHT Sensor failed!");
+/**
+ * @brief Handles diagnostic commands typed on the Serial console while awake:
+ * "trace" (event trace JSON), "metrics" (wake cycle histograms), "log" (system log).
+ */
+static void handleSerialCommands() {
+    static char line[16];
+    static size_t len = 0;
+
+    while (Serial.available() > 0) {
+        char c = (char)Serial.read();
+        if (c != '\n' && c != '\r') {
+            if (len < sizeof(line) - 1) line[len++] = c;
+            continue;
+        }
+        if (len == 0) continue;
+        line[len] = '\0';
+        len = 0;
+
+        if (strcmp(line, "trace") == 0) {
+            Trace_dumpToSerial();
+        } else if (strcmp(line, "metrics") == 0) {
+            Metrics_dumpToSerial();
+        } else if (strcmp(line, "log") == 0) {
+            Logger_DumpToSerial();
+        } else {
+            Serial.printf("Unknown command '%s' (trace, metrics, log)\n", line);
+        }
     }
+}
 
-    if(DataLogger_init()) {
-        LOG_INFO(LOG_TAG, "Hardware: LittleFS initialized.");
+static void IRAM_ATTR onButtonPressed_isr() {
+    Scheduler_postFromISR(EVENT_BUTTON);
+}
+
+static void showNetworkInfo() {
+    OLEDDisplay_setMode(OLED_MODE_NETWORK);
+    s_isShowingNetworkInfo = true;
+    Scheduler_startTimer(EVENT_NETWORK_INFO_DONE, NETWORK_INFO_DURATION_MS);
+}
+
+static void showSensorData() {
+    OLEDDisplay_setMode(OLED_MODE_SENSORS);
+    s_isShowingNetworkInfo = false;
+    Scheduler_stopTimer(EVENT_NETWORK_INFO_DONE);
+}
+
+/**
+ * @brief A press while awake keeps the device awake for another
+ * WEB_SERVER_INACTIVITY_TIMEOUT and toggles the OLED view.
+ */
+static void handleButtonPress() {
+    unsigned long now = ::millis();
+    if (now - s_lastButtonMs < BUTTON_DEBOUNCE_MS) return;
+    s_lastButtonMs = now;
+
+    LOG_INFO(LOG_TAG, "Button pressed: inactivity timer reset.");
+    resetWebServerIdleTimer();
+    Scheduler_startTimer(EVENT_IDLE_TIMEOUT, WEB_SERVER_INACTIVITY_TIMEOUT);
+
+    if (s_isShowingNetworkInfo) {
+        showSensorData();
     } else {
-        LOG_ERROR(LOG_TAG, "Hardware: LittleFS Mount Failed!");
+        showNetworkInfo();
     }
 }
 
 static void startInteractiveServices() {
     LOG_INFO(LOG_TAG, "Starting Interactive Services...");
 
-    // 1. Initialize and update OLED
-    if (OLEDDisplay_init()) {   
+    // Before anything that posts events (web server, button, time sync)
+    Scheduler_init();
+
+    // SNTP as soon as the station connects (step 2), in the background
+    TimeManager_startNetworkSync(false);
+
+    // No deep sleep to trigger a log flush while awake, so flush periodically
+    Logger_StartBackgroundFlush();
+
+    // Nor a timer wake to take the next scheduled sample
+    LogSampler_startBackground();
+
+    // 1. Initialize and update OLED (already on after a button wake)
+    if (Subsystem_require(SUBSYSTEM_DISPLAY)) {   
         // Just set the initial scene
         OLEDDisplay_setMode(OLED_MODE_SENSORS);
         LOG_INFO(LOG_TAG, "OLED initialized and showing sensors.");
@@ -64,10 +126,7 @@ static void startInteractiveServices() {
         LOG_INFO(LOG_TAG, "WiFi Dual Mode started.");
 
         // Switch to network view. OLED will update itself as IP becomes ready.
-        OLEDDisplay_setMode(OLED_MODE_NETWORK);
-        
-        s_isShowingNetworkInfo = true;
-        s_networkInfoStartTime = ::millis();
+        showNetworkInfo();
         
         // 3. Start the Web Server
         if (activateWebServer()) {
@@ -78,19 +137,36 @@ static void startInteractiveServices() {
     } else {
         LOG_ERROR(LOG_TAG, "WiFi failed! WebServer skipped.");
     }
+
+    // 4. Arm the timers. Everything else arrives as an event.
+    if (Subsystem_isReady(SUBSYSTEM_DISPLAY)) {
+        Scheduler_startTimer(EVENT_DISPLAY_REFRESH, DISPLAY_REFRESH_INTERVAL_MS, DISPLAY_REFRESH_INTERVAL_MS);
+    }
+    Scheduler_startTimer(EVENT_LIVE_SAMPLE, 0, LIVE_SAMPLE_INTERVAL_MS);
+    Scheduler_startTimer(EVENT_SERIAL_POLL, SERIAL_POLL_INTERVAL_MS, SERIAL_POLL_INTERVAL_MS);
+    Scheduler_startTimer(EVENT_IDLE_TIMEOUT, WEB_SERVER_INACTIVITY_TIMEOUT);
+
+    s_lastButtonMs = ::millis(); // Ignore the release bounce of the wake press
+    HalPower_setButtonHandler(BUTTON_PIN, onButtonPressed_isr);
 }
 
 static void stopInteractiveServices() {
     LOG_INFO(LOG_TAG, "Stopping Interactive Services...");
+    HalPower_setButtonHandler(BUTTON_PIN, nullptr);
+    LogSampler_stopBackground();
+    TimeManager_finishNetworkSync();
     wifi_manager_turnOff();
     OLEDDisplay_turnOff();
 }
 
 // --- State Implementations ---
 AppState run_state_init() {
-    setupHardware();    
+    // Nothing else is started here: NVS, LittleFS, the sensor, the OLED and
+    // WiFi start on first use (see subsystem.h). On a timer wake the cycle
+    // is just clock sync -> sensor read -> sample buffered in RTC memory.
+    bool timerWake = (HalPower_getWakeupCause() == HAL_WAKEUP_TIMER) && !ENABLE_WEB_SERVER_ON_TIMER_WAKEUP;
     
-    // Logic: Internal -> External RTC -> NTP handled entirely by TimeManager
+    // Logic: External RTC -> Internal handled entirely by TimeManager
     if (TimeManager_startAndSync()) {
         LOG_INFO(LOG_TAG, "Time synchronization complete.");
     } else {
@@ -98,30 +174,37 @@ AppState run_state_init() {
         // We continue anyway, allowing manual override later via Web Interface
     }
 
+    // NTP never delays the sample: the station connects while the sensor is
+    // read. Interactive sessions sync once their station is up.
+    if (timerWake && TimeManager_isNetworkSyncDue(true)) {
+        TimeManager_startNetworkSync(true);
+    }
+
     return STATE_CHECK_WAKEUP; 
 }
 
 AppState run_state_check_wakeup(bool &stayAwakeFlag) {    
-    esp_sleep_wakeup_cause_t wakeup_reason = esp_sleep_get_wakeup_cause();
+    HalWakeupCause wakeup_reason = HalPower_getWakeupCause();
 
-    // Check for both Classic (EXT0) and New (GPIO) wakeup causes
-    if (wakeup_reason == ESP_SLEEP_WAKEUP_EXT0 || wakeup_reason == ESP_SLEEP_WAKEUP_GPIO) {
+    if (wakeup_reason == HAL_WAKEUP_BUTTON) {
         LOG_INFO(LOG_TAG, "Wakeup reason: Button Press");
+        Metrics_dumpToSerial();
         
         // Show cached data immediately for responsiveness
-        if (OLEDDisplay_init()) {
+        if (Subsystem_require(SUBSYSTEM_DISPLAY)) {
             OLEDDisplay_setMode(OLED_MODE_SENSORS);
         }
         
         delay(50); // Debounce
         stayAwakeFlag = true;
 
-    } else if (wakeup_reason == ESP_SLEEP_WAKEUP_TIMER) {
+    } else if (wakeup_reason == HAL_WAKEUP_TIMER) {
         LOG_INFO(LOG_TAG, "Wakeup reason: Timer (Scheduled Log)");
         stayAwakeFlag = ENABLE_WEB_SERVER_ON_TIMER_WAKEUP;
 
     } else {
         LOG_INFO(LOG_TAG, "Wakeup reason: System Reset / First Boot");
+        Metrics_dumpToSerial();
         
         stayAwakeFlag = true;
     }
@@ -131,19 +214,13 @@ AppState run_state_check_wakeup(bool &stayAwakeFlag) {
 
 AppState run_state_logging(bool stayAwakeFlag) {
     
-    uint64_t current_time_ms = esp_rtc_get_time_us() / 1000UL;
-    
-    float temp = DHTSensor_readTemperature();
-    float hum = DHTSensor_readHumidity();
-
-    LOG_DEBUG(LOG_TAG, "Raw Read -> T: %.1f, H: %.1f", temp, hum);
-
-    if (DataLogger_logSensorData(temp, hum)) {
-        LOG_INFO(LOG_TAG, "Logged successfully. T: %.1f C, H: %.1f %%", temp, hum);
+    // Updates time_last_logged_ms on success. Staying awake: the burst costs nothing extra
+    LogSampler_logSample(stayAwakeFlag);
 
-        time_last_logged_ms = current_time_ms;
-    } else {
-        LOG_ERROR(LOG_TAG, "Failed to write data to file!");
+    // Button wake / first boot: the user is about to look at the data,
+    // so persist anything still buffered in RTC memory.
+    if (stayAwakeFlag) {
+        DataLogger_flush();
     }
 
     if (stayAwakeFlag) {
@@ -161,38 +238,83 @@ AppState run_state_interactive() {
         isInitialized = true;
     }
 
-    // OLED periodic UI refresh to handle dynamic data (like IP assignment)
-    static unsigned long lastRefresh = 0;
-    if (millis() - lastRefresh > 500) {
-        OLEDDisplay_refresh();
-        lastRefresh = millis();
-    }
-
-    if (s_isShowingNetworkInfo) {
-        if (::millis() - s_networkInfoStartTime > 10000) {
-            LOG_INFO(LOG_TAG, "Reverting OLED to Sensor Data.");
-            OLEDDisplay_setMode(OLED_MODE_SENSORS);
-            s_isShowingNetworkInfo = false; 
+    // Sleep until the next event or timer deadline
+    AppEvent event = Scheduler_wait();
+
+    switch (event) {
+        case EVENT_BUTTON:
+            handleButtonPress();
+            break;
+
+        case EVENT_WEB_ACTIVITY:
+            Scheduler_startTimer(EVENT_IDLE_TIMEOUT, WEB_SERVER_INACTIVITY_TIMEOUT);
+            break;
+
+        case EVENT_TIME_SYNC:
+            TimeManager_serviceNetworkSync();
+            break;
+
+        case EVENT_TIME_SET:
+            TimeManager_serviceTimeSet();
+            break;
+
+        case EVENT_LIVE_SAMPLE:
+            // Live view: sample at the sensor's pace; EVENT_SENSOR_READY follows
+            LiveData_requestSample();
+            break;
+
+        case EVENT_SENSOR_READY: {
+            // Push to connected browsers
+            LiveSample sample;
+            if (LiveData_completeSample(sample)) {
+                publishLiveSample(sample);
+            }
+            break;
         }
-    }
 
-    if (stopWebServerIfIdle()) { 
-        LOG_INFO(LOG_TAG, "Inactivity timeout reached.");
-        stopInteractiveServices(); 
-        isInitialized = false; 
+        case EVENT_DISPLAY_REFRESH:
+            // Dynamic data (like IP assignment)
+            OLEDDisplay_refresh();
+            break;
 
-        return STATE_PREPARE_SLEEP;
+        case EVENT_NETWORK_INFO_DONE:
+            LOG_INFO(LOG_TAG, "Reverting OLED to Sensor Data.");
+            showSensorData();
+            break;
+
+        case EVENT_SERIAL_POLL:
+            handleSerialCommands();
+            break;
+
+        case EVENT_IDLE_TIMEOUT:
+            // The server keeps its own activity clock (an activity event may
+            // have been dropped). Without a server there is nothing to wait for.
+            if (stopWebServerIfIdle() || !isWebServerActive()) {
+                LOG_INFO(LOG_TAG, "Inactivity timeout reached.");
+                stopInteractiveServices();
+                isInitialized = false;
+
+                return STATE_PREPARE_SLEEP;
+            }
+            // Only the time left since that activity, not a full timeout
+            Scheduler_startTimer(EVENT_IDLE_TIMEOUT, getWebServerIdleRemainingMs());
+            break;
+
+        default:
+            break;
     }
 
-    delay(50); // Small delay to yield CPU 
-
     return STATE_INTERACTIVE; 
 }
 
 AppState run_state_prepare_sleep() {    
-    uint64_t now_ms = esp_rtc_get_time_us() / 1000UL;
+    // A timer wake's background NTP sync: finish it before the sleep is
+    // scheduled from the (possibly corrected) clock
+    TimeManager_finishNetworkSync();
+
+    uint64_t now_ms = HalClock_getRtcMicros() / 1000UL;
     
-    int64_t sleep_us = calculateSleepTime(time_last_logged_ms, now_ms, WAKEUP_OVERHEAD_MS, LOG_INTERVAL_SECONDS * 1000UL);
+    int64_t sleep_us = calculateAlignedSleepTime(time_last_logged_ms, now_ms);
 
     LOG_INFO(LOG_TAG, "Deep sleep cycles so far: %d", deep_sleep_count);
     deep_sleep_count++;
@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+
+// --- Host Build ([env:native]) ---
+// No real pins; the values only appear in log messages.
+
+// I2C (simulated DS3231, see hal/native/hal_i2c_native.cpp)
+constexpr int I2C_SDA_PIN = 21;
+constexpr int I2C_SCL_PIN = 22;
+
+// DHT Sensor (simulated)
+constexpr uint8_t DHT_PIN = 18;
+
+// Wakeup Button (--button on the command line)
+constexpr uint8_t BUTTON_PIN = 4;
+
+// OLED Reset
+constexpr int8_t OLED_RESET_PIN = -1;
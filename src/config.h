@@ -3,7 +3,10 @@
 
 #include <cstdint>
 #include <Arduino.h>
-#include <DHT.h>
+
+// Sensor type IDs (the values the Adafruit DHT library used)
+#define DHT11 11
+#define DHT22 22
 
 // --------------------------------------------------------------------------
 // 1. HARDWARE SELECTION (Pinout)
@@ -14,6 +17,8 @@
     #include "boards/pinout_firebeetle_c6.h"
 #elif defined(BOARD_ESP32_CLASSIC)
     #include "boards/pinout_esp32_classic.h"
+#elif defined(BOARD_NATIVE)
+    #include "boards/pinout_native.h"
 #else
     #error "Hardware board not defined! Check platformio.ini build_flags."
 #endif
@@ -26,7 +31,7 @@
     #define SENSOR_TYPE DHT11
 #endif
 
-// DHT_TYPE is used by the DHT library (DHT11, DHT22, etc.)
+// DHT_TYPE selects the start signal and the data format (see dht_decoder.h)
 constexpr uint8_t DHT_TYPE_DEF = SENSOR_TYPE; 
 
 // --------------------------------------------------------------------------
@@ -36,32 +41,143 @@ constexpr uint8_t DHT_TYPE_DEF = SENSOR_TYPE;
 // Logging Level
 #define SYSTEM_LOG_LEVEL  4 
 
+// Tokenized Logging (1 = store format IDs and raw arguments instead of text).
+// Much cheaper per call and per byte, but Serial output is off and the log
+// must be decoded on the host: tools/decode_log.py firmware.elf syslog.bin
+#ifndef SYSTEM_LOG_TOKENIZED
+#define SYSTEM_LOG_TOKENIZED 0
+#endif
+
 // Wi-Fi Configuration
 constexpr const char* AP_SSID = "ESP32_DataLogger";
 constexpr const char* AP_PASSWORD = "12345678"; 
 constexpr unsigned long WIFI_CONNECT_TIMEOUT_MS = 10000;
+constexpr bool WIFI_FAST_CONNECT_ENABLED = true;         // Rejoin the last BSSID/channel from RTC memory (no scan)
+constexpr uint32_t WIFI_LEASE_REUSE_S = 12 * 60 * 60;    // Reuse the last DHCP address this long (keep under the router's lease time)
+// Optional static address for the station ("" = DHCP). Skips DHCP on every connect.
+constexpr const char* WIFI_STATIC_IP = "";
+constexpr const char* WIFI_STATIC_GATEWAY = "";
+constexpr const char* WIFI_STATIC_SUBNET = "255.255.255.0";
+constexpr const char* WIFI_STATIC_DNS = "";              // "" = the gateway
 
 // NTP / Time
 constexpr const char* NTP_SERVER = "pool.ntp.org";
 constexpr long  GMT_OFFSET_SEC = 3600;      // UTC+1
 constexpr int   DAYLIGHT_OFFSET_SEC = 3600; // DST +1h
-constexpr int   NTP_TIMEOUT_MS = 10000;
+constexpr int   NTP_TIMEOUT_MS = 10000;                       // Timer wakes: radio budget of a background sync
+constexpr uint8_t NTP_RETRY_EVERY_N_TIMER_WAKES = 6;           // After a failed sync, timer wakes retry only every Nth time
+constexpr uint32_t NTP_RESYNC_INTERVAL_S = 7 * 24 * 60 * 60;   // Timer wakes sync at least this often (and after power-on)
+constexpr uint32_t NTP_SLEW_MAX_MS = 1000;                     // Larger offsets step the clock instead of slewing it
+constexpr uint32_t NTP_RTC_UPDATE_THRESHOLD_MS = 1500;         // Rewrite the DS3231 only beyond this (it reads whole seconds)
+constexpr uint32_t NTP_RTC_DRIFT_MIN_SPAN_S = 3 * 24 * 60 * 60; // DS3231 drift needs a long span (1 s resolution)
 
 // External RTC
 constexpr bool HAS_EXTERNAL_RTC = true;
 
 // File System
-constexpr const char* LOG_FILE_NAME = "/datalog.csv";
+constexpr const char* LOG_FILE_NAME = "/datalog.bin";             // Active binary datalog (see data_logger.h)
+constexpr const char* LOG_ARCHIVE_FILE_NAME = "/datalog.old.bin"; // Previous datalog after rotation
+constexpr const char* LEGACY_CSV_FILE_NAME = "/datalog.csv";      // Old text format, migrated on boot
+constexpr const char* CSV_DOWNLOAD_NAME = "datalog.csv";          // Filename offered by /download
+constexpr uint32_t DATALOG_MAX_BLOCKS = 320; // Compressed blocks per file before rotation (~80 KB, ~24k samples)
+constexpr const char* LOG_INDEX_FILE_NAME = "/datalog.idx";             // Block index of LOG_FILE_NAME
+constexpr const char* LOG_ARCHIVE_INDEX_FILE_NAME = "/datalog.old.idx"; // Block index of the archive
+
+// Rollups (hour/day/month min/max/mean, see data_rollup.h)
+constexpr uint32_t ROLLUP_HOUR_MAX_ENTRIES = 24 * 92;   // ~3 months of hourly buckets per file (~53 KB)
+constexpr uint32_t ROLLUP_DAY_MAX_ENTRIES = 366 * 3;    // ~3 years of daily buckets per file (~26 KB)
+constexpr uint32_t ROLLUP_MONTH_MAX_ENTRIES = 12 * 20;  // 20 years of monthly buckets per file (~6 KB)
+
+// Sample Batching (RTC memory)
+// Samples are buffered in RTC memory and written to flash in one go, so most
+// timer wakeups never touch the datalog file. NB! Buffered samples are lost on
+// power loss or hard reset; keep DATALOG_FLUSH_EVERY_N small enough to accept that.
+constexpr bool DATALOG_BATCHING_ENABLED = true;
+constexpr uint8_t DATALOG_RTC_RING_SIZE = 16; // Max samples held in RTC memory (10 bytes each)
+constexpr uint8_t DATALOG_FLUSH_EVERY_N = 6;  // Flush after N buffered samples (6 heartbeats x 4 h = daily when steady)
+
+// Change-Driven Logging (deadband + heartbeat)
+// Every wake takes a sample, but it is only written when a channel moved by
+// its deadband since the last written sample, or when the heartbeat is due.
+// Wakes can then be frequent (better resolution during events) while steady
+// conditions still cost one record per heartbeat. false = log every sample.
+constexpr bool DATALOG_DEADBAND_ENABLED = true;
+constexpr float DATALOG_DEADBAND_TEMP_C = 0.3f;                // Log when temperature moved at least this much
+constexpr float DATALOG_DEADBAND_HUM_PCT = 2.0f;               // Log when humidity moved at least this much
+constexpr unsigned long DATALOG_HEARTBEAT_SECONDS = 4 * 60 * 60; // Log at least this often, changed or not
+
+// Wake Cycle Metrics (see metrics.h)
+constexpr const char* METRICS_FILE_NAME = "/metrics.bin"; // Histogram snapshot, restored after a reset
+constexpr uint8_t METRICS_PERSIST_EVERY_N = 6;             // Save after N cycles (RTC memory in between)
+
+// Event Tracing (see trace.h). 0 compiles all trace points out.
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1
+#endif
+
+// DHT Sensor (see dht_sensor.h)
+constexpr unsigned long DHT_MIN_READ_INTERVAL_MS = (DHT_TYPE_DEF == DHT11) ? 1000 : 2000; // Between transactions; sooner returns the last result
+constexpr unsigned long DHT_READ_TIMEOUT_MS = 100;       // DHTSensor_read() gives up waiting for a transaction after this
+
+// Sensor Acquisition (one logged sample, see sensor_acquisition.h)
+// A burst keeps the device awake DHT_MIN_READ_INTERVAL_MS per extra read: 3 reads add ~2 s (DHT11)
+// or ~4 s (DHT22) to a wake that otherwise lasts a few hundred ms. Timer wakes therefore take
+// SENSOR_TIMER_WAKE_READS; the burst is for interactive sampling and after a degraded sample.
+constexpr uint8_t SENSOR_BURST_SIZE = 3;            // Reads per burst sample, DHT_MIN_READ_INTERVAL_MS apart
+constexpr uint8_t SENSOR_TIMER_WAKE_READS = 1;      // Reads per sample on a timer wake (retries still apply)
+constexpr uint8_t SENSOR_MAX_RETRIES = 3;           // Failed reads retried per sample, on top of the burst
+constexpr unsigned long SENSOR_RETRY_MAX_BACKOFF_MS = 8000; // Backoff doubles from DHT_MIN_READ_INTERVAL_MS up to this
+constexpr float SENSOR_OUTLIER_MADS = 3.0f;         // Reject reads further than this many (scaled) MADs from the median
+constexpr float SENSOR_OUTLIER_MIN_TEMP_C = 0.5f;   // Floor for the temperature spread (MAD is 0 for identical reads)
+constexpr float SENSOR_OUTLIER_MIN_HUM_PCT = 2.0f;  // Floor for the humidity spread
 
 // Logic Intervals
-constexpr unsigned long LOG_INTERVAL_SECONDS = 4 * 60 * 60; // Log every X seconds
-constexpr unsigned long WAKEUP_OVERHEAD_MS = 1000; // Overhead to the sleep duration to account for the time it takes to wake up and stabilize before logging
+// Sample every X seconds (logged subject to the deadband). With the deadband,
+// 1 h (60 * 60) follows changes closely at 4x the wakes of the default.
+constexpr unsigned long LOG_INTERVAL_SECONDS = 4 * 60 * 60;
+constexpr unsigned long WAKEUP_OVERHEAD_MS = 1000; // Initial guess for the time from timer wake to the sample (learned afterwards)
+
+// Wall-Clock Aligned Sleep (see sleep_manager.h)
+// With valid time, samples are scheduled on slots of LOG_INTERVAL_SECONDS
+// counted from midnight (e.g. 1 h -> every hh:00), instead of one interval
+// after the previous sample. The RC slow clock that times deep sleep drifts
+// by several hundred ppm, so the sleep is corrected with a drift estimate
+// measured against the DS3231, and the wake is moved earlier by the learned
+// wake overhead.
+constexpr bool SLEEP_ALIGN_TO_WALL_CLOCK = true;
+constexpr long SLEEP_ALIGN_OFFSET_SEC = GMT_OFFSET_SEC;     // Slot grid in local standard time (0 = UTC)
+constexpr uint32_t SLEEP_DRIFT_MIN_SPAN_S = 30 * 60;       // Shorter DS3231 spans are mostly 1 s quantization
+constexpr float SLEEP_DRIFT_MAX_PPM = 50000.0f;            // Beyond this a measurement is discarded (clock stepped)
+constexpr float SLEEP_DRIFT_FILTER_ALPHA = 0.25f;          // Weight of a new drift measurement
+constexpr float WAKEUP_OVERHEAD_FILTER_ALPHA = 0.25f;      // Weight of a new wake overhead measurement
+constexpr unsigned long WAKEUP_OVERHEAD_MAX_MS = 6000;     // Longer: something blocked the wake, not learned (boot + burst is ~4 s)
+constexpr unsigned long SAMPLER_RETRY_MS = 60 * 1000;  // Awake: retry a failed scheduled sample after this
+constexpr int SAMPLER_TASK_CORE = 1;                   // Dual-core chips: APP_CPU (WiFi/lwIP run on core 0)
 
 // Web Server
 constexpr unsigned int WEBSERVER_PORT = 80;
 constexpr unsigned long WEB_SERVER_INACTIVITY_TIMEOUT = 90 * 1000; // Seconds of inactivity before auto-shutdown
 constexpr bool ENABLE_WEB_SERVER_ON_TIMER_WAKEUP = false; 
 constexpr const char* MDNS_HOSTNAME = "esp32logger";
+constexpr size_t HISTORY_DEFAULT_LIMIT = 200;  // Records returned by /api/history without ?limit=
+constexpr size_t HISTORY_MAX_LIMIT = 2000;     // Upper bound for ?limit= and ?size=
+constexpr size_t HISTORY_PAGE_SIZE_DEFAULT = 50; // Records per page for /api/history?page=
+
+// Live Readings over SSE (interactive mode, see live_data.h)
+constexpr unsigned long LIVE_SAMPLE_INTERVAL_MS = 2000; // DHT22 minimum; faster reads get the cached result
+constexpr size_t LIVE_RING_SIZE = 64;           // Samples kept for reconnecting browsers (~2 min)
+constexpr size_t LIVE_REPLAY_MAX = 16;          // Samples sent to a browser when it (re)connects
+constexpr size_t LIVE_MAX_CLIENTS = 4;          // Further /events connections are closed at once
+constexpr size_t LIVE_MAX_QUEUED_PACKETS = 4;   // Skip a sample while clients are this far behind on average
+
+// Interactive Scheduler (see scheduler.h)
+constexpr uint32_t SCHEDULER_TICK_MS = 10;      // Timer resolution
+constexpr uint8_t SCHEDULER_WHEEL_SLOTS = 32;   // One turn = 320 ms; longer timers stay in their slot for more turns
+constexpr uint8_t SCHEDULER_QUEUE_LENGTH = 8;   // Button/web events waiting for the app controller
+constexpr unsigned long DISPLAY_REFRESH_INTERVAL_MS = 500; // OLED redraw (IP assignment, live values)
+constexpr unsigned long NETWORK_INFO_DURATION_MS = 10000;  // Network view before reverting to sensors
+constexpr unsigned long SERIAL_POLL_INTERVAL_MS = 250;     // Serial console command check
+constexpr unsigned long BUTTON_DEBOUNCE_MS = 200;          // Presses closer together are contact bounce
 
 // OLED Display (Address and Size)
 constexpr uint8_t OLED_SCREEN_WIDTH = 128;
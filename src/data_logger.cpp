@@ -3,29 +3,939 @@
 #include "data_logger.h"
 #include "system_logger.h" // New include for logging
 #include "config.h"    // For LOG_FILE_NAME
-#include "time_manager.h" // For getFormattedTime()
+#include "time_manager.h" // For TimeManager_isTimeSet()
+#include "data_rollup.h"  // Fed with every record written to flash
+#include "settings_manager.h" // Power-on session counter for provisional records
+#include "subsystem.h"
 
 #include <cmath>       // For isnan()
-#include <FS.h>        
-#include <LittleFS.h>
-#include "esp_system.h" // Needed for RTC_DATA_ATTR  
+#include <time.h>      // For localtime_r(), mktime()
+#include "hal/hal_fs.h"
+#include "hal/hal_clock.h"
+#include "trace.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
+#include "freertos/semphr.h"
 
 #define LOG_TAG "DATALOG" // Define a tag for DataLogger module logs
 
-// Static global variables to store the last successfully logged values
+// Static global variables to store the last sampled values (written or
+// not, see DATALOG_DEADBAND_ENABLED)
 // These need to be RTC_DATA_ATTR to persist across deep sleep
-RTC_DATA_ATTR static float s_lastLoggedHumidity = NAN;
-RTC_DATA_ATTR static float s_lastLoggedTemperature = NAN;
-RTC_DATA_ATTR static char s_lastLoggedTime[32] = "N/A";
+RTC_DATA_ATTR static float s_lastSampledHumidity = NAN;
+RTC_DATA_ATTR static float s_lastSampledTemperature = NAN;
+RTC_DATA_ATTR static char s_lastSampledTime[32] = "N/A";
+RTC_DATA_ATTR static uint32_t s_lastSampledEpoch = 0;   // 0 = time not set
+RTC_DATA_ATTR static uint32_t s_sampleSequence = 0;    // Bumped with every sample
+RTC_DATA_ATTR static bool s_lastSampledProvisional = false; // Last sample had no trusted time...
+RTC_DATA_ATTR static uint32_t s_lastSampledStampS = 0;      // ...and this RTC timer stamp instead
 
-bool DataLogger_init() {
+// The last written sample, which the deadband compares against
+RTC_DATA_ATTR static float s_lastWrittenHumidity = NAN;
+RTC_DATA_ATTR static float s_lastWrittenTemperature = NAN;
+RTC_DATA_ATTR static uint64_t s_lastWrittenRtcMs = 0;   // RTC clock of the last written sample (heartbeat)
+RTC_DATA_ATTR static uint16_t s_skippedSinceLogged = 0; // Samples inside the deadband since then
+
+// Provisional timestamps (see RECORD_FLAG_PROVISIONAL). All of it is lost
+// with power, exactly like the RTC timer the stamps count.
+RTC_DATA_ATTR static bool s_sessionKnown = false;
+RTC_DATA_ATTR static uint8_t s_session = 0;              // Power-on session, modulo 16
+RTC_DATA_ATTR static uint32_t s_sessionLastStampS = 0;   // Catches an RTC timer reset
+RTC_DATA_ATTR static bool s_hasProvisional = false;      // Anything left to resolve
+RTC_DATA_ATTR static uint16_t s_provisionalOnFlash = 0;  // Of those, already flushed
+
+// Ring of samples waiting to be flushed to flash (see DATALOG_BATCHING_ENABLED)
+RTC_DATA_ATTR static SensorRecord s_pendingRecords[DATALOG_RTC_RING_SIZE];
+RTC_DATA_ATTR static uint8_t s_pendingHead = 0;  // Index of the oldest pending sample
+RTC_DATA_ATTR static uint8_t s_pendingCount = 0;
+
+// Mount state for this boot only (not RTC memory)
+static bool s_isMounted = false;
+
+// Guards the RTC ring and the datalog files: the background sampler writes
+// while web handlers read (see log_sampler.h). Created by DataLogger_init()
+// in setup(), before either of them is started.
+static SemaphoreHandle_t s_mutex = nullptr;
+
+static const char* CSV_HEADER = "Timestamp,Humidity (%),Temperature (C)";
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void lock() {
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+}
+
+static void unlock() {
+  xSemaphoreGive(s_mutex);
+}
+
+static SensorRecord makeRecord(time_t epoch, bool timeValid, float temperature, float humidity, bool degraded = false) {
+  SensorRecord record;
+  record.epoch = (uint32_t)epoch;
+  record.temperature = (int16_t)lroundf(temperature * 100.0f);
+  record.humidity = (uint16_t)lroundf(constrain(humidity, 0.0f, 100.0f) * 100.0f);
+  record.flags = timeValid ? RECORD_FLAG_TIME_VALID : 0;
+  if (degraded) record.flags |= RECORD_FLAG_DEGRADED;
+  DatalogCodec_sealRecord(record);
+  return record;
+}
+
+static void formatTimestamp(const SensorRecord& record, char* buffer, size_t bufferSize) {
+  if (record.flags & RECORD_FLAG_PROVISIONAL) {
+    snprintf(buffer, bufferSize, "Provisional +%lus #%u", (unsigned long)record.epoch,
+             (unsigned)((record.flags & RECORD_SESSION_MASK) >> RECORD_SESSION_SHIFT));
+    return;
+  }
+  if (!(record.flags & RECORD_FLAG_TIME_VALID)) {
+    strncpy(buffer, "Time Not Set", bufferSize);
+    buffer[bufferSize - 1] = 0;
+    return;
+  }
+  time_t epoch = (time_t)record.epoch;
+  struct tm timeinfo;
+  localtime_r(&epoch, &timeinfo);
+  strftime(buffer, bufferSize, "%Y-%m-%d %H:%M:%S", &timeinfo);
+}
+
+/**
+ * @brief Reads the header of a datalog file.
+ * @return false if the file is missing or too short.
+ */
+static bool readFileHeader(const char* path, DatalogFileHeader& header, size_t& fileSize) {
+  if (!HalFs().exists(path)) return false;
+
+  File file = HalFs().open(path, "r");
+  if (!file) return false;
+
+  fileSize = file.size();
+  size_t headerRead = file.read(reinterpret_cast<uint8_t*>(&header), sizeof(header));
+  file.close();
+  return headerRead == sizeof(header);
+}
+
+/**
+ * @brief Returns the number of blocks in a datalog file.
+ * A trailing partial block (e.g. power loss mid-write) is not counted.
+ * @return Block count, or -1 if the file is missing or has an invalid header.
+ */
+static long countBlocksInFile(const char* path) {
+  DatalogFileHeader header;
+  size_t size = 0;
+  if (!readFileHeader(path, header, size)) return -1;
+
+  if (header.magic != DATALOG_MAGIC || header.version != DATALOG_VERSION ||
+      header.blockSize != DATALOG_BLOCK_SIZE) {
+    return -1;
+  }
+  return (long)((size - sizeof(header)) / DATALOG_BLOCK_SIZE);
+}
+
+static bool readBlock(File& file, size_t blockIndex, uint8_t* block) {
+  file.seek(sizeof(DatalogFileHeader) + blockIndex * DATALOG_BLOCK_SIZE);
+  return file.read(block, DATALOG_BLOCK_SIZE) == DATALOG_BLOCK_SIZE;
+}
+
+static bool readIndexEntry(File& index, size_t entryIndex, DatalogIndexEntry& entry) {
+  index.seek(entryIndex * sizeof(DatalogIndexEntry));
+  return index.read(reinterpret_cast<uint8_t*>(&entry), sizeof(entry)) == sizeof(entry);
+}
+
+/**
+ * @brief Records that can actually be decoded from a block (0 if corrupt).
+ */
+static uint8_t countValidRecords(const uint8_t* block) {
+  DatalogBlockDecoder dec;
+  return DatalogCodec_openBlock(dec, block) ? dec.count : 0;
+}
+
+/**
+ * @brief Epoch of the first record with trusted time, read on from the
+ * decoder's position. Other records hold an uptime stamp (no time or
+ * provisional), which would unsort the index.
+ * @return false if the block has none.
+ */
+static bool firstTrustedEpoch(DatalogBlockDecoder& dec, uint32_t& epoch) {
+  SensorRecord record;
+  while (DatalogCodec_nextRecord(dec, record)) {
+    if (record.flags & RECORD_FLAG_TIME_VALID) {
+      epoch = record.epoch;
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool createDatalogFile(const char* path) {
+  File file = HalFs().open(path, "w");
+  if (!file) return false;
+
+  DatalogFileHeader header = {};
+  header.magic = DATALOG_MAGIC;
+  header.version = DATALOG_VERSION;
+  header.blockSize = DATALOG_BLOCK_SIZE;
+  header.capacity = DATALOG_MAX_BLOCKS;
+
+  size_t written = file.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+  file.close();
+  return written == sizeof(header);
+}
+
+/**
+ * @brief Moves the full active file to the archive slot and starts a new one.
+ * The previous archive is discarded, bounding the datalog to two files.
+ */
+static bool rotateDatalogFile() {
+  LOG_INFO(LOG_TAG, "Datalog reached %lu blocks. Rotating to %s.",
+           (unsigned long)DATALOG_MAX_BLOCKS, LOG_ARCHIVE_FILE_NAME);
+
+  if (HalFs().exists(LOG_ARCHIVE_FILE_NAME)) {
+    HalFs().remove(LOG_ARCHIVE_FILE_NAME);
+  }
+  if (!HalFs().rename(LOG_FILE_NAME, LOG_ARCHIVE_FILE_NAME)) {
+    LOG_ERROR(LOG_TAG, "Failed to rotate datalog file!");
+    return false;
+  }
+
+  // The index travels with its data file. A missing index is rebuilt on demand.
+  if (HalFs().exists(LOG_ARCHIVE_INDEX_FILE_NAME)) {
+    HalFs().remove(LOG_ARCHIVE_INDEX_FILE_NAME);
+  }
+  if (HalFs().exists(LOG_INDEX_FILE_NAME)) {
+    HalFs().rename(LOG_INDEX_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME);
+  }
+  return createDatalogFile(LOG_FILE_NAME);
+}
+
+/**
+ * @brief Brings the block index of a datalog file up to date.
+ * Entry k holds the first trusted timestamp of block k and the number of
+ * records in blocks 0..k-1, so a full file needs only a few KB of index. Missing entries
+ * are appended by reading just the new blocks. A torn or stale index (e.g.
+ * the data file was recreated) is rebuilt from scratch.
+ */
+static bool updateIndex(const char* dataPath, const char* indexPath, size_t blockCount) {
+  size_t onDisk = 0;
+  bool rebuild = false;
+
+  if (HalFs().exists(indexPath)) {
+    File index = HalFs().open(indexPath, "r");
+    if (index) {
+      size_t size = index.size();
+      index.close();
+      onDisk = size / sizeof(DatalogIndexEntry);
+      rebuild = (size % sizeof(DatalogIndexEntry) != 0) || (onDisk > blockCount);
+    }
+  }
+
+  if (rebuild) onDisk = 0;
+  if (onDisk == blockCount && !rebuild) return true;
+
+  File data = HalFs().open(dataPath, "r");
+  if (!data) return false;
+
+  // 1. Continue the running record count from the last entry on disk
+  uint8_t block[DATALOG_BLOCK_SIZE];
+  DatalogIndexEntry last = { 0, 0 };
+  uint32_t nextRecord = 0;
+  if (onDisk > 0) {
+    File index = HalFs().open(indexPath, "r");
+    bool ok = index && readIndexEntry(index, onDisk - 1, last) && readBlock(data, onDisk - 1, block);
+    if (index) index.close();
+    if (ok) {
+      nextRecord = last.recordIndex + countValidRecords(block);
+    } else {
+      rebuild = true;
+      onDisk = 0;
+      last.epoch = 0;
+    }
+  }
+
+  File index = HalFs().open(indexPath, rebuild ? "w" : "a");
+  if (!index) {
+    data.close();
+    return false;
+  }
+
+  // 2. One entry per new block
+  bool ok = true;
+  for (size_t k = onDisk; k < blockCount && ok; k++) {
+    ok = readBlock(data, k, block);
+
+    // A corrupt block, or one without trusted time, repeats the previous
+    // timestamp, which keeps the index sorted for the binary searches below
+    DatalogIndexEntry entry = { last.epoch, nextRecord };
+    DatalogBlockDecoder dec;
+    if (ok && DatalogCodec_openBlock(dec, block)) {
+      nextRecord += dec.count;
+      uint32_t epoch;
+      if (firstTrustedEpoch(dec, epoch)) entry.epoch = epoch;
+    }
+
+    ok = ok && index.write(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry)) == sizeof(entry);
+    last = entry;
+  }
+
+  index.close();
+  data.close();
+
+  if (!ok) LOG_WARN(LOG_TAG, "Failed to update index %s.", indexPath);
+  return ok;
+}
+
+/**
+ * @brief Returns the number of records in a datalog file.
+ * This is the running count of the last index entry plus the tail block.
+ */
+static size_t countRecordsInFile(const char* dataPath, const char* indexPath) {
+  long blocks = countBlocksInFile(dataPath);
+  if (blocks <= 0) return 0;
+
+  updateIndex(dataPath, indexPath, (size_t)blocks);
+
+  DatalogIndexEntry last;
+  uint8_t block[DATALOG_BLOCK_SIZE];
+  File index = HalFs().open(indexPath, "r");
+  File data = HalFs().open(dataPath, "r");
+  bool ok = index && data && readIndexEntry(index, (size_t)blocks - 1, last) &&
+            readBlock(data, (size_t)blocks - 1, block);
+  if (index) index.close();
+  if (data) data.close();
+
+  return ok ? last.recordIndex + countValidRecords(block) : 0;
+}
+
+/**
+ * @brief Seals the encoder's block and writes it to its slot in the active file.
+ * "r+" instead of "a": the tail block is rewritten in place until it is full.
+ */
+static bool writeBlock(size_t blockIndex, DatalogBlockEncoder& enc) {
+  DatalogCodec_finishBlock(enc);
+
+  File file = HalFs().open(LOG_FILE_NAME, "r+");
+  if (!file) {
+    LOG_ERROR(LOG_TAG, "Error opening %s on LittleFS!", LOG_FILE_NAME);
+    return false;
+  }
+  file.seek(sizeof(DatalogFileHeader) + blockIndex * DATALOG_BLOCK_SIZE);
+  size_t written = file.write(enc.block, DATALOG_BLOCK_SIZE);
+  file.close();
+
+  if (written != DATALOG_BLOCK_SIZE) {
+    LOG_ERROR(LOG_TAG, "Short write to %s (%u of %u bytes).", LOG_FILE_NAME,
+              (unsigned)written, (unsigned)DATALOG_BLOCK_SIZE);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Rollups follow what is on flash, so they stay consistent with the datalog.
+ */
+static void feedRollups(const SensorRecord* records, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    DataRollup_addRecord(records[i]);
+  }
+  DataRollup_saveOpenBuckets();
+}
+
+/**
+ * @brief Encodes records into the tail block of the active datalog file.
+ * The tail block is decoded to resume the encoder, filled, and written back.
+ * Full blocks are sealed and a new one is started; the file is rotated after
+ * DATALOG_MAX_BLOCKS blocks.
+ * @param updateRollups false when re-encoding records the rollups already hold.
+ * @param written Set to the number of leading records that reached flash,
+ * also when a later block fails.
+ */
+static bool appendRecords(const SensorRecord* records, size_t count, bool updateRollups = true,
+                          size_t* written = nullptr) {
+  if (written) *written = 0;
+  if (count == 0) return true;
+
+  long blocks = countBlocksInFile(LOG_FILE_NAME);
+  if (blocks < 0) {
+    // Missing or unrecognized file: start a fresh one (and drop its old index)
+    if (HalFs().exists(LOG_INDEX_FILE_NAME)) {
+      HalFs().remove(LOG_INDEX_FILE_NAME);
+    }
+    if (!createDatalogFile(LOG_FILE_NAME)) {
+      LOG_ERROR(LOG_TAG, "Error creating %s on LittleFS!", LOG_FILE_NAME);
+      return false;
+    }
+    blocks = 0;
+  }
+
+  // 1. Resume the tail block, or start a new one after it
+  uint8_t block[DATALOG_BLOCK_SIZE];
+  DatalogBlockEncoder enc;
+  size_t blockIndex = (size_t)blocks;
+  DatalogCodec_beginBlock(enc, block);
+
+  if (blocks > 0) {
+    File file = HalFs().open(LOG_FILE_NAME, "r");
+    bool loaded = file && readBlock(file, (size_t)blocks - 1, block);
+    if (file) file.close();
+
+    if (loaded && DatalogCodec_resumeBlock(enc, block)) {
+      blockIndex = (size_t)blocks - 1;
+    } else {
+      LOG_WARN(LOG_TAG, "Tail block of %s is corrupt. Starting a new block.", LOG_FILE_NAME);
+      DatalogCodec_beginBlock(enc, block);
+    }
+  }
+
+  if (blockIndex >= DATALOG_MAX_BLOCKS) {
+    if (!rotateDatalogFile()) return false;
+    blockIndex = 0;
+  }
+
+  // 2. Encode; seal full blocks and move on
+  size_t committed = 0; // Records known to be on flash
+  bool ok = true;
+  for (size_t i = 0; i < count && ok; i++) {
+    if (DatalogCodec_appendRecord(enc, records[i])) continue;
+
+    ok = writeBlock(blockIndex, enc);
+    if (!ok) break;
+    committed = i;
+    blockIndex++;
+
+    if (blockIndex >= DATALOG_MAX_BLOCKS) {
+      updateIndex(LOG_FILE_NAME, LOG_INDEX_FILE_NAME, blockIndex);
+      ok = rotateDatalogFile();
+      if (!ok) break;
+      blockIndex = 0;
+    }
+
+    DatalogCodec_beginBlock(enc, block);
+    DatalogCodec_appendRecord(enc, records[i]); // Always fits in an empty block
+  }
+
+  // 3. Write the (partial) tail block
+  if (ok) {
+    ok = writeBlock(blockIndex, enc);
+    if (ok) committed = count;
+  }
+
+  // Index is secondary data: a failed update is repaired on the next append or query
+  if (ok) updateIndex(LOG_FILE_NAME, LOG_INDEX_FILE_NAME, blockIndex + 1);
+
+  if (updateRollups) feedRollups(records, committed);
+  if (written) *written = committed;
+  return ok;
+}
+
+/**
+ * @brief Finds the block holding a record, by binary search on the index.
+ * @param skip Set to the position of the record within that block.
+ */
+static size_t findBlockForRecord(File& index, size_t blockCount, size_t recordIndex, size_t& skip) {
+  // First block whose running count is past recordIndex, minus one
+  size_t lo = 0;
+  size_t hi = blockCount;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    DatalogIndexEntry entry;
+    if (!readIndexEntry(index, mid, entry)) return blockCount;
+    if (entry.recordIndex <= recordIndex) lo = mid + 1;
+    else hi = mid;
+  }
+  if (lo == 0) return blockCount;
+
+  DatalogIndexEntry entry;
+  if (!readIndexEntry(index, lo - 1, entry)) return blockCount;
+  skip = recordIndex - entry.recordIndex;
+  return lo - 1;
+}
+
+static size_t readRecordsFromFile(const char* dataPath, const char* indexPath, size_t firstIndex,
+                                  SensorRecord* out, size_t maxCount) {
+  long blocks = countBlocksInFile(dataPath);
+  if (blocks <= 0) return 0;
+
+  // 1. Locate the first block
+  size_t skip = 0;
+  File index = HalFs().open(indexPath, "r");
+  if (!index) return 0;
+  size_t blockIndex = findBlockForRecord(index, (size_t)blocks, firstIndex, skip);
+  index.close();
+
+  File data = HalFs().open(dataPath, "r");
+  if (!data) return 0;
+
+  // 2. Decode forward, one block at a time
+  uint8_t block[DATALOG_BLOCK_SIZE];
+  size_t read = 0;
+  for (; blockIndex < (size_t)blocks && read < maxCount; blockIndex++) {
+    if (!readBlock(data, blockIndex, block)) break;
+
+    DatalogBlockDecoder dec;
+    if (!DatalogCodec_openBlock(dec, block)) continue; // Corrupt block: counted as empty
+
+    SensorRecord record;
+    while (read < maxCount && DatalogCodec_nextRecord(dec, record)) {
+      if (skip > 0) {
+        skip--;
+        continue;
+      }
+      out[read++] = record;
+    }
+  }
+  data.close();
+  return read;
+}
+
+/**
+ * @brief Finds the first record in one datalog file with epoch >= target.
+ * Binary search over the block index narrows the scan to about one block.
+ * Assumes timestamps increase through the file; records without a valid
+ * time are skipped.
+ * @return Local record index, or recordCount if no record matches.
+ */
+static size_t findInFile(const char* dataPath, const char* indexPath, size_t recordCount, uint32_t target) {
+  long blocks = countBlocksInFile(dataPath);
+  if (recordCount == 0 || blocks <= 0) return recordCount;
+
+  File index = HalFs().open(indexPath, "r");
+  if (!index) return recordCount;
+
+  // 1. Last block starting before the target is a safe starting point
+  size_t lo = 0;
+  size_t hi = (size_t)blocks;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    DatalogIndexEntry entry;
+    if (!readIndexEntry(index, mid, entry)) break;
+    if (entry.epoch < target) lo = mid + 1;
+    else hi = mid;
+  }
+  size_t blockIndex = (lo == 0) ? 0 : lo - 1;
+
+  // A repeated timestamp belongs to the first block of the run: the blocks
+  // after it have no trusted time of their own, so start there
+  DatalogIndexEntry start;
+  bool ok = readIndexEntry(index, blockIndex, start);
+  DatalogIndexEntry previous;
+  while (ok && blockIndex > 0 && readIndexEntry(index, blockIndex - 1, previous) &&
+         previous.epoch == start.epoch) {
+    blockIndex--;
+    start = previous;
+  }
+  index.close();
+  if (!ok) return recordCount;
+
+  File data = HalFs().open(dataPath, "r");
+  if (!data) return recordCount;
+
+  // 2. Short scan from there
+  uint8_t block[DATALOG_BLOCK_SIZE];
+  size_t position = start.recordIndex;
+  for (; blockIndex < (size_t)blocks; blockIndex++) {
+    if (!readBlock(data, blockIndex, block)) break;
+
+    DatalogBlockDecoder dec;
+    if (!DatalogCodec_openBlock(dec, block)) continue;
+
+    SensorRecord record;
+    while (DatalogCodec_nextRecord(dec, record)) {
+      if ((record.flags & RECORD_FLAG_TIME_VALID) && record.epoch >= target) {
+        data.close();
+        return position;
+      }
+      position++;
+    }
+  }
+  data.close();
+  return recordCount;
+}
+
+/**
+ * @brief One-time conversion of uncompressed "DLG1" datalog files.
+ * Both files are moved aside and re-appended oldest first, producing a
+ * normal compressed datalog. The rollups already hold these samples.
+ */
+static void migrateUncompressedDatalog() {
+  const char* dataPaths[] = { LOG_ARCHIVE_FILE_NAME, LOG_FILE_NAME };
+  const char* indexPaths[] = { LOG_ARCHIVE_INDEX_FILE_NAME, LOG_INDEX_FILE_NAME };
+  const char* tempPaths[] = { "/datalog.v1.old.tmp", "/datalog.v1.tmp" };
+
+  // 1. Move old-format files aside; their indexes do not apply to blocks
+  for (int i = 0; i < 2; i++) {
+    DatalogFileHeader header;
+    size_t size = 0;
+    if (!readFileHeader(dataPaths[i], header, size) || header.magic != DATALOG_MAGIC_V1) continue;
+
+    LOG_INFO(LOG_TAG, "Migrating uncompressed %s to block format...", dataPaths[i]);
+    if (HalFs().exists(tempPaths[i])) {
+      HalFs().remove(tempPaths[i]);
+    }
+    HalFs().rename(dataPaths[i], tempPaths[i]);
+    if (HalFs().exists(indexPaths[i])) {
+      HalFs().remove(indexPaths[i]);
+    }
+  }
+
+  // 2. Re-append, oldest file first
+  for (int i = 0; i < 2; i++) {
+    if (!HalFs().exists(tempPaths[i])) continue;
+
+    File file = HalFs().open(tempPaths[i], "r");
+    if (!file) continue;
+    file.seek(sizeof(DatalogFileHeader));
+
+    SensorRecord batch[16];
+    size_t migrated = 0;
+    bool ok = true;
+    while (ok) {
+      size_t count = file.read(reinterpret_cast<uint8_t*>(batch), sizeof(batch)) / sizeof(SensorRecord);
+      if (count == 0) break;
+
+      // Drop torn records instead of carrying them into a sealed block
+      size_t valid = 0;
+      for (size_t j = 0; j < count; j++) {
+        if (DatalogCodec_isRecordValid(batch[j])) batch[valid++] = batch[j];
+      }
+      ok = appendRecords(batch, valid, false);
+      migrated += valid;
+    }
+    file.close();
+
+    if (ok) {
+      HalFs().remove(tempPaths[i]);
+      LOG_INFO(LOG_TAG, "Migrated %u uncompressed records.", (unsigned)migrated);
+    } else {
+      LOG_ERROR(LOG_TAG, "Datalog migration failed. Keeping %s.", tempPaths[i]);
+    }
+  }
+}
+
+/**
+ * @brief One-time conversion of the old CSV datalog to binary records.
+ * Expected line format: "YYYY-MM-DD HH:MM:SS,Humidity,Temperature".
+ */
+static void migrateLegacyCsv() {
+  if (!HalFs().exists(LEGACY_CSV_FILE_NAME)) return;
+
+  LOG_INFO(LOG_TAG, "Migrating legacy %s to binary format...", LEGACY_CSV_FILE_NAME);
+
+  File csv = HalFs().open(LEGACY_CSV_FILE_NAME, "r");
+  if (!csv) return;
+
+  SensorRecord batch[16];
+  size_t batchCount = 0;
+  size_t migrated = 0;
+  bool ok = true;
+  char line[64];
+
+  while (ok && csv.available()) {
+    // Read one line into a fixed buffer (no String allocation)
+    size_t len = 0;
+    while (csv.available()) {
+      int c = csv.read();
+      if (c == '\n') break;
+      if (c != '\r' && len < sizeof(line) - 1) line[len++] = (char)c;
+    }
+    line[len] = 0;
+
+    struct tm t = {};
+    float humidity, temperature;
+    bool timeValid = true;
+    if (sscanf(line, "%d-%d-%d %d:%d:%d,%f,%f", &t.tm_year, &t.tm_mon, &t.tm_mday,
+               &t.tm_hour, &t.tm_min, &t.tm_sec, &humidity, &temperature) != 8) {
+      if (sscanf(line, "Time Not Set,%f,%f", &humidity, &temperature) != 2) {
+        continue; // Header, blank line or sensor error row
+      }
+      timeValid = false;
+    }
+
+    time_t epoch = 0;
+    if (timeValid) {
+      t.tm_year -= 1900;
+      t.tm_mon -= 1;
+      t.tm_isdst = -1;
+      epoch = mktime(&t);
+    }
+
+    batch[batchCount++] = makeRecord(epoch, timeValid, temperature, humidity);
+    if (batchCount == sizeof(batch) / sizeof(batch[0])) {
+      ok = appendRecords(batch, batchCount);
+      migrated += batchCount;
+      batchCount = 0;
+    }
+  }
+  csv.close();
+
+  if (ok && batchCount > 0) {
+    ok = appendRecords(batch, batchCount);
+    migrated += batchCount;
+  }
+
+  if (ok) {
+    HalFs().remove(LEGACY_CSV_FILE_NAME);
+    LOG_INFO(LOG_TAG, "Migrated %u legacy rows.", (unsigned)migrated);
+  } else {
+    LOG_ERROR(LOG_TAG, "Legacy migration failed. Keeping %s.", LEGACY_CSV_FILE_NAME);
+  }
+}
+
+/**
+ * @brief Deadband check against the last logged sample. Always true for the
+ * first sample after a reset, and once the heartbeat is due. The heartbeat
+ * allows half a wake interval of slack, so a wake landing just short of it
+ * does not postpone the record by a whole interval.
+ */
+static bool isSignificant(float temperature, float humidity, uint64_t nowMs) {
+  if (!DATALOG_DEADBAND_ENABLED) return true;
+  if (isnan(s_lastWrittenTemperature) || isnan(s_lastWrittenHumidity)) return true;
+
+  if (fabsf(temperature - s_lastWrittenTemperature) >= DATALOG_DEADBAND_TEMP_C) return true;
+  if (fabsf(humidity - s_lastWrittenHumidity) >= DATALOG_DEADBAND_HUM_PCT) return true;
+
+  uint64_t heartbeatMs = DATALOG_HEARTBEAT_SECONDS * 1000ULL;
+  uint64_t slackMs = LOG_INTERVAL_SECONDS * 1000ULL / 2;
+  return nowMs < s_lastWrittenRtcMs || nowMs - s_lastWrittenRtcMs + slackMs >= heartbeatMs;
+}
+
+static bool isCurrentSessionProvisional(const SensorRecord& record) {
+  return s_sessionKnown && (record.flags & RECORD_FLAG_PROVISIONAL) &&
+         ((record.flags & RECORD_SESSION_MASK) >> RECORD_SESSION_SHIFT) == s_session;
+}
+
+static size_t countProvisional(const SensorRecord* records, size_t count) {
+  size_t provisional = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (isCurrentSessionProvisional(records[i])) provisional++;
+  }
+  return provisional;
+}
+
+/**
+ * @brief Stamps a sample taken without trusted time with the RTC timer
+ * (seconds since power-on) and the power-on session. A new session starts
+ * with the first such sample after power loss, or when the timer went
+ * backwards (it was reset while RTC memory survived).
+ */
+static void stampProvisional(SensorRecord& record, uint64_t rtcUs) {
+  uint32_t stampS = (uint32_t)(rtcUs / 1000000ULL);
+
+  if (!s_sessionKnown || stampS < s_sessionLastStampS) {
+    uint32_t session = Subsystem_require(SUBSYSTEM_SETTINGS) ? Settings.nextPowerOnSession() : 0;
+    s_session = (uint8_t)(session & (RECORD_SESSION_MASK >> RECORD_SESSION_SHIFT));
+    s_sessionKnown = true;
+    s_provisionalOnFlash = 0; // Stamps of the old session no longer mean anything
+    LOG_INFO(LOG_TAG, "No trusted time. Stamping samples provisionally (session #%u).", (unsigned)s_session);
+  }
+  s_sessionLastStampS = stampS;
+
+  record.epoch = stampS;
+  record.flags = (record.flags & ~(RECORD_FLAG_TIME_VALID | RECORD_SESSION_MASK)) | RECORD_FLAG_PROVISIONAL |
+                 (uint8_t)(s_session << RECORD_SESSION_SHIFT);
+  DatalogCodec_sealRecord(record);
+}
+
+/**
+ * @brief Turns a provisional record of this session into a real timestamp:
+ * its age on the RTC timer, corrected by the measured slow clock drift (see
+ * TimeManager_getSlowClockDriftPpm()), counted back from now.
+ * @return false if the record is not a provisional record of this session.
+ */
+static bool resolveRecord(SensorRecord& record, int64_t nowEpochUs, uint64_t rtcUs) {
+  if (!isCurrentSessionProvisional(record)) return false;
+
+  uint64_t stampUs = (uint64_t)record.epoch * 1000000ULL;
+  if (stampUs > rtcUs) return false;
+
+  double ageUs = (double)(rtcUs - stampUs) * (1.0 + TimeManager_getSlowClockDriftPpm() / 1e6);
+  record.epoch = (uint32_t)llround(((double)nowEpochUs - ageUs) / 1e6);
+  record.flags = (record.flags & ~(RECORD_FLAG_PROVISIONAL | RECORD_SESSION_MASK)) | RECORD_FLAG_TIME_VALID;
+  DatalogCodec_sealRecord(record);
+  return true;
+}
+
+/**
+ * @brief Rewrites the flushed provisional records of this session in the
+ * active file. They are the newest records (nothing trusted is logged after
+ * them before this pass), so only the tail blocks are touched: each one is
+ * decoded, fixed, re-encoded in place, and its index entry updated. Records
+ * already rotated to the archive stay provisional.
+ * @param fixed Incremented by the number of records rewritten.
+ */
+static bool resolveFlashedRecords(int64_t nowEpochUs, uint64_t rtcUs, size_t& fixed) {
+  // Smallest encoding is 3 bytes per record after the first
+  static SensorRecord blockRecords[DATALOG_BLOCK_PAYLOAD / 3 + 1];
+  static bool resolved[DATALOG_BLOCK_PAYLOAD / 3 + 1]; // Given a time by this pass
+  uint8_t block[DATALOG_BLOCK_SIZE];
+
+  long blocks = countBlocksInFile(LOG_FILE_NAME);
+  if (blocks <= 0) return true;
+
+  // 1. Walk back to the first block holding them
+  size_t first = (size_t)blocks;
+  size_t found = 0;
+  File data = HalFs().open(LOG_FILE_NAME, "r");
+  if (!data) return false;
+  while (first > 0 && found < s_provisionalOnFlash) {
+    DatalogBlockDecoder dec;
+    if (!readBlock(data, first - 1, block) || !DatalogCodec_openBlock(dec, block)) break;
+
+    size_t inBlock = 0;
+    SensorRecord record;
+    while (DatalogCodec_nextRecord(dec, record)) {
+      if (isCurrentSessionProvisional(record)) inBlock++;
+    }
+    if (inBlock == 0) break;
+    found += inBlock;
+    first--;
+  }
+  data.close();
+
+  if (found < s_provisionalOnFlash) {
+    LOG_WARN(LOG_TAG, "%u provisional records not in %s (archived?). They stay provisional.",
+             (unsigned)(s_provisionalOnFlash - found), LOG_FILE_NAME);
+  }
+
+  // 2. Fix and rewrite forward, feeding the rollups in order
+  bool ok = true;
+  for (size_t k = first; k < (size_t)blocks && ok; k++) {
+    data = HalFs().open(LOG_FILE_NAME, "r");
+    bool loaded = data && readBlock(data, k, block);
+    if (data) data.close();
+    DatalogBlockDecoder dec;
+    if (!loaded || !DatalogCodec_openBlock(dec, block)) continue;
+
+    size_t count = 0;
+    size_t changed = 0;
+    while (count < sizeof(blockRecords) / sizeof(blockRecords[0]) &&
+           DatalogCodec_nextRecord(dec, blockRecords[count])) {
+      resolved[count] = resolveRecord(blockRecords[count], nowEpochUs, rtcUs);
+      if (resolved[count]) changed++;
+      count++;
+    }
+    if (changed == 0) continue;
+
+    DatalogBlockEncoder enc;
+    DatalogCodec_beginBlock(enc, block);
+    bool fits = true;
+    for (size_t i = 0; i < count && fits; i++) {
+      fits = DatalogCodec_appendRecord(enc, blockRecords[i]);
+    }
+    if (!fits) {
+      LOG_WARN(LOG_TAG, "Block %u does not fit with real timestamps. Left provisional.", (unsigned)k);
+      continue;
+    }
+
+    ok = writeBlock(k, enc);
+    if (!ok) break;
+    fixed += changed;
+
+    // Index is secondary data: left stale, it is still usable for reads.
+    // It takes the first trusted timestamp (see updateIndex()); a block whose
+    // first records stay provisional (older session) must not put theirs in.
+    size_t firstTrusted = 0;
+    while (firstTrusted < count && !(blockRecords[firstTrusted].flags & RECORD_FLAG_TIME_VALID)) firstTrusted++;
+    File index = HalFs().open(LOG_INDEX_FILE_NAME, "r+");
+    DatalogIndexEntry entry;
+    if (index && firstTrusted < count && readIndexEntry(index, k, entry)) {
+      entry.epoch = blockRecords[firstTrusted].epoch;
+      index.seek(k * sizeof(DatalogIndexEntry));
+      index.write(reinterpret_cast<const uint8_t*>(&entry), sizeof(entry));
+    }
+    if (index) index.close();
+
+    // Only the records dated by this pass: the others are in the rollups already
+    for (size_t i = 0; i < count; i++) {
+      if (resolved[i]) DataRollup_addRecord(blockRecords[i]);
+    }
+  }
+  DataRollup_saveOpenBuckets();
+  return ok;
+}
+
+/**
+ * @brief Gives every provisional record of this session its real timestamp
+ * in one pass: the flushed ones on flash, the RTC ring, and the last logged
+ * sample. Caller holds the lock and has checked that the time is set.
+ */
+static bool resolveProvisionalLocked() {
+  TRACE_SCOPE("datalog.resolve");
+  int64_t nowEpochUs = HalClock_getEpochMicros();
+  uint64_t rtcUs = HalClock_getRtcMicros();
+  size_t fixed = 0;
+
+  // 1. Flash (only mounted if something was flushed)
+  if (s_provisionalOnFlash > 0) {
+    bool ok = DataLogger_mountStorage() && resolveFlashedRecords(nowEpochUs, rtcUs, fixed);
+    if (!ok) {
+      s_provisionalOnFlash = (fixed < s_provisionalOnFlash) ? (uint16_t)(s_provisionalOnFlash - fixed) : 0;
+      LOG_ERROR(LOG_TAG, "Failed to rewrite provisional records. Retrying later.");
+      return false;
+    }
+    s_provisionalOnFlash = 0;
+  }
+
+  // 2. RTC ring
+  for (uint8_t i = 0; i < s_pendingCount; i++) {
+    SensorRecord& record = s_pendingRecords[(s_pendingHead + i) % DATALOG_RTC_RING_SIZE];
+    if (resolveRecord(record, nowEpochUs, rtcUs)) fixed++;
+  }
+
+  // 3. Last sample
+  if (s_lastSampledProvisional) {
+    SensorRecord record = {};
+    record.epoch = s_lastSampledStampS;
+    record.flags = RECORD_FLAG_PROVISIONAL | (uint8_t)(s_session << RECORD_SESSION_SHIFT);
+    if (resolveRecord(record, nowEpochUs, rtcUs)) {
+      formatTimestamp(record, s_lastSampledTime, sizeof(s_lastSampledTime));
+      s_lastSampledEpoch = record.epoch;
+    }
+    s_lastSampledProvisional = false;
+  }
+
+  s_hasProvisional = false;
+  s_sampleSequence++; // Cached views of the last sample are stale
+  LOG_INFO(LOG_TAG, "Resolved %u provisional timestamps.", (unsigned)fixed);
+  return true;
+}
+
+/**
+ * @brief Adds a sample to the RTC ring. When full, the oldest sample is dropped.
+ */
+static void pushPendingRecord(const SensorRecord& record) {
+  if (s_pendingCount == DATALOG_RTC_RING_SIZE) {
+    LOG_WARN(LOG_TAG, "Sample buffer full. Dropping oldest unflushed sample.");
+    s_pendingHead = (s_pendingHead + 1) % DATALOG_RTC_RING_SIZE;
+    s_pendingCount--;
+  }
+  uint8_t tail = (s_pendingHead + s_pendingCount) % DATALOG_RTC_RING_SIZE;
+  s_pendingRecords[tail] = record;
+  s_pendingCount++;
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void DataLogger_init() {
+  if (!s_mutex) s_mutex = xSemaphoreCreateMutex();
+  if (!s_mutex) LOG_ERROR(LOG_TAG, "Failed to create the datalog mutex!");
+}
+
+void DataLogger_lockStorage() {
+  lock();
+}
+
+void DataLogger_unlockStorage() {
+  unlock();
+}
+
+bool DataLogger_mountStorage() {
+  if (s_isMounted) return true;
+
+  TRACE_SCOPE("fs.mount");
   LOG_DEBUG(LOG_TAG, "Initializing LittleFS...");
 
-  if (!LittleFS.begin()) {
+  if (!HalFs_mount()) {
     LOG_WARN(LOG_TAG, "LittleFS mount failed. Attempting to format...");
-    if (LittleFS.format()) {
+    if (HalFs_format()) {
       LOG_INFO(LOG_TAG, "LittleFS formatted successfully!");
-      if (!LittleFS.begin()) {
+      if (!HalFs_mount()) {
         LOG_ERROR(LOG_TAG, "LittleFS re-mount failed after format!");
         return false; // Return false if re-mount fails
       } else {
@@ -38,57 +948,255 @@ bool DataLogger_init() {
   } else {
     LOG_DEBUG(LOG_TAG, "LittleFS mounted successfully.");
   }
-  return true; // Return true on successful initialization
+
+  s_isMounted = true;
+  migrateUncompressedDatalog();
+  migrateLegacyCsv();
+  return true;
+}
+
+/**
+ * @brief Appends the first n samples of the RTC ring (one contiguous run).
+ * Samples leave the ring as soon as their block is on flash, so a failure
+ * part way through never writes them twice on the next flush.
+ */
+static bool flushRun(uint8_t n) {
+  size_t written = 0;
+  bool ok = appendRecords(&s_pendingRecords[s_pendingHead], n, true, &written);
+  s_provisionalOnFlash += countProvisional(&s_pendingRecords[s_pendingHead], written);
+  s_pendingHead = (s_pendingHead + written) % DATALOG_RTC_RING_SIZE;
+  s_pendingCount -= (uint8_t)written;
+  return ok;
+}
+
+/**
+ * @brief Writes the RTC ring to flash. Caller holds the lock.
+ */
+static bool flushPending() {
+  if (s_pendingCount == 0) return true;
+
+  if (!DataLogger_mountStorage()) return false;
+
+  // The ring may wrap, so write it as (up to) two contiguous runs
+  uint8_t count = s_pendingCount;
+  uint8_t firstRun = DATALOG_RTC_RING_SIZE - s_pendingHead;
+  if (firstRun > count) firstRun = count;
+
+  bool ok = flushRun(firstRun) && (s_pendingCount == 0 || flushRun(s_pendingCount));
+  if (!ok) {
+    LOG_ERROR(LOG_TAG, "Flush failed. Keeping %u samples in RTC memory.", s_pendingCount);
+    return false;
+  }
+
+  LOG_INFO(LOG_TAG, "Flushed %u buffered samples to %s.", count, LOG_FILE_NAME);
+  return true;
 }
 
-bool DataLogger_logSensorData(float temperature, float humidity) {
+bool DataLogger_flush() {
+  lock();
+  bool ok = flushPending();
+  unlock();
+  return ok;
+}
 
-  String dataString = "";
-  String timestamp = getFormattedTime(); 
+uint8_t DataLogger_getPendingCount() {
+  return s_pendingCount;
+}
+
+DatalogWriteResult DataLogger_logSensorData(float temperature, float humidity, bool degraded) {
 
   if (isnan(temperature) || isnan(humidity)) {
-    dataString = timestamp + ",Sensor Error,Sensor Error";
     LOG_ERROR(LOG_TAG, "Failed to read from DHT sensor for logging.");
-    // Return false on sensor read error
-    return false;
-  } else {
-    dataString = timestamp + "," + String(humidity, 1) + "," + String(temperature, 1);
-    LOG_INFO(LOG_TAG, "Logged: %s", dataString.c_str());
+    return DATALOG_WRITE_FAILED;
+  }
+
+  bool timeValid = TimeManager_isTimeSet();
+  SensorRecord record = makeRecord(HalClock_getEpoch(), timeValid, temperature, humidity, degraded);
+  uint64_t rtcUs = HalClock_getRtcMicros();
+  uint64_t nowMs = rtcUs / 1000ULL;
 
-    // Update the static global variables with the successfully logged data
-    s_lastLoggedTemperature = temperature;
-    s_lastLoggedHumidity = humidity;    
+  lock();
 
-    strncpy(s_lastLoggedTime, timestamp.c_str(), sizeof(s_lastLoggedTime)); // Store timestamp
-    s_lastLoggedTime[sizeof(s_lastLoggedTime) - 1] = 0; // Null-terminate for safety
+  if (!timeValid) {
+    stampProvisional(record, rtcUs);
+  } else if (s_hasProvisional) {
+    resolveProvisionalLocked(); // Before a trusted record is logged after them
   }
 
-  File dataFile = LittleFS.open(LOG_FILE_NAME, "a"); // Use LOG_FILE_NAME from config.h
-  if (dataFile) {
-    if (dataFile.size() == 0) {
-      // Write header if file is new or empty
-      dataFile.println("Timestamp,Humidity (%),Temperature (C)");
-    }
-    dataFile.println(dataString);
-    dataFile.close();
+  char timestamp[sizeof(s_lastSampledTime)];
+  formatTimestamp(record, timestamp, sizeof(timestamp));
 
-    LOG_INFO(LOG_TAG, "Saved entry: %s", dataString.c_str());
-    return true; // Return true on successful logging
+  // The getters show the latest sample, written or not
+  s_lastSampledTemperature = temperature;
+  s_lastSampledHumidity = humidity;
 
-  } else {
-    LOG_ERROR(LOG_TAG, "Error opening %s on LittleFS!", LOG_FILE_NAME);
-    return false; // Return false on file open error
+  strncpy(s_lastSampledTime, timestamp, sizeof(s_lastSampledTime)); // Store timestamp
+  s_lastSampledTime[sizeof(s_lastSampledTime) - 1] = 0; // Null-terminate for safety
+  s_lastSampledEpoch = timeValid ? record.epoch : 0;
+  s_lastSampledProvisional = !timeValid;
+  s_lastSampledStampS = timeValid ? 0 : record.epoch;
+  if (!timeValid) s_hasProvisional = true;
+  s_sampleSequence++;
+
+  if (!isSignificant(temperature, humidity, nowMs)) {
+    uint16_t skipped = ++s_skippedSinceLogged;
+    unlock();
+    LOG_INFO(LOG_TAG, "Within deadband (H: %.1f, T: %.1f). Not logged (%u skipped).", humidity, temperature,
+             (unsigned)skipped);
+    return DATALOG_WRITE_SKIPPED;
+  }
+
+  s_lastWrittenTemperature = temperature;
+  s_lastWrittenHumidity = humidity;
+  s_lastWrittenRtcMs = nowMs;
+  s_skippedSinceLogged = 0;
+
+  if (DATALOG_BATCHING_ENABLED) {
+    pushPendingRecord(record);
+    LOG_INFO(LOG_TAG, "Buffered entry: %s, H: %.1f, T: %.1f (%u/%u pending)", timestamp,
+             humidity, temperature, s_pendingCount, DATALOG_FLUSH_EVERY_N);
+
+    if (s_pendingCount >= DATALOG_FLUSH_EVERY_N) {
+      // A failed flush is not a lost sample: it stays in RTC memory for the next attempt
+      flushPending();
+    }
+    unlock();
+    return DATALOG_WRITE_LOGGED;
+  }
+
+  bool written = DataLogger_mountStorage() && appendRecords(&record, 1);
+  if (written && !timeValid) s_provisionalOnFlash++;
+  unlock();
+  if (!written) {
+    return DATALOG_WRITE_FAILED; // File error
   }
+
+  LOG_INFO(LOG_TAG, "Saved entry: %s, H: %.1f, T: %.1f", timestamp, humidity, temperature);
+  return DATALOG_WRITE_LOGGED;
 }
 
 float DataLogger_getLastHumidity() {
-    return s_lastLoggedHumidity;
+    return s_lastSampledHumidity;
 }
 
 float DataLogger_getLastTemperature() {
-    return s_lastLoggedTemperature;
+    return s_lastSampledTemperature;
+}
+
+const char* DataLogger_getLastLogTime() {
+    return s_lastSampledTime;
+}
+
+uint32_t DataLogger_getLastLogEpoch() {
+    return s_lastSampledEpoch;
 }
 
-String DataLogger_getLastLogTime() {
-    return String(s_lastLoggedTime);
+uint32_t DataLogger_getSampleSequence() {
+    return s_sampleSequence;
+}
+
+uint16_t DataLogger_getSkippedCount() {
+    return s_skippedSinceLogged;
+}
+
+bool DataLogger_resolveProvisional() {
+    if (!s_hasProvisional) return true;
+    if (!TimeManager_isTimeSet()) return false;
+
+    lock();
+    bool ok = resolveProvisionalLocked();
+    unlock();
+    return ok;
+}
+
+size_t DataLogger_getRecordCount() {
+    lock();
+    size_t count = 0;
+    if (DataLogger_mountStorage()) {
+        count = countRecordsInFile(LOG_ARCHIVE_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME) +
+                countRecordsInFile(LOG_FILE_NAME, LOG_INDEX_FILE_NAME);
+    }
+    unlock();
+    return count;
+}
+
+/**
+ * @brief DataLogger_readRecords() without the lock.
+ */
+static size_t readRecordsLocked(size_t firstIndex, SensorRecord* out, size_t maxCount) {
+    if (!DataLogger_mountStorage()) return 0;
+
+    size_t archived = countRecordsInFile(LOG_ARCHIVE_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME);
+    size_t read = 0;
+
+    // 1. Oldest records live in the archive file
+    if (firstIndex < archived) {
+        size_t wanted = archived - firstIndex;
+        if (wanted > maxCount) wanted = maxCount;
+        read = readRecordsFromFile(LOG_ARCHIVE_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME, firstIndex, out, wanted);
+        if (read < wanted) return read;
+    }
+
+    // 2. Continue in the active file
+    if (read < maxCount) {
+        size_t activeCount = countRecordsInFile(LOG_FILE_NAME, LOG_INDEX_FILE_NAME);
+        size_t activeIndex = firstIndex + read - archived;
+        if (activeIndex < activeCount) {
+            size_t wanted = activeCount - activeIndex;
+            if (wanted > maxCount - read) wanted = maxCount - read;
+            read += readRecordsFromFile(LOG_FILE_NAME, LOG_INDEX_FILE_NAME, activeIndex, out + read, wanted);
+        }
+    }
+    return read;
+}
+
+size_t DataLogger_readRecords(size_t firstIndex, SensorRecord* out, size_t maxCount) {
+    lock();
+    size_t read = readRecordsLocked(firstIndex, out, maxCount);
+    unlock();
+    return read;
+}
+
+/**
+ * @brief DataLogger_findFirstRecordAtOrAfter() without the lock.
+ */
+static size_t findFirstLocked(uint32_t epoch) {
+    if (!DataLogger_mountStorage()) return 0;
+
+    size_t archived = countRecordsInFile(LOG_ARCHIVE_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME);
+
+    // 1. Archive first (older records)
+    if (archived > 0) {
+        size_t found = findInFile(LOG_ARCHIVE_FILE_NAME, LOG_ARCHIVE_INDEX_FILE_NAME, archived, epoch);
+        if (found < archived) return found;
+    }
+
+    // 2. Then the active file
+    size_t active = countRecordsInFile(LOG_FILE_NAME, LOG_INDEX_FILE_NAME);
+    return archived + findInFile(LOG_FILE_NAME, LOG_INDEX_FILE_NAME, active, epoch);
+}
+
+size_t DataLogger_findFirstRecordAtOrAfter(uint32_t epoch) {
+    lock();
+    size_t found = findFirstLocked(epoch);
+    unlock();
+    return found;
+}
+
+bool DataLogger_isRecordValid(const SensorRecord& record) {
+    return DatalogCodec_isRecordValid(record);
+}
+
+const char* DataLogger_getCsvHeader() {
+    return CSV_HEADER;
+}
+
+size_t DataLogger_formatCsvRow(const SensorRecord& record, char* buffer, size_t bufferSize) {
+    char timestamp[32];
+    formatTimestamp(record, timestamp, sizeof(timestamp));
+
+    int len = snprintf(buffer, bufferSize, "%s,%.1f,%.1f\n", timestamp,
+                       record.humidity / 100.0f, record.temperature / 100.0f);
+    if (len < 0 || (size_t)len >= bufferSize) return 0;
+    return (size_t)len;
 }
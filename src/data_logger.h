@@ -4,39 +4,188 @@
 
 #include <Arduino.h>   // For String type
 
-// --- External Dependencies ---
-extern String getFormattedTime(); // Assuming getFormattedTime() is globally accessible (e.g., from time_manager.h)
+#include "datalog_codec.h" // SensorRecord and the compressed block format
+
+// --- Storage Format ---
+// Samples are kept as SensorRecord in RAM/RTC memory and compressed into
+// fixed-size blocks on flash (see datalog_codec.h), ~3 bytes per sample.
+// Building and encoding a record happens on the stack, so logging a sample
+// does no heap allocation. The CSV view is generated on demand (see
+// DataLogger_formatCsvRow()).
+//
+// File layout: [DatalogFileHeader][block 0][block 1]...
+// Only the last block is ever rewritten; earlier blocks are sealed.
+
+// File header, written once when a datalog file is created.
+struct __attribute__((packed)) DatalogFileHeader {
+    uint32_t magic;        // DATALOG_MAGIC
+    uint16_t version;      // DATALOG_VERSION
+    uint16_t blockSize;    // DATALOG_BLOCK_SIZE
+    uint32_t capacity;     // Max blocks before the file is rotated
+    uint32_t reserved;
+};
+
+// Block index entry (one per block), kept in a separate file next to each
+// datalog file. Lets reads and time lookups jump straight to a block.
+struct __attribute__((packed)) DatalogIndexEntry {
+    uint32_t epoch;        // Timestamp of the first record in the block
+    uint32_t recordIndex;  // Number of records in all preceding blocks
+};
+
+constexpr uint32_t DATALOG_MAGIC = 0x32474C44;    // "DLG2"
+constexpr uint16_t DATALOG_VERSION = 2;
+constexpr uint32_t DATALOG_MAGIC_V1 = 0x31474C44; // "DLG1": uncompressed records, migrated on boot
+
+// Outcome of DataLogger_logSensorData()
+enum DatalogWriteResult : uint8_t {
+    DATALOG_WRITE_FAILED,  // Invalid reading or file error
+    DATALOG_WRITE_LOGGED,  // Written (or buffered in RTC memory)
+    DATALOG_WRITE_SKIPPED  // Within the deadband and no heartbeat due: nothing written
+};
 
 // --- Public Functions ---
 /**
- * @brief Initializes the LittleFS file system for data logging.
- * Formats LittleFS if mounting fails.
- * @return true if LittleFS is successfully mounted, false otherwise.
+ * @brief Creates the lock shared by the sampler task and web handlers.
+ * Call once in setup(), before any task that logs or reads is started.
+ */
+void DataLogger_init();
+
+/**
+ * @brief Takes the datalog lock for files written under it by the
+ * datalogger, i.e. the rollups (see data_rollup.h). Not recursive: never
+ * call other DataLogger functions while holding it.
+ */
+void DataLogger_lockStorage();
+void DataLogger_unlockStorage();
+
+/**
+ * @brief Mounts LittleFS (formatting on failure) once per boot.
+ * Migrates a legacy CSV or uncompressed datalog to the block format on the
+ * first mount after an update. Called on first use (flush or read), so timer
+ * wakes that only buffer a sample never mount; this is the SUBSYSTEM_STORAGE
+ * start function (see subsystem.h).
+ * @return true if the file system is mounted.
+ */
+bool DataLogger_mountStorage();
+
+/**
+ * @brief Logs sensor data (humidity and temperature) as one binary record.
+ * degraded sets RECORD_FLAG_DEGRADED (acquisition quality, see sensor_acquisition.h).
+ * With DATALOG_DEADBAND_ENABLED the sample is only written if either channel
+ * moved by its deadband since the last written sample, or the last write is
+ * DATALOG_HEARTBEAT_SECONDS ago. The DataLogger_getLast* values describe
+ * the latest sample either way.
+ * With batching enabled the record is buffered in RTC memory and flushed
+ * every DATALOG_FLUSH_EVERY_N samples. Otherwise it is written directly.
+ * Creates the datalog file (with header) if needed and rotates it to the
+ * archive file once it reaches DATALOG_MAX_BLOCKS.
+ * @return DATALOG_WRITE_LOGGED, DATALOG_WRITE_SKIPPED, or DATALOG_WRITE_FAILED on error.
+ */
+DatalogWriteResult DataLogger_logSensorData(float temperature, float humidity, bool degraded = false);
+
+/**
+ * @brief Writes all samples buffered in RTC memory to flash in one write.
+ * Call before the datalog is read (web server) or when the buffer must not
+ * be at risk (button wake, restart).
+ * @return true if nothing was pending or the flush succeeded. On failure
+ * the samples stay buffered.
  */
-bool DataLogger_init();
+bool DataLogger_flush();
 
 /**
- * @brief Logs sensor data (humidity and temperature) to the configured log file.
- * Writes header if the file is empty.
- * @return true if data was successfully logged, false on error.
+ * @brief Number of samples buffered in RTC memory, not yet on flash.
  */
-bool DataLogger_logSensorData(float temperature, float humidity);
+uint8_t DataLogger_getPendingCount();
 
 /**
- * @brief Gets the last successfully logged humidity value.
- * @return The last humidity value, or NaN if no data has been logged yet or on error.
+ * @brief Gets the humidity of the latest sample (written or skipped by the deadband).
+ * @return The last humidity value, or NaN if no sample has been taken yet.
  */
 float DataLogger_getLastHumidity();
 
 /**
- * @brief Gets the last successfully logged temperature value.
- * @return The last temperature value, or NaN if no data has been logged yet or on error.
+ * @brief Gets the temperature of the latest sample (written or skipped by the deadband).
+ * @return The last temperature value, or NaN if no sample has been taken yet.
  */
 float DataLogger_getLastTemperature();
 
 /**
- * @brief Gets the timestamp of the LAST successful logging event.
+ * @brief Gets the timestamp of the latest sample.
  * Retreived from RTC memory.
- * @return String containing the time (e.g. "2025-01-01 12:00:00").
+ * @return The time (e.g. "2025-01-01 12:00:00"), "Provisional +<s>s #<session>"
+ * (see DataLogger_resolveProvisional()), "Time Not Set" or "N/A".
+ */
+const char* DataLogger_getLastLogTime();
+
+/**
+ * @brief Epoch of the latest sample, 0 if none or its time was not set
+ * (or is still provisional).
+ */
+uint32_t DataLogger_getLastLogEpoch();
+
+/**
+ * @brief Counts samples, written or not (RTC memory, restarts at 0 after a reset).
+ * Changes exactly when the DataLogger_getLast* values do, so it can key caches.
+ */
+uint32_t DataLogger_getSampleSequence();
+
+/**
+ * @brief Samples skipped by the deadband since the last written one (RTC memory).
+ */
+uint16_t DataLogger_getSkippedCount();
+
+/**
+ * @brief Gives samples logged before the clock was set their real time.
+ * Without trusted time, samples are stamped with the RTC timer and the
+ * power-on session (RECORD_FLAG_PROVISIONAL). Once the time is set, all
+ * provisional samples of this session (RTC ring and flash tail) are
+ * rewritten in one pass and fed to the rollups. Cheap when there are none;
+ * call whenever the clock becomes trusted. Also run before the first
+ * trusted sample is logged.
+ * @return false if the time is not set or the rewrite failed (retried on
+ * the next call).
+ */
+bool DataLogger_resolveProvisional();
+
+// --- Record Access ---
+
+/**
+ * @brief Total number of records stored on flash (archive file + active file).
+ * Does not include samples still buffered in RTC memory.
+ */
+size_t DataLogger_getRecordCount();
+
+/**
+ * @brief Reads consecutive records, oldest first.
+ * Index 0 is the oldest record in the archive file (if any).
+ * @param firstIndex Index of the first record to read.
+ * @param out Destination buffer.
+ * @param maxCount Capacity of the destination buffer.
+ * @return Number of records read (0 when firstIndex is past the end).
+ */
+size_t DataLogger_readRecords(size_t firstIndex, SensorRecord* out, size_t maxCount);
+
+/**
+ * @brief Finds the first stored record with a timestamp at or after epoch.
+ * Uses the on-flash block index, so the cost does not grow with log size.
+ * @return Record index usable with DataLogger_readRecords(), or
+ * DataLogger_getRecordCount() if no such record exists.
+ */
+size_t DataLogger_findFirstRecordAtOrAfter(uint32_t epoch);
+
+/**
+ * @brief Checks the CRC of a record.
+ */
+bool DataLogger_isRecordValid(const SensorRecord& record);
+
+/**
+ * @brief Returns the CSV header line (without line ending).
+ */
+const char* DataLogger_getCsvHeader();
+
+/**
+ * @brief Formats one record as a CSV line ("Timestamp,Humidity,Temperature\n").
+ * @return Number of characters written (excluding the terminator), or 0 if
+ * the buffer is too small.
  */
-String DataLogger_getLastLogTime(); 
+size_t DataLogger_formatCsvRow(const SensorRecord& record, char* buffer, size_t bufferSize);
@@ -0,0 +1,329 @@
+// data_rollup.cpp
+
+#include "data_rollup.h"
+#include "system_logger.h"
+#include "config.h"
+
+#include <time.h>
+#include "subsystem.h"
+#include "data_logger.h" // Readers take the lock the datalogger writes under
+#include "hal/hal_fs.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
+
+#define LOG_TAG "ROLLUP"
+
+// --- Tier Configuration ---
+struct RollupTierConfig {
+    const char* name;
+    const char* path;         // Finished buckets, append-only
+    const char* archivePath;  // Previous file after rotation
+    uint32_t maxEntries;      // Buckets per file before rotation
+};
+
+static const RollupTierConfig TIERS[ROLLUP_TIER_COUNT] = {
+    { "hour",  "/rollup_hour.bin",  "/rollup_hour.old.bin",  ROLLUP_HOUR_MAX_ENTRIES },
+    { "day",   "/rollup_day.bin",   "/rollup_day.old.bin",   ROLLUP_DAY_MAX_ENTRIES },
+    { "month", "/rollup_month.bin", "/rollup_month.old.bin", ROLLUP_MONTH_MAX_ENTRIES },
+};
+
+static const char* OPEN_BUCKETS_PATH = "/rollup_open.bin";
+
+// In-progress bucket per tier. count == 0 means empty.
+// RTC memory avoids re-reading the snapshot file after every deep sleep.
+RTC_DATA_ATTR static RollupBucket s_openBuckets[ROLLUP_TIER_COUNT];
+RTC_DATA_ATTR static bool s_openBucketsLoaded = false;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Start of the period containing epoch, using local time boundaries.
+ */
+static uint32_t periodStartFor(RollupTier tier, uint32_t epoch) {
+    if (tier == ROLLUP_HOUR) {
+        return epoch - (epoch % 3600);
+    }
+
+    time_t t = (time_t)epoch;
+    struct tm timeinfo;
+    localtime_r(&t, &timeinfo);
+    timeinfo.tm_hour = 0;
+    timeinfo.tm_min = 0;
+    timeinfo.tm_sec = 0;
+    if (tier == ROLLUP_MONTH) {
+        timeinfo.tm_mday = 1;
+    }
+    timeinfo.tm_isdst = -1;
+    return (uint32_t)mktime(&timeinfo);
+}
+
+static void startBucket(RollupBucket& bucket, uint32_t periodStart, const SensorRecord& record) {
+    bucket.periodStart = periodStart;
+    bucket.count = 1;
+    bucket.tempMin = bucket.tempMax = record.temperature;
+    bucket.humMin = bucket.humMax = record.humidity;
+    bucket.tempSum = record.temperature;
+    bucket.humSum = record.humidity;
+}
+
+static void addToBucket(RollupBucket& bucket, const SensorRecord& record) {
+    bucket.count++;
+    if (record.temperature < bucket.tempMin) bucket.tempMin = record.temperature;
+    if (record.temperature > bucket.tempMax) bucket.tempMax = record.temperature;
+    if (record.humidity < bucket.humMin) bucket.humMin = record.humidity;
+    if (record.humidity > bucket.humMax) bucket.humMax = record.humidity;
+    bucket.tempSum += record.temperature;
+    bucket.humSum += record.humidity;
+}
+
+static size_t countEntries(const char* path) {
+    if (!HalFs().exists(path)) return 0;
+    File file = HalFs().open(path, "r");
+    if (!file) return 0;
+    size_t count = file.size() / sizeof(RollupBucket);
+    file.close();
+    return count;
+}
+
+static size_t readEntries(const char* path, size_t firstIndex, RollupBucket* out, size_t maxCount) {
+    File file = HalFs().open(path, "r");
+    if (!file) return 0;
+    file.seek(firstIndex * sizeof(RollupBucket));
+    size_t bytes = file.read(reinterpret_cast<uint8_t*>(out), maxCount * sizeof(RollupBucket));
+    file.close();
+    return bytes / sizeof(RollupBucket);
+}
+
+/**
+ * @brief Appends a finished bucket to its tier file, rotating when full.
+ */
+static void appendBucket(RollupTier tier, const RollupBucket& bucket) {
+    const RollupTierConfig& cfg = TIERS[tier];
+
+    size_t stored = countEntries(cfg.path);
+    if (stored >= cfg.maxEntries) {
+        LOG_INFO(LOG_TAG, "Rollup '%s' full. Rotating to %s.", cfg.name, cfg.archivePath);
+        if (HalFs().exists(cfg.archivePath)) {
+            HalFs().remove(cfg.archivePath);
+        }
+        HalFs().rename(cfg.path, cfg.archivePath);
+        stored = 0;
+    }
+
+    // "r+" at the slot boundary so a torn entry is overwritten, "w" for a new file
+    File file = HalFs().open(cfg.path, (stored > 0) ? "r+" : "w");
+    if (!file) {
+        LOG_ERROR(LOG_TAG, "Error opening %s!", cfg.path);
+        return;
+    }
+    file.seek(stored * sizeof(RollupBucket));
+    if (file.write(reinterpret_cast<const uint8_t*>(&bucket), sizeof(bucket)) != sizeof(bucket)) {
+        LOG_ERROR(LOG_TAG, "Short write to %s.", cfg.path);
+    }
+    file.close();
+}
+
+/**
+ * @brief Checks whether a new period would land at or before the last
+ * finished bucket of its tier (clock stepped back, open bucket lost).
+ */
+static bool isAtOrBeforeLastStored(RollupTier tier, uint32_t periodStart) {
+    const RollupTierConfig& cfg = TIERS[tier];
+    size_t stored = countEntries(cfg.path);
+    RollupBucket last;
+    return stored > 0 && readEntries(cfg.path, stored - 1, &last, 1) == 1 && periodStart <= last.periodStart;
+}
+
+/**
+ * @brief Folds a late sample (the clock was stepped back) into the finished
+ * bucket of its period, so the tier file stays sorted by period start for
+ * DataRollup_findFirstAtOrAfter(). A period without a bucket in the active
+ * file is not inserted (that would rewrite the file): the sample is dropped.
+ * @return true if merged.
+ */
+static bool mergeLateRecord(RollupTier tier, uint32_t periodStart, const SensorRecord& record) {
+    const RollupTierConfig& cfg = TIERS[tier];
+    size_t stored = countEntries(cfg.path);
+
+    // 1. Binary search for the period
+    size_t lo = 0;
+    size_t hi = stored;
+    RollupBucket bucket;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (readEntries(cfg.path, mid, &bucket, 1) != 1) return false;
+        if (bucket.periodStart < periodStart) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == stored || readEntries(cfg.path, lo, &bucket, 1) != 1 || bucket.periodStart != periodStart) {
+        return false;
+    }
+
+    // 2. Update it in place
+    addToBucket(bucket, record);
+    File file = HalFs().open(cfg.path, "r+");
+    if (!file) return false;
+    file.seek(lo * sizeof(RollupBucket));
+    bool ok = file.write(reinterpret_cast<const uint8_t*>(&bucket), sizeof(bucket)) == sizeof(bucket);
+    file.close();
+    return ok;
+}
+
+/**
+ * @brief Restores in-progress buckets after a cold boot (RTC memory lost).
+ */
+static void loadOpenBuckets() {
+    if (s_openBucketsLoaded) return;
+    s_openBucketsLoaded = true;
+
+    memset(s_openBuckets, 0, sizeof(s_openBuckets));
+    if (!HalFs().exists(OPEN_BUCKETS_PATH)) return;
+
+    File file = HalFs().open(OPEN_BUCKETS_PATH, "r");
+    if (!file) return;
+    if (file.read(reinterpret_cast<uint8_t*>(s_openBuckets), sizeof(s_openBuckets)) != sizeof(s_openBuckets)) {
+        LOG_WARN(LOG_TAG, "Open bucket snapshot is incomplete. Starting fresh.");
+        memset(s_openBuckets, 0, sizeof(s_openBuckets));
+    }
+    file.close();
+}
+
+/**
+ * @brief Bucket count and reads. Buckets are appended by the datalogger
+ * under its lock (background sampler), so the public readers hold the same
+ * lock around these.
+ */
+static size_t getCountLocked(RollupTier tier) {
+    if (!Subsystem_require(SUBSYSTEM_STORAGE)) return 0;
+    loadOpenBuckets();
+
+    const RollupTierConfig& cfg = TIERS[tier];
+    size_t count = countEntries(cfg.archivePath) + countEntries(cfg.path);
+    if (s_openBuckets[tier].count > 0) count++;
+    return count;
+}
+
+static size_t readLocked(RollupTier tier, size_t firstIndex, RollupBucket* out, size_t maxCount) {
+    if (!Subsystem_require(SUBSYSTEM_STORAGE)) return 0;
+    loadOpenBuckets();
+
+    const RollupTierConfig& cfg = TIERS[tier];
+    size_t archived = countEntries(cfg.archivePath);
+    size_t active = countEntries(cfg.path);
+    size_t read = 0;
+
+    // 1. Archive file
+    if (firstIndex < archived && read < maxCount) {
+        size_t wanted = archived - firstIndex;
+        if (wanted > maxCount) wanted = maxCount;
+        read = readEntries(cfg.archivePath, firstIndex, out, wanted);
+        if (read < wanted) return read;
+    }
+
+    // 2. Active file
+    size_t index = firstIndex + read;
+    if (index >= archived && index < archived + active && read < maxCount) {
+        size_t wanted = archived + active - index;
+        if (wanted > maxCount - read) wanted = maxCount - read;
+        size_t got = readEntries(cfg.path, index - archived, out + read, wanted);
+        read += got;
+        if (got < wanted) return read;
+    }
+
+    // 3. In-progress bucket
+    index = firstIndex + read;
+    if (index == archived + active && read < maxCount && s_openBuckets[tier].count > 0) {
+        out[read++] = s_openBuckets[tier];
+    }
+    return read;
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void DataRollup_addRecord(const SensorRecord& record) {
+    if (!(record.flags & RECORD_FLAG_TIME_VALID)) return;
+
+    loadOpenBuckets();
+
+    for (int i = 0; i < ROLLUP_TIER_COUNT; i++) {
+        RollupTier tier = (RollupTier)i;
+        RollupBucket& open = s_openBuckets[i];
+        uint32_t periodStart = periodStartFor(tier, record.epoch);
+
+        if (open.count > 0 && open.periodStart == periodStart) {
+            addToBucket(open, record);
+            continue;
+        }
+
+        // Late sample: buckets are never appended out of order
+        bool late = (open.count > 0) ? (periodStart < open.periodStart) : isAtOrBeforeLastStored(tier, periodStart);
+        if (late) {
+            if (!mergeLateRecord(tier, periodStart, record)) {
+                LOG_DEBUG(LOG_TAG, "Late sample for a '%s' period without a bucket. Not rolled up.", TIERS[i].name);
+            }
+            continue;
+        }
+
+        // New period: persist the finished bucket and start over
+        if (open.count > 0) {
+            appendBucket(tier, open);
+        }
+        startBucket(open, periodStart, record);
+    }
+}
+
+void DataRollup_saveOpenBuckets() {
+    if (!s_openBucketsLoaded) return; // Nothing added this boot
+
+    File file = HalFs().open(OPEN_BUCKETS_PATH, "w");
+    if (!file) {
+        LOG_ERROR(LOG_TAG, "Error opening %s!", OPEN_BUCKETS_PATH);
+        return;
+    }
+    file.write(reinterpret_cast<const uint8_t*>(s_openBuckets), sizeof(s_openBuckets));
+    file.close();
+}
+
+size_t DataRollup_getCount(RollupTier tier) {
+    DataLogger_lockStorage();
+    size_t count = getCountLocked(tier);
+    DataLogger_unlockStorage();
+    return count;
+}
+
+size_t DataRollup_read(RollupTier tier, size_t firstIndex, RollupBucket* out, size_t maxCount) {
+    DataLogger_lockStorage();
+    size_t read = readLocked(tier, firstIndex, out, maxCount);
+    DataLogger_unlockStorage();
+    return read;
+}
+
+size_t DataRollup_findFirstAtOrAfter(RollupTier tier, uint32_t epoch) {
+    DataLogger_lockStorage(); // One consistent view for the whole search
+    size_t lo = 0;
+    size_t hi = getCountLocked(tier);
+
+    // Binary search; each probe is a single-entry read
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        RollupBucket bucket;
+        if (readLocked(tier, mid, &bucket, 1) != 1) break;
+        if (bucket.periodStart < epoch) lo = mid + 1;
+        else hi = mid;
+    }
+    DataLogger_unlockStorage();
+    return lo;
+}
+
+bool DataRollup_parseTier(const char* name, RollupTier& tier) {
+    for (int i = 0; i < ROLLUP_TIER_COUNT; i++) {
+        if (strcmp(name, TIERS[i].name) == 0) {
+            tier = (RollupTier)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* DataRollup_getTierName(RollupTier tier) {
+    return TIERS[tier].name;
+}
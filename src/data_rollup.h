@@ -0,0 +1,81 @@
+// data_rollup.h
+
+#pragma once
+
+#include <Arduino.h>
+#include "data_logger.h" // For SensorRecord
+
+// --- Rollup Tiers ---
+// Running min/max/mean/count per hour, day and month. Each tier keeps the
+// bucket that is still filling in RTC memory; when a sample lands in a new
+// period the finished bucket is appended to the tier's file. Updating all
+// tiers is O(1) per sample, and long-range queries read these small files
+// instead of the raw datalog.
+
+enum RollupTier {
+    ROLLUP_HOUR,
+    ROLLUP_DAY,
+    ROLLUP_MONTH,
+    ROLLUP_TIER_COUNT
+};
+
+struct __attribute__((packed)) RollupBucket {
+    uint32_t periodStart;  // Epoch of the period start (local time boundaries)
+    uint32_t count;        // Samples aggregated
+    int16_t  tempMin;      // Centi-degrees Celsius
+    int16_t  tempMax;
+    uint16_t humMin;       // Centi-percent RH
+    uint16_t humMax;
+    int32_t  tempSum;      // Sum of centi-degrees (mean = sum / count)
+    uint32_t humSum;       // Sum of centi-percent
+};
+static_assert(sizeof(RollupBucket) == 24, "RollupBucket must stay packed");
+
+// --- Public Functions ---
+
+/**
+ * @brief Adds one persisted sample to all tiers.
+ * Called by the datalogger for every record it writes to flash, so the
+ * rollups always describe exactly the data on flash. Records without a
+ * valid timestamp are ignored. Requires LittleFS to be mounted.
+ */
+void DataRollup_addRecord(const SensorRecord& record);
+
+/**
+ * @brief Saves the in-progress buckets to flash so they survive power loss.
+ * Called once after each batch of DataRollup_addRecord() calls.
+ */
+void DataRollup_saveOpenBuckets();
+
+/**
+ * @brief Number of buckets in a tier, including the one still filling.
+ * The readers below take the datalog lock (see DataLogger_lockStorage()).
+ */
+size_t DataRollup_getCount(RollupTier tier);
+
+/**
+ * @brief Reads consecutive buckets, oldest first. The last index is the
+ * in-progress bucket.
+ * @return Number of buckets read.
+ */
+size_t DataRollup_read(RollupTier tier, size_t firstIndex, RollupBucket* out, size_t maxCount);
+
+/**
+ * @brief Finds the first bucket whose period starts at or after epoch.
+ * Buckets are kept in period order (samples that arrive late after the
+ * clock was stepped back are merged or dropped), so this is a binary
+ * search on flash.
+ * @return Bucket index, or DataRollup_getCount() if none.
+ */
+size_t DataRollup_findFirstAtOrAfter(RollupTier tier, uint32_t epoch);
+
+/**
+ * @brief Parses a tier name ("hour", "day", "month").
+ * @return true if the name is valid.
+ */
+bool DataRollup_parseTier(const char* name, RollupTier& tier);
+
+/**
+ * @brief Returns the tier name used by the web API.
+ */
+const char* DataRollup_getTierName(RollupTier tier);
@@ -0,0 +1,271 @@
+// datalog_codec.cpp
+
+#include "datalog_codec.h"
+
+#include <cstring>
+
+// Size of the first (raw) record in a block: epoch + temp + hum + flags
+static constexpr size_t RAW_RECORD_SIZE = 9;
+
+// Worst case for an encoded record: 64-bit varint + flags + two 16-bit varints
+static constexpr size_t MAX_ENCODED_SIZE = 10 + 1 + 3 + 3;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief CRC-8 (polynomial 0x07), used to detect corrupted records.
+ */
+static uint8_t crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0x00;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief CRC-16/CCITT-FALSE, used to validate whole blocks.
+ */
+static uint16_t crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint16_t blockCrc(const uint8_t* block, uint8_t count, uint16_t used) {
+    uint16_t crc = crc16(0xFFFF, &count, 1);
+    return crc16(crc, block + sizeof(DatalogBlockHeader), used);
+}
+
+static int16_t quantize(int32_t centi) {
+    // Round half away from zero
+    int32_t q = (centi >= 0) ? (centi + DATALOG_VALUE_QUANTUM / 2) / DATALOG_VALUE_QUANTUM
+                             : (centi - DATALOG_VALUE_QUANTUM / 2) / DATALOG_VALUE_QUANTUM;
+    return (int16_t)q;
+}
+
+static uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static size_t putVarint(uint8_t* out, uint64_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        out[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t)v;
+    return n;
+}
+
+static bool getVarint(const uint8_t* payload, uint16_t used, uint16_t& pos, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= used) return false;
+        uint8_t byte = payload[pos++];
+        v |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+static void putRaw(uint8_t* out, const SensorRecord& q) {
+    memcpy(out, &q.epoch, 4);
+    memcpy(out + 4, &q.temperature, 2);
+    memcpy(out + 6, &q.humidity, 2);
+    out[8] = q.flags;
+}
+
+static void getRaw(const uint8_t* in, SensorRecord& q) {
+    memcpy(&q.epoch, in, 4);
+    memcpy(&q.temperature, in + 4, 2);
+    memcpy(&q.humidity, in + 6, 2);
+    q.flags = in[8];
+}
+
+/**
+ * @brief Restores a quantized record to centi-units and seals it.
+ */
+static void dequantize(const SensorRecord& q, SensorRecord& out) {
+    out.epoch = q.epoch;
+    out.temperature = (int16_t)(q.temperature * DATALOG_VALUE_QUANTUM);
+    out.humidity = (uint16_t)(q.humidity * DATALOG_VALUE_QUANTUM);
+    out.flags = q.flags;
+    DatalogCodec_sealRecord(out);
+}
+
+// --- RECORD HELPERS ---
+
+void DatalogCodec_sealRecord(SensorRecord& record) {
+    record.crc = crc8(reinterpret_cast<const uint8_t*>(&record), offsetof(SensorRecord, crc));
+}
+
+bool DatalogCodec_isRecordValid(const SensorRecord& record) {
+    return record.crc == crc8(reinterpret_cast<const uint8_t*>(&record), offsetof(SensorRecord, crc));
+}
+
+// --- ENCODER ---
+
+void DatalogCodec_beginBlock(DatalogBlockEncoder& enc, uint8_t* block) {
+    memset(block, 0xFF, DATALOG_BLOCK_SIZE); // Erased-flash pattern for the unused tail
+    enc.block = block;
+    enc.used = 0;
+    enc.count = 0;
+    enc.prevDelta = 0;
+    memset(&enc.prev, 0, sizeof(enc.prev));
+}
+
+bool DatalogCodec_resumeBlock(DatalogBlockEncoder& enc, uint8_t* block) {
+    DatalogBlockDecoder dec;
+    if (!DatalogCodec_openBlock(dec, block)) {
+        DatalogCodec_beginBlock(enc, block);
+        return false;
+    }
+
+    // Replay to recover the last (quantized) record and delta
+    SensorRecord record;
+    while (DatalogCodec_nextRecord(dec, record)) {
+    }
+    if (dec.index != dec.count) {
+        DatalogCodec_beginBlock(enc, block);
+        return false;
+    }
+
+    enc.block = block;
+    enc.used = dec.used;
+    enc.count = dec.count;
+    enc.prev = dec.prev;
+    enc.prevDelta = dec.prevDelta;
+    return true;
+}
+
+bool DatalogCodec_appendRecord(DatalogBlockEncoder& enc, const SensorRecord& record) {
+    if (enc.count == UINT8_MAX) return false;
+
+    SensorRecord q;
+    q.epoch = record.epoch;
+    q.temperature = quantize(record.temperature);
+    q.humidity = (uint16_t)quantize(record.humidity);
+    q.flags = record.flags;
+    q.crc = 0;
+
+    uint8_t* payload = enc.block + sizeof(DatalogBlockHeader);
+
+    // 1. First record of a block is stored raw (decoding can start at any block)
+    if (enc.count == 0) {
+        putRaw(payload, q);
+        enc.used = RAW_RECORD_SIZE;
+        enc.count = 1;
+        enc.prev = q;
+        enc.prevDelta = 0;
+        return true;
+    }
+
+    // 2. Following records are encoded against the previous one
+    uint8_t encoded[MAX_ENCODED_SIZE];
+    size_t len = 0;
+
+    int64_t delta = (int64_t)q.epoch - (int64_t)enc.prev.epoch;
+    int64_t deltaOfDelta = delta - enc.prevDelta;
+    bool flagsChanged = (q.flags != enc.prev.flags);
+
+    len += putVarint(encoded + len, (zigzag(deltaOfDelta) << 1) | (flagsChanged ? 1 : 0));
+    if (flagsChanged) encoded[len++] = q.flags;
+    len += putVarint(encoded + len, (uint16_t)q.temperature ^ (uint16_t)enc.prev.temperature);
+    len += putVarint(encoded + len, (uint16_t)(q.humidity ^ enc.prev.humidity));
+
+    if (enc.used + len > DATALOG_BLOCK_PAYLOAD) return false; // Block full: seal it
+
+    memcpy(payload + enc.used, encoded, len);
+    enc.used += (uint16_t)len;
+    enc.count++;
+    enc.prev = q;
+    enc.prevDelta = delta;
+    return true;
+}
+
+void DatalogCodec_finishBlock(DatalogBlockEncoder& enc) {
+    DatalogBlockHeader header = {};
+    header.count = enc.count;
+    header.reserved = 0;
+    header.used = enc.used;
+    header.crc = blockCrc(enc.block, enc.count, enc.used);
+    header.reserved2 = 0;
+    memcpy(enc.block, &header, sizeof(header));
+}
+
+// --- DECODER ---
+
+bool DatalogCodec_openBlock(DatalogBlockDecoder& dec, const uint8_t* block) {
+    DatalogBlockHeader header;
+    memcpy(&header, block, sizeof(header));
+
+    dec.block = block;
+    dec.pos = 0;
+    dec.used = 0;
+    dec.count = 0;
+    dec.index = 0;
+    dec.prevDelta = 0;
+    memset(&dec.prev, 0, sizeof(dec.prev));
+
+    if (header.count == 0 || header.count == 0xFF || header.used < RAW_RECORD_SIZE ||
+        header.used > DATALOG_BLOCK_PAYLOAD) {
+        return false;
+    }
+    if (header.crc != blockCrc(block, header.count, header.used)) {
+        return false;
+    }
+
+    dec.used = header.used;
+    dec.count = header.count;
+    return true;
+}
+
+bool DatalogCodec_nextRecord(DatalogBlockDecoder& dec, SensorRecord& out) {
+    if (dec.index >= dec.count) return false;
+
+    const uint8_t* payload = dec.block + sizeof(DatalogBlockHeader);
+    SensorRecord q;
+
+    if (dec.index == 0) {
+        getRaw(payload, q);
+        dec.pos = RAW_RECORD_SIZE;
+        dec.prevDelta = 0;
+    } else {
+        uint64_t head, tempXor, humXor;
+        if (!getVarint(payload, dec.used, dec.pos, head)) return false;
+
+        bool flagsChanged = head & 1;
+        int64_t delta = dec.prevDelta + unzigzag(head >> 1);
+
+        q.flags = dec.prev.flags;
+        if (flagsChanged) {
+            if (dec.pos >= dec.used) return false;
+            q.flags = payload[dec.pos++];
+        }
+        if (!getVarint(payload, dec.used, dec.pos, tempXor)) return false;
+        if (!getVarint(payload, dec.used, dec.pos, humXor)) return false;
+
+        q.epoch = (uint32_t)((int64_t)dec.prev.epoch + delta);
+        q.temperature = (int16_t)((uint16_t)dec.prev.temperature ^ (uint16_t)tempXor);
+        q.humidity = (uint16_t)(dec.prev.humidity ^ (uint16_t)humXor);
+        dec.prevDelta = delta;
+    }
+    q.crc = 0;
+
+    dec.prev = q;
+    dec.index++;
+    dequantize(q, out);
+    return true;
+}
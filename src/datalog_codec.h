@@ -0,0 +1,132 @@
+// datalog_codec.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// --- Sample Record ---
+// One sensor sample as seen by the rest of the application. On flash, records
+// are compressed into fixed-size blocks (see below); this struct is also the
+// unit buffered in RTC memory and handed to the web server.
+
+// Record flags
+constexpr uint8_t RECORD_FLAG_TIME_VALID = 0x01; // Epoch came from a synchronized clock
+constexpr uint8_t RECORD_FLAG_DEGRADED = 0x02;   // Sensor reads failed or were rejected (see sensor_acquisition.h)
+constexpr uint8_t RECORD_FLAG_PROVISIONAL = 0x04; // No trusted time yet: epoch is a monotonic stamp (below)
+
+// A provisional record is logged before the clock is set. Its epoch holds
+// the RTC timer in seconds (since power-on, runs through deep sleep), and
+// the upper flag bits hold the power-on session it counts from. Once
+// trusted time is known in the same session, the datalogger rewrites them
+// to real timestamps (see DataLogger_resolveProvisional()).
+constexpr uint8_t RECORD_SESSION_SHIFT = 4;
+constexpr uint8_t RECORD_SESSION_MASK = 0xF0;    // Session modulo 16
+
+struct __attribute__((packed)) SensorRecord {
+    uint32_t epoch;        // Seconds since 1970-01-01 (UTC)
+    int16_t  temperature;  // Centi-degrees Celsius (2150 = 21.50 C)
+    uint16_t humidity;     // Centi-percent RH (4500 = 45.00 %)
+    uint8_t  flags;        // RECORD_FLAG_* bits
+    uint8_t  crc;          // CRC-8 over all preceding bytes
+};
+static_assert(sizeof(SensorRecord) == 10, "SensorRecord must stay packed");
+
+// --- Compressed Block Format ---
+// A block holds a run of records in DATALOG_BLOCK_SIZE bytes:
+//   [DatalogBlockHeader][first record raw (9 bytes)][encoded records...]
+// Each following record is encoded against the previous one:
+//   varint( zigzag(delta-of-delta of epoch) << 1 | flagsChanged )
+//   [flags byte]                      -- only if flagsChanged
+//   varint( quantized temperature XOR previous )
+//   varint( quantized humidity XOR previous )
+// With the fixed LOG_INTERVAL_SECONDS cadence and slowly changing DHT values
+// a typical record costs 3 bytes instead of 10.
+// Values are quantized to DATALOG_VALUE_QUANTUM centi-units (0.1, the DHT22
+// resolution) before encoding.
+
+constexpr size_t DATALOG_BLOCK_SIZE = 256;
+constexpr int DATALOG_VALUE_QUANTUM = 10;
+
+struct __attribute__((packed)) DatalogBlockHeader {
+    uint8_t  count;        // Records in this block (0 = unused)
+    uint8_t  reserved;
+    uint16_t used;         // Payload bytes in use
+    uint16_t crc;          // CRC-16/CCITT over count and payload
+    uint16_t reserved2;
+};
+
+constexpr size_t DATALOG_BLOCK_PAYLOAD = DATALOG_BLOCK_SIZE - sizeof(DatalogBlockHeader);
+
+// Encoder state for the block being filled
+struct DatalogBlockEncoder {
+    uint8_t* block;        // DATALOG_BLOCK_SIZE bytes owned by the caller
+    uint16_t used;
+    uint8_t count;
+    SensorRecord prev;     // Quantized previous record
+    int64_t prevDelta;     // Previous epoch delta
+};
+
+// Decoder state for reading a block front to back
+struct DatalogBlockDecoder {
+    const uint8_t* block;
+    uint16_t pos;
+    uint16_t used;
+    uint8_t count;
+    uint8_t index;         // Records returned so far
+    SensorRecord prev;
+    int64_t prevDelta;
+};
+
+// --- Record Helpers ---
+
+/**
+ * @brief Computes and stores the record CRC.
+ */
+void DatalogCodec_sealRecord(SensorRecord& record);
+
+/**
+ * @brief Checks the record CRC.
+ */
+bool DatalogCodec_isRecordValid(const SensorRecord& record);
+
+// --- Encoder ---
+
+/**
+ * @brief Starts an empty block in the given buffer.
+ */
+void DatalogCodec_beginBlock(DatalogBlockEncoder& enc, uint8_t* block);
+
+/**
+ * @brief Continues appending to an existing (partially filled) block.
+ * Replays the block to recover the encoder state.
+ * @return false if the block is corrupt; the encoder is then left empty.
+ */
+bool DatalogCodec_resumeBlock(DatalogBlockEncoder& enc, uint8_t* block);
+
+/**
+ * @brief Encodes one record into the block.
+ * @return false if the block is full (the record was not added).
+ */
+bool DatalogCodec_appendRecord(DatalogBlockEncoder& enc, const SensorRecord& record);
+
+/**
+ * @brief Writes the block header (count, size, CRC). Call before storing the block.
+ */
+void DatalogCodec_finishBlock(DatalogBlockEncoder& enc);
+
+// --- Decoder ---
+
+/**
+ * @brief Validates a block and prepares to read its records.
+ * @return false if the block is empty or fails its CRC.
+ */
+bool DatalogCodec_openBlock(DatalogBlockDecoder& dec, const uint8_t* block);
+
+/**
+ * @brief Decodes the next record. Values are restored to centi-units and the
+ * record CRC is recomputed.
+ * @return false when the block is exhausted or malformed.
+ */
+bool DatalogCodec_nextRecord(DatalogBlockDecoder& dec, SensorRecord& out);
+
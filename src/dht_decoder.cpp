@@ -0,0 +1,70 @@
+// dht_decoder.cpp
+
+#include "dht_decoder.h"
+
+static constexpr size_t DHT_DATA_BITS = 40;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Converts the 4 data bytes to physical values (same rules as the
+ * Adafruit DHT library).
+ */
+static void convert(const uint8_t* data, uint8_t sensorType, float& temperature, float& humidity) {
+    if (sensorType == 11) {
+        humidity = data[0] + data[1] * 0.1f;
+        temperature = data[2];
+        if (data[3] & 0x80) temperature = -1 - temperature;
+        temperature += (data[3] & 0x0F) * 0.1f;
+    } else {
+        humidity = ((data[0] << 8) | data[1]) * 0.1f;
+        temperature = (((data[2] & 0x7F) << 8) | data[3]) * 0.1f;
+        if (data[2] & 0x80) temperature = -temperature;
+    }
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+DhtDecodeStatus DhtDecoder_decode(const DhtPulse* pulses, size_t count, uint8_t sensorType,
+                                  float& temperature, float& humidity) {
+    // 1. Find the last DHT_DATA_BITS high pulses, walking back from the end
+    size_t highIndex[DHT_DATA_BITS];
+    size_t found = 0;
+    for (size_t i = count; i > 0 && found < DHT_DATA_BITS; i--) {
+        if (pulses[i - 1].level) {
+            highIndex[DHT_DATA_BITS - 1 - found] = i - 1;
+            found++;
+        }
+    }
+    if (found < DHT_DATA_BITS) return DHT_DECODE_NO_RESPONSE;
+
+    // 2. Each bit: high pulse compared with the low pulse right before it
+    uint8_t data[5] = {0, 0, 0, 0, 0};
+    for (size_t bit = 0; bit < DHT_DATA_BITS; bit++) {
+        size_t i = highIndex[bit];
+        if (i == 0 || pulses[i - 1].level) return DHT_DECODE_BAD_TIMING;
+
+        uint16_t highUs = pulses[i].durationUs;
+        uint16_t lowUs = pulses[i - 1].durationUs;
+        if (highUs > DHT_MAX_PULSE_US || lowUs > DHT_MAX_PULSE_US) return DHT_DECODE_BAD_TIMING;
+
+        data[bit / 8] <<= 1;
+        if (highUs > lowUs) data[bit / 8] |= 1;
+    }
+
+    // 3. Checksum
+    if ((uint8_t)(data[0] + data[1] + data[2] + data[3]) != data[4]) return DHT_DECODE_CHECKSUM;
+
+    convert(data, sensorType, temperature, humidity);
+    return DHT_DECODE_OK;
+}
+
+const char* DhtDecoder_getStatusName(DhtDecodeStatus status) {
+    switch (status) {
+        case DHT_DECODE_OK:          return "OK";
+        case DHT_DECODE_NO_RESPONSE: return "NO_RESPONSE";
+        case DHT_DECODE_BAD_TIMING:  return "BAD_TIMING";
+        case DHT_DECODE_CHECKSUM:    return "CHECKSUM";
+        default:                     return "UNKNOWN";
+    }
+}
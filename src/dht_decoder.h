@@ -0,0 +1,51 @@
+// dht_decoder.h
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// --- DHT Pulse Train Decoder ---
+// Turns the line levels captured during one DHT11/DHT22 transaction into
+// temperature and humidity. Pure logic without hardware access, so it runs
+// unchanged on the host against recorded timings.
+//
+// On the wire, after the host's start signal:
+//   response: ~80 us low, ~80 us high
+//   40 bits, MSB first: ~50 us low, then high for ~27 us (0) or ~70 us (1)
+//   then ~50 us low and the line is released (idle high)
+// The 5 bytes are humidity (2), temperature (2) and a checksum: the low
+// byte of the sum of the first four.
+//
+// The capture may miss the first edges (the driver only starts listening
+// after it released the line), so the decoder takes the LAST 40 high pulses
+// as the data bits. A bit is 1 if its high pulse is longer than the low
+// pulse before it, which tolerates a capture clock that is off by a constant.
+
+constexpr uint16_t DHT_MAX_PULSE_US = 200; // Longer: edges were missed
+
+// One stretch of constant line level
+struct DhtPulse {
+    uint8_t level;        // 0 = low, 1 = high
+    uint16_t durationUs;
+};
+
+enum DhtDecodeStatus : uint8_t {
+    DHT_DECODE_OK,
+    DHT_DECODE_NO_RESPONSE, // Fewer than 40 bits captured
+    DHT_DECODE_BAD_TIMING,  // A bit pulse is too long or has no low before it
+    DHT_DECODE_CHECKSUM     // All bits seen, checksum mismatch
+};
+
+/**
+ * @brief Decodes one transaction.
+ * @param pulses Captured pulses, oldest first.
+ * @param sensorType 11 for the DHT11; anything else uses the DHT22 format
+ * (DHT21/AM2301/AM2302 are the same).
+ * @param temperature Degrees Celsius, written on DHT_DECODE_OK only.
+ * @param humidity Percent RH, written on DHT_DECODE_OK only.
+ */
+DhtDecodeStatus DhtDecoder_decode(const DhtPulse* pulses, size_t count, uint8_t sensorType,
+                                  float& temperature, float& humidity);
+
+const char* DhtDecoder_getStatusName(DhtDecodeStatus status);
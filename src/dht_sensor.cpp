@@ -3,24 +3,123 @@
 #include "dht_sensor.h"
 #include "config.h"
 #include "system_logger.h" 
+#include "hal/hal_sensor.h"
+#include "trace.h"
+#include "freertos/semphr.h"
+#include "freertos/queue.h"
 
 #define LOG_TAG "DHT" 
 
-// Initialize DHT object using the definitions from config.h/platformio.ini
+struct DhtResult {
+  bool ok;
+  float temperature;
+  float humidity;
+};
+
+// Live view (app controller) and background logging (sampler task) share the
+// sensor. The mutex guards the cached result and the pending callback.
+static SemaphoreHandle_t s_mutex = nullptr;
+static DhtResult s_lastResult = {false, NAN, NAN};
+static unsigned long s_lastReadMs = 0;
+static bool s_hasResult = false;
+static DHTSensorCallback s_pendingCallback = nullptr; // Set while a transaction runs
+static void* s_pendingContext = nullptr;
+static uint32_t s_startUs = 0;                        // For the trace event
+
+// DHTSensor_read() waits here for its transaction
+static QueueHandle_t s_resultQueue = nullptr;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void onTransactionDone(bool ok, float temperature, float humidity, void* context) {
+#if TRACE_ENABLED
+  Trace_record("dht.transaction", s_startUs);
+#endif
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  s_lastResult = {ok, temperature, humidity};
+  s_hasResult = true;
+  DHTSensorCallback callback = s_pendingCallback;
+  void* callbackContext = s_pendingContext;
+  s_pendingCallback = nullptr;
+  xSemaphoreGive(s_mutex);
+
+  if (callback) callback(ok, temperature, humidity, callbackContext);
+}
+
+static void onBlockingReadDone(bool ok, float temperature, float humidity, void* context) {
+  DhtResult result = {ok, temperature, humidity};
+  xQueueSend(s_resultQueue, &result, 0);
+}
+
+// --- PUBLIC FUNCTIONS ---
+
 // DHT_PIN comes from board definition
 // DHT_TYPE_DEF comes from SENSOR_TYPE in platformio.ini
-DHT dht(DHT_PIN, DHT_TYPE_DEF);
-
 bool DHTSensor_init() {
   LOG_INFO(LOG_TAG, "Initializing DHT Sensor (Type ID: %d, Pin: %d)", DHT_TYPE_DEF, DHT_PIN);
-  dht.begin();
-  return true;
+  if (!s_mutex) s_mutex = xSemaphoreCreateMutex();
+  if (!s_resultQueue) s_resultQueue = xQueueCreate(1, sizeof(DhtResult));
+  return HalSensor_begin();
 }
 
-float DHTSensor_readHumidity() {
-  return dht.readHumidity();
+bool DHTSensor_startRead(DHTSensorCallback callback, void* context) {
+  if (!s_mutex) return false;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+
+  // 1. Too soon for the sensor: hand out the last result instead
+  if (s_hasResult && millis() - s_lastReadMs < DHT_MIN_READ_INTERVAL_MS) {
+    DhtResult result = s_lastResult;
+    xSemaphoreGive(s_mutex);
+    callback(result.ok, result.temperature, result.humidity, context);
+    return true;
+  }
+
+  // 2. One transaction at a time
+  if (s_pendingCallback) {
+    xSemaphoreGive(s_mutex);
+    return false;
+  }
+  s_pendingCallback = callback;
+  s_pendingContext = context;
+  s_lastReadMs = millis();
+  s_startUs = micros();
+  xSemaphoreGive(s_mutex);
+
+  // 3. The driver calls back when both values are decoded
+  if (!HalSensor_startRead(onTransactionDone, nullptr)) {
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_pendingCallback = nullptr;
+    xSemaphoreGive(s_mutex);
+    return false;
+  }
+  return true;
 }
 
-float DHTSensor_readTemperature() {
-  return dht.readTemperature();
+bool DHTSensor_read(float& temperature, float& humidity) {
+  TRACE_SCOPE("dht.read");
+  temperature = NAN;
+  humidity = NAN;
+  if (!s_resultQueue) return false;
+
+  // A result left over from a read that timed out is stale
+  DhtResult result;
+  while (xQueueReceive(s_resultQueue, &result, 0) == pdTRUE) {
+  }
+
+  // Another transaction in flight (live view): it ends within ~30 ms
+  unsigned long startMs = millis();
+  while (!DHTSensor_startRead(onBlockingReadDone, nullptr)) {
+    if (millis() - startMs >= DHT_READ_TIMEOUT_MS) return false;
+    delay(5);
+  }
+
+  if (xQueueReceive(s_resultQueue, &result, pdMS_TO_TICKS(DHT_READ_TIMEOUT_MS)) != pdTRUE) {
+    LOG_WARN(LOG_TAG, "No answer from the sensor driver.");
+    return false;
+  }
+  temperature = result.temperature;
+  humidity = result.humidity;
+  return result.ok;
 }
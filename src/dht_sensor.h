@@ -2,7 +2,11 @@
 
 #pragma once
 
-#include <DHT.h>
+/**
+ * @brief Result of DHTSensor_startRead(). Runs in the driver's timer task
+ * (or in the caller, for a cached result); must not block.
+ */
+typedef void (*DHTSensorCallback)(bool ok, float temperature, float humidity, void* context);
 
 /**
  * @brief Initializes the DHT sensor.
@@ -11,13 +15,17 @@
 bool DHTSensor_init();
 
 /**
- * @brief Reads the humidity from the DHT sensor.
- * @return Humidity value as float, or NaN on error.
+ * @brief Reads temperature and humidity in one sensor transaction. The
+ * calling task sleeps while the sensor answers; nothing spins and
+ * interrupts stay enabled.
+ * @return false on a failed read (both values are NaN).
  */
-float DHTSensor_readHumidity();
+bool DHTSensor_read(float& temperature, float& humidity);
 
 /**
- * @brief Reads the temperature from the DHT sensor.
- * @return Temperature value as float, or NaN on error.
+ * @brief Starts a read and returns at once; the callback gets both values.
+ * Within DHT_MIN_READ_INTERVAL_MS of the previous transaction the callback
+ * runs immediately with that transaction's result.
+ * @return false if another transaction is in progress (no callback).
  */
-float DHTSensor_readTemperature();
+bool DHTSensor_startRead(DHTSensorCallback callback, void* context);
@@ -1,33 +1,61 @@
 // external_rtc.cpp
 #include "external_rtc.h"
 #include "system_logger.h"
-#include <Wire.h>
+#include "hal/hal_i2c.h"
+#include "trace.h"
 
 #define LOG_TAG "EXT_RTC"
 
+// DS3231 registers
+static constexpr uint8_t DS3231_ADDRESS = 0x68;
+static constexpr uint8_t DS3231_REG_TIME = 0x00;    // 7 BCD registers: sec, min, hour, wday, mday, month, year
+static constexpr uint8_t DS3231_REG_STATUS = 0x0F;
+static constexpr uint8_t DS3231_REG_TEMP = 0x11;    // MSB (signed integer part), LSB (quarters in bits 7-6)
+static constexpr uint8_t DS3231_STATUS_OSF = 0x80;  // Oscillator Stop Flag
+
 // Instantiate the global object
 ExternalRTCManager RTCManager;
 
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static uint8_t toBcd(int value) {
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+static int fromBcd(uint8_t value) {
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+// --- CLASS IMPLEMENTATION ---
+
 ExternalRTCManager::ExternalRTCManager() {
     _isInitialized = false;
 }
 
+bool ExternalRTCManager::lostPower() {
+    uint8_t status;
+    if (!HalI2C_readRegisters(DS3231_ADDRESS, DS3231_REG_STATUS, &status, 1)) return true;
+    return (status & DS3231_STATUS_OSF) != 0;
+}
+
 bool ExternalRTCManager::begin() {
     if (!HAS_EXTERNAL_RTC) {
         LOG_INFO(LOG_TAG, "External RTC disabled in config.");
         return false;
     }
 
+    TRACE_SCOPE("rtc.probe");
+
     // Initialize I2C. Safe to call even if OLED has called it before.
-    ::Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
+    HalI2C_begin();
 
-    if (!_rtc.begin()) {
+    if (!HalI2C_probe(DS3231_ADDRESS)) {
         LOG_ERROR(LOG_TAG, "Couldn't find RTC module! Check wiring.");
         _isInitialized = false;
         return false;
     }
 
-    if (_rtc.lostPower()) {
+    if (lostPower()) {
         LOG_WARN(LOG_TAG, "RTC lost power, time is invalid! Battery might be low.");
         // We return true because hardware is present, even if time is wrong.
     }
@@ -44,20 +72,26 @@ bool ExternalRTCManager::isRunning() {
 bool ExternalRTCManager::getTime(struct tm &timeinfo) {
     if (!_isInitialized) return false;
 
-    if (_rtc.lostPower()) {
+    TRACE_SCOPE("rtc.read");
+
+    if (lostPower()) {
         LOG_WARN(LOG_TAG, "RTC indicates power loss. Time untrusted.");
         return false; 
     }
 
-    DateTime now = _rtc.now();
+    uint8_t regs[7];
+    if (!HalI2C_readRegisters(DS3231_ADDRESS, DS3231_REG_TIME, regs, sizeof(regs))) {
+        LOG_ERROR(LOG_TAG, "Failed to read time registers.");
+        return false;
+    }
 
-    // Convert RTClib DateTime to standard C struct tm
-    timeinfo.tm_year = now.year() - 1900; 
-    timeinfo.tm_mon  = now.month() - 1;   
-    timeinfo.tm_mday = now.day();
-    timeinfo.tm_hour = now.hour();
-    timeinfo.tm_min  = now.minute();
-    timeinfo.tm_sec  = now.second();
+    // Convert BCD registers to standard C struct tm (24-hour mode, years 2000-2099)
+    timeinfo.tm_year = fromBcd(regs[6]) + 100; 
+    timeinfo.tm_mon  = fromBcd(regs[5] & 0x1F) - 1;   
+    timeinfo.tm_mday = fromBcd(regs[4]);
+    timeinfo.tm_hour = fromBcd(regs[2] & 0x3F);
+    timeinfo.tm_min  = fromBcd(regs[1]);
+    timeinfo.tm_sec  = fromBcd(regs[0] & 0x7F);
     timeinfo.tm_isdst = -1; 
 
     return true;
@@ -66,18 +100,37 @@ bool ExternalRTCManager::getTime(struct tm &timeinfo) {
 void ExternalRTCManager::setTime(struct tm timeinfo) {
     if (!_isInitialized) return;
 
-    _rtc.adjust(DateTime(
-        timeinfo.tm_year + 1900,
-        timeinfo.tm_mon + 1,
-        timeinfo.tm_mday,
-        timeinfo.tm_hour,
-        timeinfo.tm_min,
-        timeinfo.tm_sec
-    ));
+    // Normalize a copy to get the weekday (DS3231: 1-7, Sunday = 7)
+    struct tm normalized = timeinfo;
+    ::mktime(&normalized);
+
+    uint8_t regs[7];
+    regs[0] = toBcd(timeinfo.tm_sec);
+    regs[1] = toBcd(timeinfo.tm_min);
+    regs[2] = toBcd(timeinfo.tm_hour);
+    regs[3] = (uint8_t)(normalized.tm_wday == 0 ? 7 : normalized.tm_wday);
+    regs[4] = toBcd(timeinfo.tm_mday);
+    regs[5] = toBcd(timeinfo.tm_mon + 1);
+    regs[6] = toBcd((timeinfo.tm_year + 1900) % 100);
+
+    if (!HalI2C_writeRegisters(DS3231_ADDRESS, DS3231_REG_TIME, regs, sizeof(regs))) {
+        LOG_ERROR(LOG_TAG, "Failed to write time registers.");
+        return;
+    }
+
+    // Time is valid again: clear the Oscillator Stop Flag
+    uint8_t status;
+    if (HalI2C_readRegisters(DS3231_ADDRESS, DS3231_REG_STATUS, &status, 1)) {
+        status &= (uint8_t)~DS3231_STATUS_OSF;
+        HalI2C_writeRegisters(DS3231_ADDRESS, DS3231_REG_STATUS, &status, 1);
+    }
     LOG_INFO(LOG_TAG, "External RTC time updated.");
 }
 
 float ExternalRTCManager::getTemperature() {
     if (!_isInitialized) return NAN;
-    return _rtc.getTemperature();
+
+    uint8_t regs[2];
+    if (!HalI2C_readRegisters(DS3231_ADDRESS, DS3231_REG_TEMP, regs, sizeof(regs))) return NAN;
+    return (float)(int8_t)regs[0] + (float)(regs[1] >> 6) * 0.25f;
 }
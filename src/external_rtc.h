@@ -2,18 +2,22 @@
 #pragma once
 
 #include <Arduino.h>
-#include <RTClib.h> // Requires "RTClib" library by Adafruit
 #include "config.h"
 
 /**
  * @brief Class to manage the DS3231 External RTC Module.
  * Encapsulates hardware specific logic using best practices.
+ * Talks to the chip registers through the I2C HAL (hal/hal_i2c.h).
  */
 class ExternalRTCManager {
 private:
-    RTC_DS3231 _rtc;       // The driver object
     bool _isInitialized;   // Flag to track initialization status
 
+    /**
+     * @brief Reads the Oscillator Stop Flag (time invalid since power loss).
+     */
+    bool lostPower();
+
 public:
     ExternalRTCManager();
 
@@ -0,0 +1,36 @@
+// hal_clock_esp32.cpp
+
+#include "hal/hal_clock.h"
+#include <sys/time.h> // For settimeofday, adjtime
+
+extern "C" uint64_t esp_rtc_get_time_us(); // NB! Not public API, but survives deep sleep
+
+uint64_t HalClock_getRtcMicros() {
+    return esp_rtc_get_time_us();
+}
+
+time_t HalClock_getEpoch() {
+    return ::time(nullptr);
+}
+
+void HalClock_setEpoch(time_t epoch) {
+    struct timeval tv = { epoch, 0 };
+    ::settimeofday(&tv, NULL);
+}
+
+int64_t HalClock_getEpochMicros() {
+    struct timeval tv;
+    ::gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+}
+
+void HalClock_setEpochMicros(int64_t epochUs) {
+    struct timeval tv = { (time_t)(epochUs / 1000000LL), (suseconds_t)(epochUs % 1000000LL) };
+    ::settimeofday(&tv, NULL);
+}
+
+void HalClock_slew(int64_t deltaUs) {
+    // Seconds and microseconds carry the same sign; adjtime() adds them up
+    struct timeval delta = { (time_t)(deltaUs / 1000000LL), (suseconds_t)(deltaUs % 1000000LL) };
+    ::adjtime(&delta, NULL);
+}
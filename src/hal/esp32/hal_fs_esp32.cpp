@@ -0,0 +1,16 @@
+// hal_fs_esp32.cpp
+
+#include "hal/hal_fs.h"
+#include <LittleFS.h>
+
+bool HalFs_mount(bool formatIfFailed) {
+    return LittleFS.begin(formatIfFailed);
+}
+
+bool HalFs_format() {
+    return LittleFS.format();
+}
+
+fs::FS& HalFs() {
+    return LittleFS;
+}
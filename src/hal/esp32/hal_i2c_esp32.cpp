@@ -0,0 +1,34 @@
+// hal_i2c_esp32.cpp
+
+#include "hal/hal_i2c.h"
+#include "config.h"
+#include <Wire.h>
+
+bool HalI2C_begin() {
+    // Safe to call even if the OLED driver has started the bus before
+    return ::Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN);
+}
+
+bool HalI2C_probe(uint8_t address) {
+    ::Wire.beginTransmission(address);
+    return ::Wire.endTransmission() == 0;
+}
+
+bool HalI2C_readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t len) {
+    ::Wire.beginTransmission(address);
+    ::Wire.write(reg);
+    if (::Wire.endTransmission() != 0) return false;
+
+    if (::Wire.requestFrom(address, (uint8_t)len) != len) return false;
+    for (size_t i = 0; i < len; i++) {
+        data[i] = (uint8_t)::Wire.read();
+    }
+    return true;
+}
+
+bool HalI2C_writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t len) {
+    ::Wire.beginTransmission(address);
+    ::Wire.write(reg);
+    ::Wire.write(data, len);
+    return ::Wire.endTransmission() == 0;
+}
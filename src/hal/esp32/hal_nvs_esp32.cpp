@@ -0,0 +1,44 @@
+// hal_nvs_esp32.cpp
+
+#include "hal/hal_nvs.h"
+#include <Preferences.h>
+
+static Preferences s_prefs;
+
+bool HalNvs_begin(const char* nameSpace) {
+    return s_prefs.begin(nameSpace, false); // false = read/write
+}
+
+bool HalNvs_hasKey(const char* key) {
+    return s_prefs.isKey(key);
+}
+
+String HalNvs_getString(const char* key, const char* defaultValue) {
+    return s_prefs.getString(key, defaultValue);
+}
+
+size_t HalNvs_getString(const char* key, char* out, size_t size) {
+    if (size == 0) return 0;
+    out[0] = '\0';
+    if (!s_prefs.isKey(key)) return 0; // getString() would log an error
+    size_t len = s_prefs.getString(key, out, size);
+    out[size - 1] = '\0';
+    return len ? strlen(out) : 0;
+}
+
+bool HalNvs_putString(const char* key, const String& value) {
+    return s_prefs.putString(key, value) == value.length();
+}
+
+uint32_t HalNvs_getUInt(const char* key, uint32_t defaultValue) {
+    if (!s_prefs.isKey(key)) return defaultValue; // getUInt() would log an error
+    return s_prefs.getUInt(key, defaultValue);
+}
+
+bool HalNvs_putUInt(const char* key, uint32_t value) {
+    return s_prefs.putUInt(key, value) == sizeof(value);
+}
+
+bool HalNvs_remove(const char* key) {
+    return s_prefs.remove(key);
+}
@@ -0,0 +1,66 @@
+// hal_power_esp32.cpp
+
+#include "hal/hal_power.h"
+#include "system_logger.h"
+#include "esp_sleep.h"
+
+#define LOG_TAG "SLEEP"
+
+HalWakeupCause HalPower_getWakeupCause() {
+    switch (esp_sleep_get_wakeup_cause()) {
+        case ESP_SLEEP_WAKEUP_TIMER:
+            return HAL_WAKEUP_TIMER;
+        // Classic (EXT0) and new (GPIO) button wakeup
+        case ESP_SLEEP_WAKEUP_EXT0:
+        case ESP_SLEEP_WAKEUP_GPIO:
+            return HAL_WAKEUP_BUTTON;
+        default:
+            return HAL_WAKEUP_RESET;
+    }
+}
+
+void HalPower_deepSleep(uint64_t sleepMicros, uint8_t buttonPin) {
+    // 1. Configure Timer Wakeup
+    esp_sleep_enable_timer_wakeup(sleepMicros);
+
+    // 2. Configure Button Wakeup (Hardware Specific)
+    // We configure the pin as INPUT_PULLUP first
+    pinMode(buttonPin, INPUT_PULLUP);
+
+    #if defined(BOARD_FIREBEETLE_C6)
+        // --- ESP32-C6 / RISC-V Implementation (IDF 5.x / Arduino 3.x) ---
+        // On the C6, ext0_wakeup is deprecated/removed. We use gpio_wakeup.
+        // We must enable the GPIO wake-up logic for the specific pin, requiring LOW level.
+        LOG_DEBUG(LOG_TAG, "Configuring Wakeup for RISC-V (C6)");
+
+        // Ensure the pin direction and pull-up state is maintained during sleep
+        gpio_set_direction((gpio_num_t)buttonPin, GPIO_MODE_INPUT);
+        gpio_pullup_en((gpio_num_t)buttonPin);
+
+        // Enable deep sleep wakeup for the specific pin bitmask
+        esp_deep_sleep_enable_gpio_wakeup(1ULL << buttonPin, ESP_GPIO_WAKEUP_GPIO_LOW);
+
+    #else
+        // --- ESP32 Classic / Xtensa Implementation ---
+        // Uses the traditional EXT0 wakeup source for RTC IOs.
+        LOG_DEBUG(LOG_TAG, "Configuring Wakeup for Classic ESP32");
+        esp_sleep_enable_ext0_wakeup((gpio_num_t)buttonPin, LOW);
+
+    #endif
+
+    Logger_Flush(); // Flush the debug lines above
+    esp_deep_sleep_start();
+}
+
+void HalPower_setButtonHandler(uint8_t buttonPin, void (*handler)()) {
+    if (handler == nullptr) {
+        detachInterrupt(digitalPinToInterrupt(buttonPin));
+        return;
+    }
+    pinMode(buttonPin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(buttonPin), handler, FALLING);
+}
+
+void HalPower_restart() {
+    ESP.restart();
+}
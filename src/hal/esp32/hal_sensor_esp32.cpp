@@ -0,0 +1,111 @@
+// hal_sensor_esp32.cpp
+
+#include "hal/hal_sensor.h"
+#include "config.h"
+#include "system_logger.h"
+#include "dht_decoder.h"
+#include "esp_timer.h"
+#include <atomic>
+
+#define LOG_TAG "DHT"
+
+// One transaction without busy-waiting or disabling interrupts (the Adafruit
+// driver did both for ~25 ms, which starved WiFi and the async web server):
+// 1. HalSensor_startRead() pulls the line low (start signal) and arms a timer.
+// 2. releaseLine() releases the line and timestamps every edge from a GPIO
+//    interrupt (1 us esp_timer clock).
+// 3. finishRead(), DHT_CAPTURE_WINDOW_US later, turns the edges into pulses
+//    and hands them to the decoder (dht_decoder.h).
+// Both timer callbacks run in the esp_timer task.
+
+static constexpr size_t MAX_EDGES = 96;           // 2 response + 80 bit + 1 end edges, plus slack
+static constexpr uint64_t DHT_CAPTURE_WINDOW_US = 8000; // Full frame is ~5 ms
+
+// Start signal: DHT11 needs >= 18 ms low, DHT22 >= 1 ms
+static constexpr uint64_t START_LOW_US = (DHT_TYPE_DEF == DHT11) ? 20000 : 1100;
+
+static esp_timer_handle_t s_releaseTimer = nullptr;
+static esp_timer_handle_t s_finishTimer = nullptr;
+static std::atomic<bool> s_busy(false);
+static HalSensorCallback s_callback = nullptr;
+static void* s_context = nullptr;
+
+// Written by the ISR only while a capture is running
+static uint32_t s_edgeUs[MAX_EDGES];
+static uint8_t s_edgeLevel[MAX_EDGES];
+static volatile size_t s_edgeCount = 0;
+
+static void IRAM_ATTR onEdge_isr() {
+    size_t n = s_edgeCount;
+    if (n >= MAX_EDGES) return;
+    s_edgeUs[n] = (uint32_t)esp_timer_get_time();
+    s_edgeLevel[n] = (uint8_t)digitalRead(DHT_PIN);
+    s_edgeCount = n + 1;
+}
+
+static void releaseLine(void* arg) {
+    s_edgeCount = 0;
+    pinMode(DHT_PIN, INPUT_PULLUP); // Before attaching: pinMode resets the pin's interrupt
+    attachInterrupt(digitalPinToInterrupt(DHT_PIN), onEdge_isr, CHANGE);
+    esp_timer_start_once(s_finishTimer, DHT_CAPTURE_WINDOW_US);
+}
+
+static void finishRead(void* arg) {
+    detachInterrupt(digitalPinToInterrupt(DHT_PIN));
+
+    // Edge i starts pulse i, edge i+1 ends it. The idle high after the last
+    // edge never ends and is not a pulse.
+    DhtPulse pulses[MAX_EDGES];
+    size_t count = 0;
+    for (size_t i = 0; i + 1 < s_edgeCount; i++) {
+        uint32_t us = s_edgeUs[i + 1] - s_edgeUs[i];
+        pulses[count].level = s_edgeLevel[i];
+        pulses[count].durationUs = (us > UINT16_MAX) ? UINT16_MAX : (uint16_t)us;
+        count++;
+    }
+
+    float temperature = NAN;
+    float humidity = NAN;
+    DhtDecodeStatus status = DhtDecoder_decode(pulses, count, DHT_TYPE_DEF, temperature, humidity);
+    if (status != DHT_DECODE_OK) {
+        LOG_DEBUG(LOG_TAG, "Read failed: %s (%u edges)", DhtDecoder_getStatusName(status), (unsigned)s_edgeCount);
+    }
+
+    HalSensorCallback callback = s_callback;
+    void* context = s_context;
+    s_busy = false; // The callback may start the next read
+    callback(status == DHT_DECODE_OK, temperature, humidity, context);
+}
+
+bool HalSensor_begin() {
+    if (s_releaseTimer) return true;
+
+    esp_timer_create_args_t args = {};
+    args.dispatch_method = ESP_TIMER_TASK;
+
+    args.callback = releaseLine;
+    args.name = "dht_release";
+    if (esp_timer_create(&args, &s_releaseTimer) != ESP_OK) return false;
+
+    args.callback = finishRead;
+    args.name = "dht_finish";
+    if (esp_timer_create(&args, &s_finishTimer) != ESP_OK) return false;
+
+    pinMode(DHT_PIN, INPUT_PULLUP); // Idle high
+    return true;
+}
+
+bool HalSensor_startRead(HalSensorCallback callback, void* context) {
+    if (!s_releaseTimer) return false;
+
+    bool expected = false;
+    if (!s_busy.compare_exchange_strong(expected, true)) return false;
+
+    s_callback = callback;
+    s_context = context;
+
+    pinMode(DHT_PIN, OUTPUT);
+    digitalWrite(DHT_PIN, LOW);
+    esp_timer_start_once(s_releaseTimer, START_LOW_US);
+    return true;
+}
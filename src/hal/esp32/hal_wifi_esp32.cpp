@@ -0,0 +1,161 @@
+// hal_wifi_esp32.cpp
+
+#include "hal/hal_wifi.h"
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include "esp_sntp.h"
+
+static HalWifiStationHandler s_stationHandler = nullptr;
+static bool s_eventsRegistered = false;
+static HalSntpHandler s_sntpHandler = nullptr;
+
+// Current connection attempt (written by beginStation, read by the event task)
+static char s_ssid[33];
+static char s_password[65];
+static volatile bool s_linkAttempt = false;   // Joining a cached link, fallback not used yet
+static bool s_staticAddress = false;          // Addresses were configured, not a reused lease
+static volatile bool s_usedLink = false;
+static volatile uint32_t s_beginMs = 0;
+static volatile uint32_t s_connectMs = 0;     // 0 = not connected yet
+
+static IPAddress toIp(const uint8_t* addr) {
+    return IPAddress(addr[0], addr[1], addr[2], addr[3]);
+}
+
+static void fromIp(const IPAddress& ip, uint8_t* addr) {
+    for (int i = 0; i < 4; i++) addr[i] = ip[i];
+}
+
+static void onStationGotIp(arduino_event_id_t event) {
+    if (s_connectMs == 0) {
+        s_connectMs = ::millis() - s_beginMs;
+        if (s_connectMs == 0) s_connectMs = 1;
+    }
+    if (s_linkAttempt) {
+        s_linkAttempt = false;
+        s_usedLink = true;
+        WiFi.setAutoReconnect(true);
+    }
+    HalWifiStationHandler handler = s_stationHandler;
+    if (handler) handler();
+}
+
+/**
+ * @brief The cached BSSID is gone, on another channel, or rejected us:
+ * fall back to a normal scan with DHCP, once.
+ */
+static void onStationDisconnected(arduino_event_id_t event) {
+    if (!s_linkAttempt) return;
+    s_linkAttempt = false;
+    WiFi.setAutoReconnect(true);
+    if (!s_staticAddress) WiFi.config(IPAddress(), IPAddress(), IPAddress()); // The lease may be why
+    WiFi.begin(s_ssid, s_password);
+}
+
+// Replaces the weak default in esp_sntp, which sets the system clock itself
+extern "C" void sntp_sync_time(struct timeval* tv) {
+    HalSntpHandler handler = s_sntpHandler;
+    if (handler) handler((int64_t)tv->tv_sec * 1000000LL + tv->tv_usec);
+    sntp_set_sync_status(SNTP_SYNC_STATUS_COMPLETED);
+}
+
+bool HalWifi_setMode(HalWifiMode mode) {
+    switch (mode) {
+        case HAL_WIFI_STA:    return WiFi.mode(WIFI_STA);
+        case HAL_WIFI_AP:     return WiFi.mode(WIFI_AP);
+        case HAL_WIFI_AP_STA: return WiFi.mode(WIFI_AP_STA);
+        case HAL_WIFI_OFF:    break;
+    }
+    return WiFi.mode(WIFI_OFF);
+}
+
+bool HalWifi_startAP(const char* ssid, const char* password) {
+    return WiFi.softAP(ssid, password);
+}
+
+String HalWifi_getAPAddress() {
+    return WiFi.softAPIP().toString();
+}
+
+void HalWifi_beginStation(const char* ssid, const char* password, const HalWifiLink* link) {
+    if (!s_eventsRegistered) {
+        WiFi.onEvent(onStationGotIp, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+        WiFi.onEvent(onStationDisconnected, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+        s_eventsRegistered = true;
+    }
+
+    snprintf(s_ssid, sizeof(s_ssid), "%s", ssid);
+    snprintf(s_password, sizeof(s_password), "%s", password);
+    s_usedLink = false;
+    s_connectMs = 0;
+    s_beginMs = ::millis();
+
+    // Static addresses skip DHCP; 0.0.0.0 selects DHCP
+    s_staticAddress = link && link->ip[0] != 0 && !link->isLease;
+    if (link && link->ip[0] != 0) {
+        WiFi.config(toIp(link->ip), toIp(link->gateway), toIp(link->subnet), toIp(link->dns));
+    } else {
+        WiFi.config(IPAddress(), IPAddress(), IPAddress());
+    }
+
+    if (link && link->channel != 0) {
+        // The core would retry the same BSSID on its own; the fallback scans instead
+        s_linkAttempt = true;
+        WiFi.setAutoReconnect(false);
+        WiFi.begin(ssid, password, link->channel, link->bssid);
+    } else {
+        s_linkAttempt = false;
+        WiFi.begin(ssid, password);
+    }
+}
+
+bool HalWifi_isConnected() {
+    return WiFi.status() == WL_CONNECTED;
+}
+
+bool HalWifi_getLink(HalWifiLink& out) {
+    if (!HalWifi_isConnected()) return false;
+
+    const uint8_t* bssid = WiFi.BSSID();
+    if (bssid) memcpy(out.bssid, bssid, sizeof(out.bssid));
+    out.channel = bssid ? (uint8_t)WiFi.channel() : 0;
+    fromIp(WiFi.localIP(), out.ip);
+    fromIp(WiFi.gatewayIP(), out.gateway);
+    fromIp(WiFi.subnetMask(), out.subnet);
+    fromIp(WiFi.dnsIP(), out.dns);
+    out.isLease = true; // The caller knows better if it configured them
+    return true;
+}
+
+uint32_t HalWifi_getConnectTimeMs(bool& usedLink) {
+    usedLink = s_usedLink;
+    return s_connectMs;
+}
+
+String HalWifi_getStationAddress() {
+    return WiFi.localIP().toString();
+}
+
+String HalWifi_getMacAddress() {
+    return WiFi.macAddress();
+}
+
+bool HalWifi_startMdns(const char* hostname) {
+    return MDNS.begin(hostname);
+}
+
+void HalWifi_setStationHandler(HalWifiStationHandler handler) {
+    s_stationHandler = handler; // The events are registered by the first beginStation
+}
+
+void HalWifi_startSntp(const char* server, long gmtOffsetSec, int daylightOffsetSec, HalSntpHandler handler) {
+    s_sntpHandler = handler;
+    ::configTime(gmtOffsetSec, daylightOffsetSec, server);
+}
+
+void HalWifi_turnOff() {
+    s_linkAttempt = false; // The disconnect below is not a failed attempt
+    WiFi.softAPdisconnect(true);
+    WiFi.disconnect(true);  // true = turn off WiFi radio
+    WiFi.mode(WIFI_OFF);
+}
@@ -0,0 +1,19 @@
+// hal.h
+
+#pragma once
+
+// --- Hardware Abstraction Layer ---
+// Everything the application needs from the chip or its peripherals goes
+// through these headers. Two implementations exist:
+//   hal/esp32/   Arduino-ESP32 (LittleFS, Preferences, DHT, Wire, WiFi, esp_sleep)
+//   hal/native/  Linux host ([env:native]): a directory as file system,
+//                files as NVS, a simulated DHT and DS3231, a virtual clock
+// platformio.ini selects one of them with build_src_filter.
+
+#include "hal_clock.h"
+#include "hal_fs.h"
+#include "hal_nvs.h"
+#include "hal_sensor.h"
+#include "hal_i2c.h"
+#include "hal_wifi.h"
+#include "hal_power.h"
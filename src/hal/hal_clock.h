@@ -0,0 +1,38 @@
+// hal_clock.h
+
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @brief Microseconds counted by the RTC timer. Unlike millis(), this keeps
+ * running through deep sleep, so it is used for sleep scheduling.
+ */
+uint64_t HalClock_getRtcMicros();
+
+/**
+ * @brief Current wall-clock time (UTC seconds). Meaningless until set.
+ */
+time_t HalClock_getEpoch();
+
+/**
+ * @brief Sets the wall-clock time (UTC seconds).
+ */
+void HalClock_setEpoch(time_t epoch);
+
+/**
+ * @brief Current wall-clock time in UTC microseconds.
+ */
+int64_t HalClock_getEpochMicros();
+
+/**
+ * @brief Steps the wall clock to the given time (UTC microseconds).
+ */
+void HalClock_setEpochMicros(int64_t epochUs);
+
+/**
+ * @brief Corrects the wall clock by deltaUs without a jump: it runs slightly
+ * fast or slow until the difference is absorbed (adjtime()).
+ */
+void HalClock_slew(int64_t deltaUs);
@@ -0,0 +1,23 @@
+// hal_fs.h
+
+#pragma once
+
+#include <FS.h>
+
+/**
+ * @brief Mounts the data partition (LittleFS on the device).
+ * @param formatIfFailed Erase and retry if the partition cannot be mounted.
+ * @return true if mounted.
+ */
+bool HalFs_mount(bool formatIfFailed = false);
+
+/**
+ * @brief Erases and re-creates the file system. Unmounted afterwards.
+ */
+bool HalFs_format();
+
+/**
+ * @brief The mounted file system. On the host this is a directory
+ * (NATIVE_ROOT/littlefs), accessed through the same fs::FS interface.
+ */
+fs::FS& HalFs();
@@ -0,0 +1,29 @@
+// hal_i2c.h
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Register-oriented access to the I2C bus (I2C_SDA_PIN / I2C_SCL_PIN).
+// The host implementation simulates a DS3231 at 0x68.
+
+/**
+ * @brief Starts the bus. Safe to call more than once.
+ */
+bool HalI2C_begin();
+
+/**
+ * @brief Checks whether a device acknowledges its address.
+ */
+bool HalI2C_probe(uint8_t address);
+
+/**
+ * @brief Reads len bytes starting at register reg.
+ */
+bool HalI2C_readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t len);
+
+/**
+ * @brief Writes len bytes starting at register reg.
+ */
+bool HalI2C_writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t len);
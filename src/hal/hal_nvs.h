@@ -0,0 +1,37 @@
+// hal_nvs.h
+
+#pragma once
+
+#include <Arduino.h> // For String
+
+// Small key/value store that survives reboots and firmware updates
+// (the NVS partition on the device). One namespace is open at a time.
+
+/**
+ * @brief Opens a namespace for reading and writing.
+ */
+bool HalNvs_begin(const char* nameSpace);
+
+bool HalNvs_hasKey(const char* key);
+
+/**
+ * @brief Returns the stored string, or defaultValue if the key is missing.
+ */
+String HalNvs_getString(const char* key, const char* defaultValue);
+
+/**
+ * @brief Copies the stored string into out (truncated, always terminated).
+ * @return Length copied, 0 if the key is missing.
+ */
+size_t HalNvs_getString(const char* key, char* out, size_t size);
+
+bool HalNvs_putString(const char* key, const String& value);
+
+/**
+ * @brief Returns the stored number, or defaultValue if the key is missing.
+ */
+uint32_t HalNvs_getUInt(const char* key, uint32_t defaultValue);
+
+bool HalNvs_putUInt(const char* key, uint32_t value);
+
+bool HalNvs_remove(const char* key);
@@ -0,0 +1,32 @@
+// hal_power.h
+
+#pragma once
+
+#include <stdint.h>
+
+enum HalWakeupCause {
+    HAL_WAKEUP_RESET,   // Power-on, reset or first boot
+    HAL_WAKEUP_TIMER,   // Deep sleep timer expired
+    HAL_WAKEUP_BUTTON   // Wake button pressed during deep sleep
+};
+
+HalWakeupCause HalPower_getWakeupCause();
+
+/**
+ * @brief Arms the timer and button wakeups and enters deep sleep.
+ * RAM is lost; RTC_DATA_ATTR variables are kept. Does not return.
+ * On the host the process exits and the next run resumes as a timer wake.
+ */
+void HalPower_deepSleep(uint64_t sleepMicros, uint8_t buttonPin);
+
+/**
+ * @brief Calls handler from an interrupt when the wake button is pressed
+ * while awake (falling edge, the button pulls the pin low). nullptr detaches.
+ * The handler must be IRAM_ATTR and must not block. No-op on the host.
+ */
+void HalPower_setButtonHandler(uint8_t buttonPin, void (*handler)());
+
+/**
+ * @brief Software restart. RTC_DATA_ATTR variables are lost too.
+ */
+void HalPower_restart();
@@ -0,0 +1,25 @@
+// hal_sensor.h
+
+#pragma once
+
+// Raw temperature/humidity sensor (DHT11/DHT22 on the device)
+
+/**
+ * @brief Result of one transaction: both values come from the same read.
+ * Called from the driver's timer task (ESP32) or from within
+ * HalSensor_startRead() (host). Must not block.
+ */
+typedef void (*HalSensorCallback)(bool ok, float temperature, float humidity, void* context);
+
+/**
+ * @brief Configures the sensor pin and driver.
+ */
+bool HalSensor_begin();
+
+/**
+ * @brief Starts one sensor transaction and returns at once. The CPU stays
+ * free and interrupts stay enabled while the sensor answers (~25 ms);
+ * the callback gets both values (NaN on a failed read).
+ * @return false if a transaction is already in progress (no callback).
+ */
+bool HalSensor_startRead(HalSensorCallback callback, void* context);
@@ -0,0 +1,94 @@
+// hal_wifi.h
+
+#pragma once
+
+#include <Arduino.h> // For String
+
+enum HalWifiMode {
+    HAL_WIFI_OFF,
+    HAL_WIFI_STA,
+    HAL_WIFI_AP,
+    HAL_WIFI_AP_STA
+};
+
+bool HalWifi_setMode(HalWifiMode mode);
+
+/**
+ * @brief Starts the soft access point.
+ */
+bool HalWifi_startAP(const char* ssid, const char* password);
+
+/**
+ * @brief IP of the soft AP, or "0.0.0.0" while it has none.
+ */
+String HalWifi_getAPAddress();
+
+// What a station needs to rejoin its network without a scan or DHCP
+struct HalWifiLink {
+    uint8_t bssid[6];
+    uint8_t channel;     // 0 = unknown: scan all channels
+    uint8_t ip[4];       // 0.0.0.0 = DHCP
+    uint8_t gateway[4];
+    uint8_t subnet[4];
+    uint8_t dns[4];
+    bool isLease;        // ip came from DHCP: dropped when falling back to a scan
+};
+
+/**
+ * @brief Starts connecting to a router. Poll HalWifi_isConnected().
+ * With a link, joins that BSSID on that channel without scanning, using
+ * its addresses (if any) instead of DHCP. If that attempt fails, it falls
+ * back once to a full scan by itself.
+ */
+void HalWifi_beginStation(const char* ssid, const char* password, const HalWifiLink* link = nullptr);
+
+bool HalWifi_isConnected();
+
+/**
+ * @brief Link of the current connection.
+ * @return false if not connected.
+ */
+bool HalWifi_getLink(HalWifiLink& out);
+
+/**
+ * @brief Milliseconds from HalWifi_beginStation() to an IP address.
+ * @param usedLink Set if the connection came from the link (no fallback).
+ * @return 0 if the station has not connected yet.
+ */
+uint32_t HalWifi_getConnectTimeMs(bool& usedLink);
+
+/**
+ * @brief IP assigned by the router, or "0.0.0.0".
+ */
+String HalWifi_getStationAddress();
+
+/**
+ * @brief MAC address formatted as "AA:BB:CC:DD:EE:FF".
+ */
+String HalWifi_getMacAddress();
+
+bool HalWifi_startMdns(const char* hostname);
+
+// Called from the WiFi event task once the station has an IP address
+typedef void (*HalWifiStationHandler)();
+
+/**
+ * @brief Registers the station handler (nullptr removes it).
+ */
+void HalWifi_setStationHandler(HalWifiStationHandler handler);
+
+// Called from the network task with the server time of each SNTP reply
+typedef void (*HalSntpHandler)(int64_t serverEpochUs);
+
+/**
+ * @brief Starts SNTP in the background and sets the time zone. Replies are
+ * passed to handler and do NOT set the system clock: the caller decides
+ * whether to slew or step it (see HalClock_slew()). SNTP keeps polling
+ * while the station stays connected.
+ */
+void HalWifi_startSntp(const char* server, long gmtOffsetSec, int daylightOffsetSec, HalSntpHandler handler);
+
+/**
+ * @brief Disconnects and powers down the radio.
+ */
+void HalWifi_turnOff();
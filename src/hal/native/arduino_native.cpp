@@ -0,0 +1,124 @@
+// arduino_native.cpp
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <algorithm>
+#include <cctype>
+
+HostSerial Serial;
+
+// --- String ---
+
+String::String(double v, unsigned int decimals) {
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%.*f", (int)decimals, v);
+    _s = buffer;
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t pos = _s.find(c, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const char* s, unsigned int from) const {
+    size_t pos = _s.find(s, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char c) const {
+    size_t pos = _s.rfind(c);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+bool String::endsWith(const String& suffix) const {
+    return _s.size() >= suffix._s.size() &&
+           _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0;
+}
+
+String String::substring(unsigned int from) const {
+    return from < _s.size() ? String(_s.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    return from < _s.size() ? String(_s.substr(from, to - from)) : String();
+}
+
+void String::replace(const String& find, const String& replacement) {
+    if (find._s.empty()) return;
+    size_t pos = 0;
+    while ((pos = _s.find(find._s, pos)) != std::string::npos) {
+        _s.replace(pos, find._s.size(), replacement._s);
+        pos += replacement._s.size();
+    }
+}
+
+void String::toLowerCase() {
+    for (char& c : _s) c = (char)tolower((unsigned char)c);
+}
+
+void String::toUpperCase() {
+    for (char& c : _s) c = (char)toupper((unsigned char)c);
+}
+
+void String::trim() {
+    size_t first = _s.find_first_not_of(" \t\r\n");
+    size_t last = _s.find_last_not_of(" \t\r\n");
+    _s = (first == std::string::npos) ? std::string() : _s.substr(first, last - first + 1);
+}
+
+String operator+(const String& a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const String& a, const char* b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+String operator+(const char* a, const String& b) {
+    String result(a);
+    result += b;
+    return result;
+}
+
+// --- Print ---
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (n < size && write(buffer[n])) n++;
+    return n;
+}
+
+size_t Print::printf(const char* format, ...) {
+    char small[128];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, (size_t)len);
+
+    std::string large((size_t)len + 1, '\0');
+    va_start(args, format);
+    vsnprintf(&large[0], large.size(), format, args);
+    va_end(args);
+    return write((const uint8_t*)large.data(), (size_t)len);
+}
+
+// --- Serial ---
+
+size_t HostSerial::write(uint8_t c) {
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HostSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HostSerial::flush() {
+    fflush(stdout);
+}
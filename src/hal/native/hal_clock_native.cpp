@@ -0,0 +1,91 @@
+// hal_clock_native.cpp
+
+#include "hal/hal_clock.h"
+#include "native_runtime.h"
+#include <Arduino.h>
+#include <atomic>
+
+// Read by the logger's background task, moved by the main loop
+static std::atomic<uint64_t> s_utcMicros{0};
+static std::atomic<uint64_t> s_rtcMicros{0};
+static std::atomic<int64_t> s_systemOffsetMicros{0};
+static uint64_t s_bootRtcMicros = 0;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Moves the virtual clock forward. Only delay() does this while
+ * awake, so simulated waits take no real time.
+ */
+static void advanceMicros(uint64_t us) {
+    s_utcMicros += us;
+    s_rtcMicros += us;
+}
+
+// --- NATIVE RUNTIME ---
+
+NativeClockState NativeClock_getState() {
+    NativeClockState state;
+    state.utcMicros = s_utcMicros;
+    state.rtcMicros = s_rtcMicros;
+    state.systemOffsetMicros = s_systemOffsetMicros;
+    return state;
+}
+
+void NativeClock_setState(const NativeClockState& state) {
+    s_utcMicros = state.utcMicros;
+    s_rtcMicros = state.rtcMicros;
+    s_systemOffsetMicros = state.systemOffsetMicros;
+}
+
+void NativeClock_startBoot() {
+    s_bootRtcMicros = s_rtcMicros;
+}
+
+// --- HAL ---
+
+uint64_t HalClock_getRtcMicros() {
+    return s_rtcMicros;
+}
+
+time_t HalClock_getEpoch() {
+    // Like the device: counts from 1970 at power-on until the clock is set
+    return (time_t)(((int64_t)s_rtcMicros + s_systemOffsetMicros) / 1000000);
+}
+
+void HalClock_setEpoch(time_t epoch) {
+    s_systemOffsetMicros = (int64_t)epoch * 1000000 - (int64_t)s_rtcMicros;
+}
+
+int64_t HalClock_getEpochMicros() {
+    return (int64_t)s_rtcMicros + s_systemOffsetMicros;
+}
+
+void HalClock_setEpochMicros(int64_t epochUs) {
+    s_systemOffsetMicros = epochUs - (int64_t)s_rtcMicros;
+}
+
+void HalClock_slew(int64_t deltaUs) {
+    s_systemOffsetMicros += deltaUs; // No gradual slew on the host: applied at once
+}
+
+// --- ARDUINO CORE ---
+
+unsigned long millis() {
+    return (unsigned long)((s_rtcMicros - s_bootRtcMicros) / 1000);
+}
+
+unsigned long micros() {
+    return (unsigned long)(s_rtcMicros - s_bootRtcMicros);
+}
+
+void delay(unsigned long ms) {
+    advanceMicros((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    advanceMicros(us);
+}
+
+void yield() {
+}
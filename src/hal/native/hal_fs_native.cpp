@@ -0,0 +1,198 @@
+// hal_fs_native.cpp
+
+#include "hal/hal_fs.h"
+#include "native_runtime.h"
+#include <filesystem>
+#include <system_error>
+#include <vector>
+#include <sys/stat.h>
+
+namespace stdfs = std::filesystem;
+
+namespace fs {
+
+struct FileImpl {
+    FILE* fp = nullptr;
+    std::string path;               // Path as seen by the application
+    std::string hostPath;
+    bool directory = false;
+    std::vector<std::string> entries; // Directory listing for openNextFile()
+    size_t nextEntry = 0;
+    FS* owner = nullptr;
+
+    ~FileImpl() {
+        if (fp) fclose(fp);
+    }
+};
+
+// --- File ---
+
+size_t File::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+    if (!_impl || !_impl->fp) return 0;
+    return fwrite(buffer, 1, size, _impl->fp);
+}
+
+int File::read() {
+    if (!_impl || !_impl->fp) return -1;
+    int c = fgetc(_impl->fp);
+    return c == EOF ? -1 : c;
+}
+
+size_t File::read(uint8_t* buffer, size_t size) {
+    if (!_impl || !_impl->fp) return 0;
+    return fread(buffer, 1, size, _impl->fp);
+}
+
+int File::available() {
+    if (!_impl || !_impl->fp) return 0;
+    return (int)(size() - position());
+}
+
+int File::peek() {
+    if (!_impl || !_impl->fp) return -1;
+    int c = fgetc(_impl->fp);
+    if (c == EOF) return -1;
+    ungetc(c, _impl->fp);
+    return c;
+}
+
+void File::flush() {
+    if (_impl && _impl->fp) fflush(_impl->fp);
+}
+
+bool File::seek(uint32_t pos, SeekMode mode) {
+    if (!_impl || !_impl->fp) return false;
+    int whence = (mode == SeekCur) ? SEEK_CUR : (mode == SeekEnd) ? SEEK_END : SEEK_SET;
+    return fseek(_impl->fp, (long)pos, whence) == 0;
+}
+
+size_t File::position() const {
+    if (!_impl || !_impl->fp) return 0;
+    long pos = ftell(_impl->fp);
+    return pos < 0 ? 0 : (size_t)pos;
+}
+
+size_t File::size() const {
+    if (!_impl || !_impl->fp) return 0;
+    fflush(_impl->fp);
+    struct stat st;
+    return fstat(fileno(_impl->fp), &st) == 0 ? (size_t)st.st_size : 0;
+}
+
+void File::close() {
+    _impl.reset();
+}
+
+File::operator bool() const {
+    return _impl && (_impl->fp || _impl->directory);
+}
+
+const char* File::path() const {
+    return _impl ? _impl->path.c_str() : nullptr;
+}
+
+const char* File::name() const {
+    if (!_impl) return nullptr;
+    size_t slash = _impl->path.rfind('/');
+    return _impl->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+bool File::isDirectory() const {
+    return _impl && _impl->directory;
+}
+
+File File::openNextFile(const char* mode) {
+    if (!_impl || !_impl->directory || _impl->nextEntry >= _impl->entries.size()) return File();
+    std::string child = _impl->path;
+    if (child.empty() || child.back() != '/') child += '/';
+    child += _impl->entries[_impl->nextEntry++];
+    return _impl->owner->open(child.c_str(), mode);
+}
+
+// --- FS ---
+
+std::string FS::hostPath(const char* path) const {
+    std::string p = path ? path : "/";
+    if (p.empty() || p[0] != '/') p = "/" + p;
+    return _root + p;
+}
+
+File FS::open(const char* path, const char* mode, bool create) {
+    std::string host = hostPath(path);
+    std::error_code ec;
+
+    auto impl = std::make_shared<FileImpl>();
+    impl->path = path;
+    impl->hostPath = host;
+    impl->owner = this;
+
+    if (stdfs::is_directory(host, ec)) {
+        impl->directory = true;
+        for (const auto& entry : stdfs::directory_iterator(host, ec)) {
+            impl->entries.push_back(entry.path().filename().string());
+        }
+        return File(impl);
+    }
+
+    std::string m = mode ? mode : "r";
+    if (m[0] == 'r' && !stdfs::exists(host, ec)) return File();
+    if (create) stdfs::create_directories(stdfs::path(host).parent_path(), ec);
+
+    impl->fp = fopen(host.c_str(), (m + "b").c_str());
+    if (!impl->fp) return File();
+    return File(impl);
+}
+
+bool FS::exists(const char* path) {
+    std::error_code ec;
+    return stdfs::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char* path) {
+    std::error_code ec;
+    return stdfs::is_regular_file(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+bool FS::rename(const char* from, const char* to) {
+    std::error_code ec;
+    stdfs::rename(hostPath(from), hostPath(to), ec);
+    return !ec;
+}
+
+bool FS::mkdir(const char* path) {
+    std::error_code ec;
+    return stdfs::create_directory(hostPath(path), ec) || stdfs::is_directory(hostPath(path), ec);
+}
+
+bool FS::rmdir(const char* path) {
+    std::error_code ec;
+    return stdfs::is_directory(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+} // namespace fs
+
+// --- HAL ---
+
+static fs::FS* s_fs = nullptr;
+
+fs::FS& HalFs() {
+    if (!s_fs) s_fs = new fs::FS(NativeRuntime_path("littlefs"));
+    return *s_fs;
+}
+
+bool HalFs_mount(bool formatIfFailed) {
+    (void)formatIfFailed; // A directory cannot be corrupt
+    std::error_code ec;
+    stdfs::create_directories(HalFs().root(), ec);
+    return !ec;
+}
+
+bool HalFs_format() {
+    std::error_code ec;
+    stdfs::remove_all(HalFs().root(), ec);
+    return !ec;
+}
@@ -0,0 +1,117 @@
+// hal_i2c_native.cpp
+
+#include "hal/hal_i2c.h"
+#include "native_runtime.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Simulated DS3231 at 0x68. Its clock runs on the simulated real time plus
+// an offset that is kept, with the OSF flag, in NATIVE_ROOT/ds3231.bin (the
+// coin cell). A new simulation starts with OSF set, as after a battery swap.
+static constexpr uint8_t DS3231_ADDRESS = 0x68;
+static constexpr uint8_t DS3231_REG_STATUS = 0x0F;
+static constexpr uint8_t DS3231_REG_TEMP_MSB = 0x11;
+static constexpr uint8_t DS3231_REG_COUNT = 0x13;
+static constexpr uint8_t DS3231_OSF = 0x80;
+
+struct Ds3231State {
+    int64_t offsetSeconds;  // DS3231 time minus simulated UTC
+    uint8_t status;
+};
+
+static Ds3231State s_ds3231 = { 0, DS3231_OSF };
+static bool s_loaded = false;
+
+static uint8_t toBcd(int value) {
+    return (uint8_t)(((value / 10) << 4) | (value % 10));
+}
+
+static int fromBcd(uint8_t value) {
+    return (value >> 4) * 10 + (value & 0x0F);
+}
+
+static void loadState() {
+    if (s_loaded) return;
+    s_loaded = true;
+    FILE* f = fopen(NativeRuntime_path("ds3231.bin").c_str(), "rb");
+    if (!f) return;
+    if (fread(&s_ds3231, sizeof(s_ds3231), 1, f) != 1) s_ds3231 = { 0, DS3231_OSF };
+    fclose(f);
+}
+
+static void saveState() {
+    FILE* f = fopen(NativeRuntime_path("ds3231.bin").c_str(), "wb");
+    if (!f) return;
+    fwrite(&s_ds3231, sizeof(s_ds3231), 1, f);
+    fclose(f);
+}
+
+static time_t utcSeconds() {
+    return (time_t)(NativeClock_getState().utcMicros / 1000000ULL);
+}
+
+/**
+ * @brief Builds the register file as the chip would present it now.
+ */
+static void readRegisterFile(uint8_t* regs) {
+    memset(regs, 0, DS3231_REG_COUNT);
+
+    time_t now = utcSeconds() + (time_t)s_ds3231.offsetSeconds;
+    struct tm t;
+    gmtime_r(&now, &t);
+    regs[0x00] = toBcd(t.tm_sec);
+    regs[0x01] = toBcd(t.tm_min);
+    regs[0x02] = toBcd(t.tm_hour); // 24-hour mode
+    regs[0x03] = (uint8_t)(t.tm_wday == 0 ? 7 : t.tm_wday);
+    regs[0x04] = toBcd(t.tm_mday);
+    regs[0x05] = toBcd(t.tm_mon + 1) | (t.tm_year >= 200 ? 0x80 : 0x00); // Century bit
+    regs[0x06] = toBcd(t.tm_year % 100);
+
+    regs[DS3231_REG_STATUS] = s_ds3231.status;
+    regs[DS3231_REG_TEMP_MSB] = 25;      // 25.25 C
+    regs[DS3231_REG_TEMP_MSB + 1] = 0x40;
+}
+
+bool HalI2C_begin() {
+    loadState();
+    return true;
+}
+
+bool HalI2C_probe(uint8_t address) {
+    return address == DS3231_ADDRESS;
+}
+
+bool HalI2C_readRegisters(uint8_t address, uint8_t reg, uint8_t* data, size_t len) {
+    if (address != DS3231_ADDRESS || reg + len > DS3231_REG_COUNT) return false;
+    loadState();
+    uint8_t regs[DS3231_REG_COUNT];
+    readRegisterFile(regs);
+    memcpy(data, regs + reg, len);
+    return true;
+}
+
+bool HalI2C_writeRegisters(uint8_t address, uint8_t reg, const uint8_t* data, size_t len) {
+    if (address != DS3231_ADDRESS || reg + len > DS3231_REG_COUNT) return false;
+    loadState();
+    uint8_t regs[DS3231_REG_COUNT];
+    readRegisterFile(regs);
+    memcpy(regs + reg, data, len);
+
+    // Time registers written: re-derive the offset
+    if (reg <= 0x06) {
+        struct tm t = {};
+        t.tm_sec = fromBcd(regs[0x00]);
+        t.tm_min = fromBcd(regs[0x01]);
+        t.tm_hour = fromBcd(regs[0x02] & 0x3F);
+        t.tm_mday = fromBcd(regs[0x04]);
+        t.tm_mon = fromBcd(regs[0x05] & 0x1F) - 1;
+        t.tm_year = fromBcd(regs[0x06]) + ((regs[0x05] & 0x80) ? 200 : 100);
+        s_ds3231.offsetSeconds = (int64_t)timegm(&t) - (int64_t)utcSeconds();
+    }
+    if (reg <= DS3231_REG_STATUS && reg + len > DS3231_REG_STATUS) {
+        s_ds3231.status = regs[DS3231_REG_STATUS];
+    }
+    saveState();
+    return true;
+}
@@ -0,0 +1,68 @@
+// hal_nvs_native.cpp
+
+#include "hal/hal_nvs.h"
+#include "native_runtime.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+// One file per key: NATIVE_ROOT/nvs/<namespace>/<key>
+static std::string s_dir;
+
+static std::string keyPath(const char* key) {
+    return s_dir + "/" + key;
+}
+
+bool HalNvs_begin(const char* nameSpace) {
+    s_dir = NativeRuntime_path("nvs") + "/" + nameSpace;
+    std::error_code ec;
+    std::filesystem::create_directories(s_dir, ec);
+    return !ec;
+}
+
+bool HalNvs_hasKey(const char* key) {
+    std::error_code ec;
+    return !s_dir.empty() && std::filesystem::exists(keyPath(key), ec);
+}
+
+String HalNvs_getString(const char* key, const char* defaultValue) {
+    std::ifstream in(keyPath(key), std::ios::binary);
+    if (!in) return String(defaultValue);
+    std::stringstream content;
+    content << in.rdbuf();
+    return String(content.str());
+}
+
+size_t HalNvs_getString(const char* key, char* out, size_t size) {
+    if (size == 0) return 0;
+    std::ifstream in(keyPath(key), std::ios::binary);
+    in.read(out, size - 1);
+    size_t len = in ? size - 1 : (size_t)in.gcount();
+    out[len] = '\0';
+    return len;
+}
+
+bool HalNvs_putString(const char* key, const String& value) {
+    if (s_dir.empty()) return false;
+    std::ofstream out(keyPath(key), std::ios::binary | std::ios::trunc);
+    out.write(value.c_str(), value.length());
+    return (bool)out;
+}
+
+uint32_t HalNvs_getUInt(const char* key, uint32_t defaultValue) {
+    std::ifstream in(keyPath(key));
+    uint32_t value = 0;
+    return (in >> value) ? value : defaultValue; // Stored as text, like the strings
+}
+
+bool HalNvs_putUInt(const char* key, uint32_t value) {
+    if (s_dir.empty()) return false;
+    std::ofstream out(keyPath(key), std::ios::trunc);
+    out << value;
+    return (bool)out;
+}
+
+bool HalNvs_remove(const char* key) {
+    std::error_code ec;
+    return !s_dir.empty() && std::filesystem::remove(keyPath(key), ec);
+}
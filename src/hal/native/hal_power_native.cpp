@@ -0,0 +1,19 @@
+// hal_power_native.cpp
+
+#include "hal/hal_power.h"
+#include "native_runtime.h"
+
+HalWakeupCause HalPower_getWakeupCause() {
+    return NativeRuntime_getWakeupCause();
+}
+
+void HalPower_deepSleep(uint64_t sleepMicros, uint8_t buttonPin) {
+    NativeRuntime_deepSleep(sleepMicros);
+}
+
+void HalPower_setButtonHandler(uint8_t buttonPin, void (*handler)()) {
+}
+
+void HalPower_restart() {
+    NativeRuntime_restart();
+}
@@ -0,0 +1,29 @@
+// hal_sensor_native.cpp
+
+#include "hal/hal_sensor.h"
+#include "native_runtime.h"
+#include <math.h>
+
+// Simulated DHT: a daily curve over the simulated real time (warmest at
+// 15:00 UTC, humidity moving the other way). --sensor-fail makes reads fail.
+// The transaction completes at once, inside HalSensor_startRead().
+
+static double dayPhase() {
+    double seconds = (double)(NativeClock_getState().utcMicros / 1000000ULL % 86400ULL);
+    return 2.0 * M_PI * (seconds - 9.0 * 3600.0) / 86400.0;
+}
+
+bool HalSensor_begin() {
+    return true;
+}
+
+bool HalSensor_startRead(HalSensorCallback callback, void* context) {
+    if (NativeRuntime_isSensorFailing()) {
+        callback(false, NAN, NAN, context);
+        return true;
+    }
+    float temperature = (float)(21.0 + 3.0 * sin(dayPhase()));
+    float humidity = (float)(45.0 - 8.0 * sin(dayPhase()));
+    callback(true, temperature, humidity, context);
+    return true;
+}
@@ -0,0 +1,89 @@
+// hal_wifi_native.cpp
+
+#include "hal/hal_wifi.h"
+#include "native_runtime.h"
+#include <cstring>
+
+// Simulated radio: the AP comes up at once, a station connects to any
+// configured SSID, and SNTP answers immediately with the simulated real time.
+// Connecting takes NATIVE_SCAN_CONNECT_MS, or NATIVE_LINK_CONNECT_MS when
+// the cached link matches the simulated router.
+static HalWifiMode s_mode = HAL_WIFI_OFF;
+static bool s_apStarted = false;
+static bool s_connected = false;
+static bool s_usedLink = false;
+static uint32_t s_connectMs = 0;
+static HalWifiStationHandler s_stationHandler = nullptr;
+
+static const HalWifiLink ROUTER = {
+    { 0x24, 0x0A, 0xC4, 0xAA, 0xBB, 0xCC }, 6,
+    { 192, 168, 1, 50 }, { 192, 168, 1, 1 }, { 255, 255, 255, 0 }, { 192, 168, 1, 1 }, true
+};
+constexpr uint32_t NATIVE_SCAN_CONNECT_MS = 1500;
+constexpr uint32_t NATIVE_LINK_CONNECT_MS = 300;
+
+bool HalWifi_setMode(HalWifiMode mode) {
+    s_mode = mode;
+    if (mode == HAL_WIFI_OFF || mode == HAL_WIFI_STA) s_apStarted = false;
+    if (mode == HAL_WIFI_OFF || mode == HAL_WIFI_AP) s_connected = false;
+    return true;
+}
+
+bool HalWifi_startAP(const char* ssid, const char* password) {
+    s_apStarted = (s_mode == HAL_WIFI_AP || s_mode == HAL_WIFI_AP_STA);
+    return s_apStarted;
+}
+
+String HalWifi_getAPAddress() {
+    return s_apStarted ? "192.168.4.1" : "0.0.0.0";
+}
+
+void HalWifi_beginStation(const char* ssid, const char* password, const HalWifiLink* link) {
+    s_connected = (s_mode == HAL_WIFI_STA || s_mode == HAL_WIFI_AP_STA) && ssid && ssid[0];
+    if (!s_connected) return;
+
+    s_usedLink = link && link->channel == ROUTER.channel && memcmp(link->bssid, ROUTER.bssid, 6) == 0;
+    s_connectMs = s_usedLink ? NATIVE_LINK_CONNECT_MS : NATIVE_SCAN_CONNECT_MS;
+    delay(s_connectMs);
+    if (s_stationHandler) s_stationHandler();
+}
+
+bool HalWifi_isConnected() {
+    return s_connected;
+}
+
+bool HalWifi_getLink(HalWifiLink& out) {
+    if (!s_connected) return false;
+    out = ROUTER;
+    return true;
+}
+
+uint32_t HalWifi_getConnectTimeMs(bool& usedLink) {
+    usedLink = s_usedLink;
+    return s_connected ? s_connectMs : 0;
+}
+
+String HalWifi_getStationAddress() {
+    return s_connected ? "192.168.1.50" : "0.0.0.0";
+}
+
+String HalWifi_getMacAddress() {
+    return "24:0A:C4:12:34:56";
+}
+
+bool HalWifi_startMdns(const char* hostname) {
+    return s_connected;
+}
+
+void HalWifi_setStationHandler(HalWifiStationHandler handler) {
+    s_stationHandler = handler;
+}
+
+void HalWifi_startSntp(const char* server, long gmtOffsetSec, int daylightOffsetSec, HalSntpHandler handler) {
+    if (!s_connected || !handler) return;
+    handler((int64_t)NativeClock_getState().utcMicros);
+}
+
+void HalWifi_turnOff() {
+    HalWifi_setMode(HAL_WIFI_OFF);
+}
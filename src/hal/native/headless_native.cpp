@@ -0,0 +1,54 @@
+// headless_native.cpp
+//
+// The host build has no display and no network stack: web_server.cpp and
+// oled_display.cpp are left out and replaced by these stand-ins, so the
+// interactive state only runs its timers (live samples, network view) until
+// the inactivity timeout, in virtual time, and the device goes back to sleep.
+
+#include "web_server.h"
+#include "oled_display.h"
+
+// --- Web Server ---
+
+bool activateWebServer() {
+    return false;
+}
+
+void handleWebServerClients() {
+}
+
+bool isWebServerActive() {
+    return false;
+}
+
+bool stopWebServerIfIdle() {
+    return true;
+}
+
+unsigned long getWebServerIdleRemainingMs() {
+    return 0;
+}
+
+void resetWebServerIdleTimer() {
+}
+
+void publishLiveSample(const LiveSample&) {
+}
+
+// --- OLED Display ---
+
+bool OLEDDisplay_init() {
+    return false;
+}
+
+void OLEDDisplay_setMode(DisplayMode mode) {
+}
+
+void OLEDDisplay_refresh() {
+}
+
+void OLEDDisplay_showMessage(const char* msg, int progress) {
+}
+
+void OLEDDisplay_turnOff() {
+}
@@ -0,0 +1,11 @@
+// esp_system.h (native)
+
+#pragma once
+
+// RTC slow memory survives deep sleep on the device. On the host all
+// RTC_DATA_ATTR variables are placed in one section, which the native runtime
+// saves to a file when "sleeping" and restores on the next run (see
+// hal/native/native_runtime.cpp).
+#define RTC_DATA_ATTR __attribute__((section("rtc_data")))
+#define RTC_NOINIT_ATTR RTC_DATA_ATTR
+#define IRAM_ATTR
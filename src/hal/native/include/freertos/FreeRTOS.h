@@ -0,0 +1,20 @@
+// freertos/FreeRTOS.h (native)
+
+#pragma once
+
+#include <stdint.h>
+
+// FreeRTOS types on top of std::thread / std::timed_mutex. Ticks are
+// milliseconds (configTICK_RATE_HZ = 1000).
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
@@ -0,0 +1,67 @@
+// freertos/queue.h (native)
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+void delay(unsigned long ms);
+
+// Fixed-size item queue on top of std::mutex. A receive that finds the queue
+// empty waits on the virtual clock (like delay()), so a task blocking until
+// its next deadline moves simulated time forward instead of sleeping.
+
+struct NativeQueue {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::vector<uint8_t>> items;
+    UBaseType_t length;
+    UBaseType_t itemSize;
+};
+
+typedef NativeQueue* QueueHandle_t;
+
+#define portYIELD_FROM_ISR(woken) (void)(woken)
+
+inline QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+    NativeQueue* queue = new NativeQueue();
+    queue->length = length;
+    queue->itemSize = itemSize;
+    return queue;
+}
+
+inline BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(item);
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        if (queue->items.size() >= queue->length) return pdFALSE; // Full: no blocking send on the host
+        queue->items.emplace_back(bytes, bytes + queue->itemSize);
+    }
+    queue->ready.notify_one();
+    return pdTRUE;
+}
+
+inline BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* woken) {
+    if (woken) *woken = pdFALSE;
+    return xQueueSend(queue, item, 0);
+}
+
+inline BaseType_t xQueueReceive(QueueHandle_t queue, void* buffer, TickType_t ticks) {
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    if (queue->items.empty() && ticks == portMAX_DELAY) {
+        queue->ready.wait(lock, [queue] { return !queue->items.empty(); });
+    } else if (queue->items.empty() && ticks > 0) {
+        lock.unlock();
+        delay(ticks);
+        lock.lock();
+    }
+    if (queue->items.empty()) return pdFALSE;
+
+    memcpy(buffer, queue->items.front().data(), queue->itemSize);
+    queue->items.pop_front();
+    return pdTRUE;
+}
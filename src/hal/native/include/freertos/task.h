@@ -0,0 +1,46 @@
+// freertos/task.h (native)
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <chrono>
+#include <thread>
+
+typedef void (*TaskFunction_t)(void*);
+typedef std::thread* TaskHandle_t;
+
+// Tasks are detached threads; priorities and stack sizes are ignored.
+inline BaseType_t xTaskCreate(TaskFunction_t function, const char*, uint32_t, void* param,
+                              UBaseType_t, TaskHandle_t* handle) {
+    std::thread* thread = new std::thread(function, param);
+    thread->detach();
+    if (handle) *handle = thread;
+    return pdPASS;
+}
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t function, const char* name, uint32_t stack,
+                                          void* param, UBaseType_t priority, TaskHandle_t* handle,
+                                          BaseType_t) {
+    return xTaskCreate(function, name, stack, param, priority, handle);
+}
+
+// Threads cannot be killed: a stopped task must return on its own (the
+// process ends at the next deep sleep anyway)
+inline void vTaskDelete(TaskHandle_t) {
+}
+
+// Real time: background tasks must not move the virtual clock
+inline void vTaskDelay(TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+// Any per-thread address works as a handle
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+    static thread_local std::thread* self;
+    return reinterpret_cast<TaskHandle_t>(&self);
+}
+
+inline char* pcTaskGetName(TaskHandle_t) {
+    static char name[] = "host";
+    return name;
+}
@@ -0,0 +1,18 @@
+// native_main.cpp
+
+#include "native_runtime.h"
+
+// Arduino sketch entry points (main.cpp)
+void setup();
+void loop();
+
+// Unit tests (pio test -e native) bring their own main()
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+    NativeRuntime_begin(argc, argv);
+    setup();
+    for (;;) {
+        loop(); // Left through HalPower_deepSleep() / HalPower_restart()
+    }
+}
+#endif
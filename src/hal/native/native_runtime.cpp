@@ -0,0 +1,189 @@
+// native_runtime.cpp
+
+#include "native_runtime.h"
+#include <Arduino.h>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+#include <unistd.h>
+
+// Bounds of the RTC_DATA_ATTR section, provided by the linker
+extern "C" uint8_t __start_rtc_data[];
+extern "C" uint8_t __stop_rtc_data[];
+
+static constexpr uint32_t RTC_SNAPSHOT_MAGIC = 0x43545253; // "SRTC"
+static constexpr uint64_t BUTTON_PRESS_AFTER_US = 1000000;  // --button wakes 1 s into the sleep
+
+// Header of rtc.bin, followed by the RTC_DATA_ATTR section
+struct RtcSnapshotHeader {
+    uint32_t magic;
+    uint32_t sectionSize;   // A different build invalidates the snapshot
+    uint64_t rtcMicros;
+    int64_t systemOffsetMicros;
+    uint64_t sleepMicros;   // Requested sleep time
+};
+
+static std::string s_root;
+static std::vector<std::string> s_args;
+static HalWakeupCause s_wakeupCause = HAL_WAKEUP_RESET;
+static bool s_buttonWake = false;
+static bool s_sensorFail = false;
+static unsigned long s_cycles = 1;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static size_t rtcSectionSize() {
+    return (size_t)(__stop_rtc_data - __start_rtc_data);
+}
+
+static uint64_t hostUtcMicros() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+/**
+ * @brief Loads the simulated real time, starting from the host clock on first use.
+ */
+static uint64_t loadWorldTime() {
+    uint64_t utcMicros = 0;
+    FILE* f = fopen(NativeRuntime_path("world.bin").c_str(), "rb");
+    if (f) {
+        if (fread(&utcMicros, sizeof(utcMicros), 1, f) != 1) utcMicros = 0;
+        fclose(f);
+    }
+    return utcMicros ? utcMicros : hostUtcMicros();
+}
+
+static void saveWorldTime() {
+    uint64_t utcMicros = NativeClock_getState().utcMicros;
+    FILE* f = fopen(NativeRuntime_path("world.bin").c_str(), "wb");
+    if (!f) return;
+    fwrite(&utcMicros, sizeof(utcMicros), 1, f);
+    fclose(f);
+}
+
+/**
+ * @brief Restores RTC memory and the device clocks from the last deep sleep.
+ * @return false if there is none (power-on reset).
+ */
+static bool restoreRtcSnapshot(RtcSnapshotHeader& header) {
+    FILE* f = fopen(NativeRuntime_path("rtc.bin").c_str(), "rb");
+    if (!f) return false;
+
+    bool ok = fread(&header, sizeof(header), 1, f) == 1 &&
+              header.magic == RTC_SNAPSHOT_MAGIC &&
+              header.sectionSize == rtcSectionSize() &&
+              fread(__start_rtc_data, 1, header.sectionSize, f) == header.sectionSize;
+    fclose(f);
+    return ok;
+}
+
+static void saveRtcSnapshot(uint64_t sleepMicros) {
+    NativeClockState clock = NativeClock_getState();
+    RtcSnapshotHeader header;
+    header.magic = RTC_SNAPSHOT_MAGIC;
+    header.sectionSize = (uint32_t)rtcSectionSize();
+    header.rtcMicros = clock.rtcMicros;
+    header.systemOffsetMicros = clock.systemOffsetMicros;
+    header.sleepMicros = sleepMicros;
+
+    FILE* f = fopen(NativeRuntime_path("rtc.bin").c_str(), "wb");
+    if (!f) return;
+    fwrite(&header, sizeof(header), 1, f);
+    fwrite(__start_rtc_data, 1, header.sectionSize, f);
+    fclose(f);
+}
+
+/**
+ * @brief Ends the run, or starts the next one when more --cycles are left.
+ */
+[[noreturn]] static void endRun() {
+    fflush(stdout);
+    if (s_cycles > 1) {
+        std::string cycles = std::to_string(s_cycles - 1);
+        std::vector<char*> argv;
+        argv.push_back(const_cast<char*>(s_args[0].c_str()));
+        argv.push_back(const_cast<char*>("--cycles"));
+        argv.push_back(const_cast<char*>(cycles.c_str()));
+        if (s_sensorFail) argv.push_back(const_cast<char*>("--sensor-fail"));
+        argv.push_back(nullptr);
+        execv("/proc/self/exe", argv.data());
+        perror("execv");
+    }
+    // Skip static destructors: the logger task may still be running
+    _exit(0);
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void NativeRuntime_begin(int argc, char** argv) {
+    bool reset = false;
+    s_args.assign(argv, argv + argc);
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--reset") {
+            reset = true;
+        } else if (arg == "--button") {
+            s_buttonWake = true;
+        } else if (arg == "--sensor-fail") {
+            s_sensorFail = true;
+        } else if (arg == "--cycles" && i + 1 < argc) {
+            s_cycles = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+        }
+    }
+
+    // 1. Simulation directory
+    const char* root = getenv("NATIVE_ROOT");
+    s_root = root ? root : (std::filesystem::temp_directory_path() / "esp32_datalogger").string();
+    std::filesystem::create_directories(s_root);
+    setenv("TZ", "UTC0", 1); // Same as the device before configTime()
+    tzset();
+
+    // 2. Clocks, and RTC memory if the last run went to deep sleep
+    NativeClockState clock = {};
+    clock.utcMicros = loadWorldTime();
+
+    RtcSnapshotHeader header;
+    if (reset) {
+        std::filesystem::remove(NativeRuntime_path("rtc.bin"));
+    } else if (restoreRtcSnapshot(header)) {
+        uint64_t slept = header.sleepMicros;
+        s_wakeupCause = HAL_WAKEUP_TIMER;
+        if (s_buttonWake && slept > BUTTON_PRESS_AFTER_US) {
+            slept = BUTTON_PRESS_AFTER_US;
+            s_wakeupCause = HAL_WAKEUP_BUTTON;
+        }
+        clock.rtcMicros = header.rtcMicros + slept;
+        clock.systemOffsetMicros = header.systemOffsetMicros;
+        clock.utcMicros += slept;
+    }
+    NativeClock_setState(clock);
+    NativeClock_startBoot();
+}
+
+std::string NativeRuntime_path(const char* name) {
+    return s_root + "/" + name;
+}
+
+HalWakeupCause NativeRuntime_getWakeupCause() {
+    return s_wakeupCause;
+}
+
+bool NativeRuntime_isSensorFailing() {
+    return s_sensorFail;
+}
+
+void NativeRuntime_deepSleep(uint64_t sleepMicros) {
+    saveRtcSnapshot(sleepMicros);
+    saveWorldTime();
+    endRun();
+}
+
+void NativeRuntime_restart() {
+    std::filesystem::remove(NativeRuntime_path("rtc.bin"));
+    saveWorldTime();
+    s_cycles = 1;
+    endRun();
+}
@@ -0,0 +1,63 @@
+// native_runtime.h
+
+#pragma once
+
+// Process model of the host build ([env:native]).
+// One run of the program is one wake cycle of the device:
+//   setup() + loop() until deep sleep, which saves the RTC_DATA_ATTR section
+//   and the clocks to NATIVE_ROOT/rtc.bin and ends the process.
+// The next run restores them and wakes up as if the timer had fired, with
+// the virtual clock moved forward by the sleep time.
+//
+// Command line:
+//   --reset        Power-on reset: RTC memory and the system clock are lost
+//   --button       Wake by button (1 s into the sleep) instead of the timer
+//   --cycles N     Run N wake cycles back to back (re-executes itself)
+//   --sensor-fail  Every sensor read fails (NaN)
+// NATIVE_ROOT selects the simulation directory (default <tmp>/esp32_datalogger);
+// it holds littlefs/, nvs/, ds3231.bin, world.bin and rtc.bin.
+
+#include <stdint.h>
+#include <string>
+#include "hal/hal_power.h"
+
+/**
+ * @brief Parses the command line and restores the previous wake cycle.
+ * Call before setup().
+ */
+void NativeRuntime_begin(int argc, char** argv);
+
+/**
+ * @brief Absolute host path of a file in the simulation directory.
+ */
+std::string NativeRuntime_path(const char* name);
+
+HalWakeupCause NativeRuntime_getWakeupCause();
+
+bool NativeRuntime_isSensorFailing();
+
+/**
+ * @brief Saves RTC memory and the clocks, then ends this run.
+ */
+[[noreturn]] void NativeRuntime_deepSleep(uint64_t sleepMicros);
+
+/**
+ * @brief Ends this run without saving RTC memory (next run is a reset).
+ */
+[[noreturn]] void NativeRuntime_restart();
+
+// --- Virtual Clock (hal_clock_native.cpp) ---
+
+struct NativeClockState {
+    uint64_t utcMicros;          // Simulated real time (never reset)
+    uint64_t rtcMicros;          // RTC timer of the device (0 at power-on)
+    int64_t systemOffsetMicros;  // System clock minus RTC timer (0 = not set)
+};
+
+NativeClockState NativeClock_getState();
+void NativeClock_setState(const NativeClockState& state);
+
+/**
+ * @brief Marks the start of a wake cycle: millis() restarts at 0.
+ */
+void NativeClock_startBoot();
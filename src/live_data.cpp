@@ -0,0 +1,71 @@
+// live_data.cpp
+
+#include "live_data.h"
+#include "config.h"
+#include "dht_sensor.h"
+#include "subsystem.h"
+#include "trace.h"
+#include "scheduler.h"
+
+// Ring of the latest samples. RAM only: live mode ends with deep sleep.
+static LiveSample s_ring[LIVE_RING_SIZE];
+static uint32_t s_lastId = 0;         // Id of the newest sample, 0 = none yet
+
+// Read handed over from the sensor driver's task (see EVENT_SENSOR_READY)
+static bool s_readyPending = false;
+static float s_readyTemperature = NAN;
+static float s_readyHumidity = NAN;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void onSensorRead(bool ok, float temperature, float humidity, void* context) {
+    s_readyTemperature = temperature;
+    s_readyHumidity = humidity;
+    s_readyPending = true;
+    Scheduler_post(EVENT_SENSOR_READY); // The queue orders the writes above before the event
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+bool LiveData_requestSample() {
+    if (!Subsystem_require(SUBSYSTEM_SENSOR)) return false;
+    return DHTSensor_startRead(onSensorRead, nullptr);
+}
+
+bool LiveData_completeSample(LiveSample& out) {
+    if (!s_readyPending) return false;
+    s_readyPending = false;
+
+    LiveSample& sample = s_ring[s_lastId % LIVE_RING_SIZE];
+    sample.id = ++s_lastId;
+    sample.uptimeMs = millis();
+    sample.temperature = s_readyTemperature;
+    sample.humidity = s_readyHumidity;
+    out = sample;
+    return true;
+}
+
+size_t LiveData_getSince(uint32_t lastId, LiveSample* out, size_t maxCount) {
+    uint32_t oldest = (s_lastId > LIVE_RING_SIZE) ? s_lastId - LIVE_RING_SIZE + 1 : 1;
+    uint32_t first = (lastId + 1 > oldest) ? lastId + 1 : oldest;
+    if (s_lastId >= maxCount && first + maxCount <= s_lastId) {
+        first = s_lastId - maxCount + 1; // Only the newest maxCount
+    }
+
+    size_t count = 0;
+    for (uint32_t id = first; id <= s_lastId && count < maxCount; id++) {
+        out[count++] = s_ring[(id - 1) % LIVE_RING_SIZE];
+    }
+    return count;
+}
+
+size_t LiveData_formatJson(const LiveSample& sample, char* out, size_t size) {
+    if (size == 0) return 0;
+    int len = snprintf(out, size, "{\"id\":%lu,\"uptimeMs\":%lu,\"temperature\":",
+                       (unsigned long)sample.id, (unsigned long)sample.uptimeMs);
+    len += snprintf(out + len, size > (size_t)len ? size - len : 0,
+                    isnan(sample.temperature) ? "null" : "%.1f", sample.temperature);
+    len += snprintf(out + len, size > (size_t)len ? size - len : 0,
+                    isnan(sample.humidity) ? ",\"humidity\":null}" : ",\"humidity\":%.1f}", sample.humidity);
+    return ((size_t)len < size) ? (size_t)len : size - 1;
+}
@@ -0,0 +1,48 @@
+// live_data.h
+
+#pragma once
+
+#include <Arduino.h>
+
+// --- Live Readings (interactive mode) ---
+// While the device is awake for the user, the DHT is sampled every
+// LIVE_SAMPLE_INTERVAL_MS (paced by the app controller's scheduler) into a
+// small RAM ring. New samples are pushed to
+// browsers over Server-Sent Events (GET /events, see web_server.cpp); the
+// ring lets a (re)connecting browser catch up from its Last-Event-ID.
+// Live samples are not written to the datalog.
+
+struct LiveSample {
+    uint32_t id;          // 1, 2, 3... (SSE event id, 0 = none)
+    uint32_t uptimeMs;    // millis() at the read
+    float temperature;    // NaN if the read failed
+    float humidity;
+};
+
+/**
+ * @brief Starts a sensor read and returns at once. EVENT_SENSOR_READY is
+ * posted to the scheduler when the values are in; then call
+ * LiveData_completeSample(). The caller paces the reads (every
+ * LIVE_SAMPLE_INTERVAL_MS).
+ * @return false if no read could be started (sample skipped).
+ */
+bool LiveData_requestSample();
+
+/**
+ * @brief Stores the finished read in the ring.
+ * @return true if a new sample was stored in out.
+ */
+bool LiveData_completeSample(LiveSample& out);
+
+/**
+ * @brief Copies the samples newer than lastId (oldest first), at most maxCount.
+ * Samples already overwritten in the ring are skipped.
+ * @return Number of samples copied.
+ */
+size_t LiveData_getSince(uint32_t lastId, LiveSample* out, size_t maxCount);
+
+/**
+ * @brief Formats a sample as JSON: {"id":..,"uptimeMs":..,"temperature":..,"humidity":..}
+ * @return Length written (truncated to size - 1).
+ */
+size_t LiveData_formatJson(const LiveSample& sample, char* out, size_t size);
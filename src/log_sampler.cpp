@@ -0,0 +1,122 @@
+// log_sampler.cpp
+
+#include "log_sampler.h"
+#include "config.h"
+#include "system_logger.h"
+#include "data_logger.h"
+#include "sensor_acquisition.h"
+#include "sleep_manager.h"
+#include "time_manager.h"
+#include "subsystem.h"
+#include "trace.h"
+#include "hal/hal_clock.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#define LOG_TAG "SAMPLER"
+
+extern uint64_t time_last_logged_ms; // main.cpp (RTC memory)
+
+static TaskHandle_t s_task = nullptr;
+static SemaphoreHandle_t s_mutex = nullptr; // Held for the duration of one background sample
+static bool s_running = false;
+RTC_DATA_ATTR static bool s_lastSampleDegraded = false; // Next sample takes the full burst
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static uint64_t nowMs() {
+    return HalClock_getRtcMicros() / 1000ULL;
+}
+
+static void samplerTask(void* param) {
+    uint64_t retryAtMs = 0; // After a failed sample
+
+    for (;;) {
+        uint64_t dueMs = time_last_logged_ms + LOG_INTERVAL_SECONDS * 1000ULL;
+        if (dueMs < retryAtMs) dueMs = retryAtMs;
+        uint64_t now = nowMs();
+        if (now < dueMs) {
+            vTaskDelay(pdMS_TO_TICKS((uint32_t)(dueMs - now)));
+            continue; // Re-check: the stop may have come in meanwhile
+        }
+
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+        if (!s_running) {
+            xSemaphoreGive(s_mutex);
+            break;
+        }
+
+        LOG_INFO(LOG_TAG, "Log interval reached while awake. Taking the scheduled sample.");
+        if (LogSampler_logSample(true)) {
+            DataLogger_flush(); // Awake anyway: make it visible to the web UI now (no-op if skipped)
+        } else {
+            retryAtMs = nowMs() + SAMPLER_RETRY_MS; // Do not spin on a broken sensor
+        }
+        xSemaphoreGive(s_mutex);
+    }
+    vTaskDelete(nullptr);
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+bool LogSampler_logSample(bool interactive) {
+    TRACE_SCOPE("sampler.sample");
+    uint64_t readMs = nowMs();
+
+    if (!Subsystem_require(SUBSYSTEM_SENSOR)) {
+        LOG_ERROR(LOG_TAG, "DHT Sensor failed!");
+    }
+
+    // 1. A timer wake stays short; the burst costs seconds awake
+    uint8_t reads = (interactive || s_lastSampleDegraded) ? SENSOR_BURST_SIZE : SENSOR_TIMER_WAKE_READS;
+    AcquiredSample sample;
+    bool acquired = SensorAcquisition_acquire(sample, reads);
+    s_lastSampleDegraded = (sample.quality != SAMPLE_QUALITY_GOOD);
+    if (!acquired) {
+        return false; // Nothing usable to log
+    }
+
+    // 2. The record is stamped now: this is where the wake should put it. Retries,
+    // an extra burst and a network sync starting up are not part of a typical wake.
+    recordScheduledSample(nowMs(), sample.retries == 0 && reads == SENSOR_TIMER_WAKE_READS &&
+                                   !TimeManager_isNetworkSyncActive());
+
+    bool degraded = (sample.quality != SAMPLE_QUALITY_GOOD);
+    DatalogWriteResult result = DataLogger_logSensorData(sample.temperature, sample.humidity, degraded);
+    if (result == DATALOG_WRITE_FAILED) {
+        LOG_ERROR(LOG_TAG, "Failed to write data to file!");
+        return false;
+    }
+
+    if (result == DATALOG_WRITE_LOGGED) {
+        LOG_INFO(LOG_TAG, "Logged successfully. T: %.1f C, H: %.1f %% (%s)", sample.temperature, sample.humidity,
+                 SensorAcquisition_getQualityName(sample.quality));
+    }
+    time_last_logged_ms = readMs; // The schedule counts samples taken, written or not
+    return true;
+}
+
+void LogSampler_startBackground() {
+    if (s_task) return;
+    if (!s_mutex) s_mutex = xSemaphoreCreateMutex();
+    s_running = true;
+
+#if defined(portNUM_PROCESSORS) && portNUM_PROCESSORS > 1
+    // Classic: WiFi and lwIP run on core 0, the DHT read must not disturb them
+    xTaskCreatePinnedToCore(samplerTask, "log_sampler", 6144, nullptr, 1, &s_task, SAMPLER_TASK_CORE);
+#else
+    xTaskCreate(samplerTask, "log_sampler", 6144, nullptr, 1, &s_task);
+#endif
+}
+
+void LogSampler_stopBackground() {
+    if (!s_task) return;
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    s_running = false;
+    // Not sampling (we hold the mutex): safe to delete while it sleeps or waits
+    vTaskDelete(s_task);
+    s_task = nullptr;
+    xSemaphoreGive(s_mutex);
+}
@@ -0,0 +1,34 @@
+// log_sampler.h
+
+#pragma once
+
+#include <Arduino.h>
+
+// --- Scheduled Logging ---
+// One sample per LOG_INTERVAL_SECONDS, counted from time_last_logged_ms
+// (RTC memory); the datalogger writes it if it passes the deadband (see
+// DATALOG_DEADBAND_ENABLED). Normally STATE_LOGGING takes it once per wake. While the
+// device stays awake for the user, a background task keeps the schedule, so
+// a long web session does not leave a gap in the time series.
+
+/**
+ * @brief Acquires one sample (see sensor_acquisition.h) and logs it. On success time_last_logged_ms
+ * moves to the time of the read, which the next sleep is scheduled from.
+ * @param interactive The user is waiting anyway: take the SENSOR_BURST_SIZE burst. Otherwise
+ * SENSOR_TIMER_WAKE_READS, or the burst if the previous sample was degraded.
+ * @return true if the sample was logged (or buffered) or skipped by the deadband.
+ */
+bool LogSampler_logSample(bool interactive);
+
+/**
+ * @brief Starts the background task (interactive mode). It sleeps until the
+ * next sample is due; on dual-core chips it runs on SAMPLER_TASK_CORE, away
+ * from the WiFi/lwIP core.
+ */
+void LogSampler_startBackground();
+
+/**
+ * @brief Stops the background task. Waits for a sample in progress, so no
+ * sample is written after this returns (call before deep sleep).
+ */
+void LogSampler_stopBackground();
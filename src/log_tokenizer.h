@@ -0,0 +1,106 @@
+// log_tokenizer.h
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+// --- Tokenized Log Format ---
+// With SYSTEM_LOG_TOKENIZED, a LOG_* call stores a small binary frame
+// instead of formatting text on the device:
+//   [u8 length of the rest][u32 token][u32 millis][u8 level][args...]
+// The token is the flash address of a per-call-site string "TAG\x1fformat".
+// tools/decode_log.py reads that string back from the firmware ELF and uses
+// the format to decode the arguments:
+//   integers (and enums, bool) -> zigzag varint of the value as int64
+//   float, double              -> 4-byte IEEE float
+//   const char*                -> u8 length + bytes (truncated)
+//   other pointers             -> zigzag varint of the address
+// Frames are little-endian and byte-aligned.
+
+enum class LogLevel;
+
+// Writes one frame to the log buffer (see system_logger.cpp)
+void Logger_LogTokenized(LogLevel level, const char* token, const uint8_t* args, size_t argsLen);
+
+namespace LogTokenizer {
+
+constexpr size_t MAX_ARGS_SIZE = 64;  // Longer argument lists are truncated
+constexpr size_t MAX_STRING_ARG = 32; // Longer strings are truncated
+
+// Token 0 is reserved for "N entries dropped (buffer full)" with one integer argument
+constexpr uint32_t TOKEN_DROPPED = 0;
+
+struct ArgWriter {
+    uint8_t buffer[MAX_ARGS_SIZE];
+    size_t len = 0;
+
+    void putByte(uint8_t b) {
+        if (len < MAX_ARGS_SIZE) buffer[len++] = b;
+    }
+
+    void putVarint(uint64_t v) {
+        while (v >= 0x80) {
+            putByte((uint8_t)(v | 0x80));
+            v >>= 7;
+        }
+        putByte((uint8_t)v);
+    }
+
+    void putSigned(int64_t v) {
+        putVarint(((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+    }
+};
+
+template <typename T>
+inline typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+put(ArgWriter& w, T value) {
+    w.putSigned((int64_t)value);
+}
+
+inline void put(ArgWriter& w, double value) {
+    float f = (float)value;
+    uint8_t bytes[sizeof(f)];
+    memcpy(bytes, &f, sizeof(f));
+    for (uint8_t b : bytes) w.putByte(b);
+}
+
+inline void put(ArgWriter& w, const char* value) {
+    size_t len = value ? strnlen(value, MAX_STRING_ARG) : 0;
+    w.putByte((uint8_t)len);
+    for (size_t i = 0; i < len; i++) w.putByte((uint8_t)value[i]);
+}
+
+inline void put(ArgWriter& w, const void* value) {
+    w.putSigned((int64_t)(intptr_t)value);
+}
+
+inline void putAll(ArgWriter&) {}
+
+template <typename T, typename... Rest>
+inline void putAll(ArgWriter& w, T value, Rest... rest) {
+    put(w, value);
+    putAll(w, rest...);
+}
+
+/**
+ * @brief Serializes the arguments by C++ type and hands the frame to the logger.
+ * No formatting happens on the device.
+ */
+template <typename... Args>
+inline void log(LogLevel level, const char* token, Args... args) {
+    ArgWriter w;
+    putAll(w, args...);
+    Logger_LogTokenized(level, token, w.buffer, w.len);
+}
+
+} // namespace LogTokenizer
+
+// One static string per call site; its address is the token.
+// The "\x1f" ends at the literal boundary, so formats may start with a hex digit.
+#define LOG_TOKENIZED_(level, tag, fmt, ...) do { \
+        static const char _logToken[] = tag "\x1f" fmt; \
+        LogTokenizer::log(level, _logToken, ##__VA_ARGS__); \
+    } while (0)
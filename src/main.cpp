@@ -5,18 +5,24 @@
 #include "config.h" 
 #include "sleep_manager.h"
 #include "system_logger.h" 
+#include "metrics.h"
+#include "data_logger.h"
+#include "trace.h"
+#include "hal/hal_power.h"
 
 #define LOG_TAG "MAIN"
 
 // --- Global Variables ---
 // RTC variables to persist across deep sleep cycles
-extern "C" uint64_t esp_rtc_get_time_us();  // Function to get the current time in microseconds since boot. NB! Not public API.
 RTC_DATA_ATTR uint64_t time_last_logged_ms = 0; 
 RTC_DATA_ATTR int deep_sleep_count = 0;
 
 // State Machine Variables 
 static AppState currentState = STATE_INIT;
 static AppState lastLoggedState = STATE_NONE;
+#if TRACE_ENABLED
+static uint32_t stateStartUs = 0; // Boot: the first span covers setup()
+#endif
 
 // Runtime flags passed between states
 bool stayAwakeForInteraction = false; 
@@ -31,8 +37,10 @@ void setup() {
   // In Production (CORE_DEBUG_LEVEL = 0), this code is removed entirely.
   #if CORE_DEBUG_LEVEL > 0
       unsigned long waitStart = millis();
-      // Wait up to 3 seconds for the Serial Monitor to open
-      while (!Serial && (millis() - waitStart < 3000)) {
+      // Wait up to 3 seconds for the Serial Monitor to open.
+      // Not on timer wakes: nobody is watching, and it would dominate the awake time.
+      unsigned long waitMs = (HalPower_getWakeupCause() == HAL_WAKEUP_TIMER) ? 0 : 3000;
+      while (!Serial && (millis() - waitStart < waitMs)) {
           delay(10);
       }
       
@@ -41,12 +49,14 @@ void setup() {
       }
   #endif
 
-  // 3. Initialize File System Logging
+  // 3. Initialize File System Logging (LittleFS is mounted on the first flush)
   Logger_Init();
+  Metrics_init();
+  DataLogger_init();
   
   // 4. Log Startup
   LOG_INFO(LOG_TAG, "--- System Starting Up (Fast Boot) ---");
-  LOG_INFO(LOG_TAG, "Wakeup Cause: %d", (int)esp_sleep_get_wakeup_cause());
+  LOG_INFO(LOG_TAG, "Wakeup Cause: %d", (int)HalPower_getWakeupCause());
 }
 
 
@@ -54,6 +64,11 @@ void loop() {
 
   // Check for state transition (for logging/debugging)
   if (currentState != lastLoggedState) {
+        Metrics_enterState(currentState); // Times the state just left
+#if TRACE_ENABLED
+        Trace_record(lastLoggedState == STATE_NONE ? "setup" : getAppStateName(lastLoggedState), stateStartUs);
+        stateStartUs = micros();
+#endif
         
         LOG_INFO(LOG_TAG, ">> STATE TRANSITION: %s -> %s", 
                  getAppStateName(lastLoggedState), 
@@ -0,0 +1,240 @@
+// metrics.cpp
+
+#include "metrics.h"
+#include "config.h"
+#include "system_logger.h"
+#include "subsystem.h"
+#include "hal/hal_fs.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
+
+#define LOG_TAG "METRICS"
+
+static constexpr uint32_t METRICS_MAGIC = 0x3154454D; // "MET1"
+static constexpr uint8_t FIRST_OCTAVE = 10;            // Bucket 1 starts at 2^10 us (~1 ms)
+
+struct MetricsHistogram {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint64_t sumUs;
+    uint16_t buckets[METRICS_BUCKET_COUNT]; // Halved together when one saturates
+};
+
+// Layout of the RTC block and of METRICS_FILE_NAME
+struct MetricsStore {
+    uint32_t magic;
+    uint32_t size;              // sizeof(MetricsStore), rejects files from other builds
+    uint32_t cycles;
+    uint32_t cyclesSinceSave;
+    MetricsHistogram series[METRICS_SERIES_COUNT];
+};
+
+RTC_DATA_ATTR static MetricsStore s_store;
+
+// Current cycle (RAM only)
+static uint8_t s_phase = STATE_NONE;
+static uint32_t s_phaseStartUs = 0;
+static bool s_cycleWasInteractive = false;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Bucket for a duration: 0 below 2^FIRST_OCTAVE, then two per octave.
+ */
+static uint8_t bucketFor(uint32_t us) {
+    if (us < (1UL << FIRST_OCTAVE)) return 0;
+    uint8_t octave = 31 - __builtin_clz(us);
+    uint8_t half = (us >> (octave - 1)) & 1;
+    int index = 1 + (octave - FIRST_OCTAVE) * 2 + half;
+    return (index < METRICS_BUCKET_COUNT) ? (uint8_t)index : METRICS_BUCKET_COUNT - 1;
+}
+
+/**
+ * @brief Lower bound of a bucket in microseconds (bucket 0 starts at 0).
+ */
+static uint64_t bucketLowerBound(uint8_t bucket) {
+    if (bucket == 0) return 0;
+    uint8_t octave = FIRST_OCTAVE + (bucket - 1) / 2;
+    uint8_t half = (bucket - 1) % 2;
+    return (uint64_t)(2 + half) << (octave - 1);
+}
+
+static void addSample(MetricsHistogram& h, uint32_t us) {
+    if (h.count == 0 || us < h.minUs) h.minUs = us;
+    if (h.count == 0 || us > h.maxUs) h.maxUs = us;
+    h.count++;
+    h.sumUs += us;
+
+    uint8_t bucket = bucketFor(us);
+    if (h.buckets[bucket] == UINT16_MAX) {
+        // Keep the shape, forget old history
+        for (uint8_t i = 0; i < METRICS_BUCKET_COUNT; i++) h.buckets[i] >>= 1;
+    }
+    h.buckets[bucket]++;
+}
+
+/**
+ * @brief Estimates a percentile as the middle of the bucket that holds it.
+ */
+static uint32_t percentile(const MetricsHistogram& h, uint8_t pct) {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < METRICS_BUCKET_COUNT; i++) total += h.buckets[i];
+    if (total == 0) return 0;
+
+    uint32_t rank = (total * pct + 99) / 100; // 1-based
+    uint32_t seen = 0;
+    uint8_t bucket = 0;
+    for (; bucket < METRICS_BUCKET_COUNT - 1; bucket++) {
+        seen += h.buckets[bucket];
+        if (seen >= rank) break;
+    }
+
+    uint64_t lower = bucketLowerBound(bucket);
+    uint64_t upper = (bucket + 1 < METRICS_BUCKET_COUNT) ? bucketLowerBound(bucket + 1) : h.maxUs;
+    uint64_t estimate = (lower + upper) / 2;
+    if (estimate < h.minUs) estimate = h.minUs;
+    if (estimate > h.maxUs) estimate = h.maxUs;
+    return (uint32_t)estimate;
+}
+
+static void resetStore() {
+    memset(&s_store, 0, sizeof(s_store));
+    s_store.magic = METRICS_MAGIC;
+    s_store.size = sizeof(MetricsStore);
+}
+
+/**
+ * @brief Loads the last saved histograms after a cold boot (RTC memory lost).
+ */
+static void loadStore() {
+    resetStore();
+    if (!Subsystem_require(SUBSYSTEM_STORAGE) || !HalFs().exists(METRICS_FILE_NAME)) return;
+
+    File file = HalFs().open(METRICS_FILE_NAME, "r");
+    if (!file) return;
+    MetricsStore stored;
+    size_t len = file.read(reinterpret_cast<uint8_t*>(&stored), sizeof(stored));
+    file.close();
+
+    if (len == sizeof(stored) && stored.magic == METRICS_MAGIC && stored.size == sizeof(MetricsStore)) {
+        s_store = stored;
+        s_store.cyclesSinceSave = 0;
+        LOG_INFO(LOG_TAG, "Restored metrics of %lu cycles from %s.", (unsigned long)s_store.cycles, METRICS_FILE_NAME);
+    } else {
+        LOG_WARN(LOG_TAG, "%s is from another firmware. Starting fresh.", METRICS_FILE_NAME);
+    }
+}
+
+static void endPhase(uint32_t nowUs) {
+    addSample(s_store.series[s_phase], nowUs - s_phaseStartUs);
+    s_phaseStartUs = nowUs;
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void Metrics_init() {
+    if (s_store.magic != METRICS_MAGIC || s_store.size != sizeof(MetricsStore)) {
+        loadStore();
+    }
+
+    // setup() is timed from app start, like the cycle total
+    s_phase = STATE_NONE;
+    s_phaseStartUs = 0;
+    s_cycleWasInteractive = false;
+}
+
+void Metrics_enterState(AppState state) {
+    endPhase(micros());
+    s_phase = state;
+    if (state == STATE_INTERACTIVE) s_cycleWasInteractive = true;
+}
+
+void Metrics_saveIfDue() {
+    if (s_store.cyclesSinceSave < METRICS_PERSIST_EVERY_N) return;
+    if (!Subsystem_require(SUBSYSTEM_STORAGE)) return;
+
+    File file = HalFs().open(METRICS_FILE_NAME, "w");
+    if (!file) {
+        LOG_ERROR(LOG_TAG, "Error opening %s!", METRICS_FILE_NAME);
+        return;
+    }
+    s_store.cyclesSinceSave = 0;
+    file.write(reinterpret_cast<const uint8_t*>(&s_store), sizeof(s_store));
+    file.close();
+    LOG_DEBUG(LOG_TAG, "Saved metrics of %lu cycles.", (unsigned long)s_store.cycles);
+}
+
+void Metrics_endCycle() {
+    uint32_t now = micros();
+    endPhase(now);
+    addSample(s_store.series[s_cycleWasInteractive ? METRICS_CYCLE_INTERACTIVE : METRICS_CYCLE_TIMER], now);
+    s_store.cycles++;
+    s_store.cyclesSinceSave++;
+}
+
+const char* Metrics_getSeriesName(uint8_t series) {
+    switch (series) {
+        case STATE_NONE:                return "BOOT";
+        case METRICS_CYCLE_TIMER:       return "CYCLE_TIMER";
+        case METRICS_CYCLE_INTERACTIVE: return "CYCLE_INTERACTIVE";
+        default:                        return getAppStateName((AppState)series);
+    }
+}
+
+bool Metrics_getSummary(uint8_t series, MetricsSummary& out) {
+    if (series >= METRICS_SERIES_COUNT) return false;
+    const MetricsHistogram& h = s_store.series[series];
+    if (h.count == 0) return false;
+
+    out.count = h.count;
+    out.minUs = h.minUs;
+    out.maxUs = h.maxUs;
+    out.meanUs = (uint32_t)(h.sumUs / h.count);
+    out.p50Us = percentile(h, 50);
+    out.p95Us = percentile(h, 95);
+    return true;
+}
+
+uint32_t Metrics_getCycleCount() {
+    return s_store.cycles;
+}
+
+String Metrics_toJson() {
+    String json;
+    json.reserve(128 + METRICS_SERIES_COUNT * 112);
+    json += "{\"cycles\":";
+    json += (unsigned long)s_store.cycles;
+    json += ",\"unit\":\"us\",\"series\":[";
+
+    bool first = true;
+    for (uint8_t i = 0; i < METRICS_SERIES_COUNT; i++) {
+        MetricsSummary s;
+        if (!Metrics_getSummary(i, s)) continue;
+
+        char row[160];
+        snprintf(row, sizeof(row),
+                 "%s{\"name\":\"%s\",\"count\":%lu,\"min\":%lu,\"p50\":%lu,\"p95\":%lu,\"max\":%lu,\"mean\":%lu}",
+                 first ? "" : ",", Metrics_getSeriesName(i), (unsigned long)s.count,
+                 (unsigned long)s.minUs, (unsigned long)s.p50Us, (unsigned long)s.p95Us,
+                 (unsigned long)s.maxUs, (unsigned long)s.meanUs);
+        json += row;
+        first = false;
+    }
+    json += "]}";
+    return json;
+}
+
+void Metrics_dumpToSerial() {
+    if (!Serial) return;
+
+    Serial.printf("\n--- WAKE CYCLE METRICS (%lu cycles, microseconds) ---\n", (unsigned long)s_store.cycles);
+    Serial.printf("%-18s %7s %9s %9s %9s %9s %9s\n", "SERIES", "COUNT", "MIN", "P50", "P95", "MAX", "MEAN");
+    for (uint8_t i = 0; i < METRICS_SERIES_COUNT; i++) {
+        MetricsSummary s;
+        if (!Metrics_getSummary(i, s)) continue;
+        Serial.printf("%-18s %7lu %9lu %9lu %9lu %9lu %9lu\n", Metrics_getSeriesName(i),
+                      (unsigned long)s.count, (unsigned long)s.minUs, (unsigned long)s.p50Us,
+                      (unsigned long)s.p95Us, (unsigned long)s.maxUs, (unsigned long)s.meanUs);
+    }
+    Serial.println("--- END OF METRICS ---\n");
+}
@@ -0,0 +1,83 @@
+// metrics.h
+
+#pragma once
+
+#include <Arduino.h>
+#include "app_controller.h" // For AppState
+
+// --- Wake Cycle Metrics ---
+// Time spent in each AppState, measured in microseconds at every state
+// transition in loop(), plus the total awake time of each cycle (from app
+// start to deep sleep, not counting the ROM bootloader). Every series is a
+// histogram with exact min/max/mean and log-scaled buckets (2 per power of
+// two, ~20% wide) for p50/p95. The histograms live in RTC memory, so they
+// accumulate across deep sleep cycles at no flash cost, and are saved to
+// METRICS_FILE_NAME every METRICS_PERSIST_EVERY_N cycles to survive a reset.
+
+// Series: one per AppState (STATE_NONE = setup() before the first state),
+// then the per-cycle totals
+constexpr uint8_t METRICS_CYCLE_TIMER = STATE_PREPARE_SLEEP + 1;       // Cycles without INTERACTIVE
+constexpr uint8_t METRICS_CYCLE_INTERACTIVE = STATE_PREPARE_SLEEP + 2; // Cycles with INTERACTIVE
+constexpr uint8_t METRICS_SERIES_COUNT = STATE_PREPARE_SLEEP + 3;
+
+constexpr uint8_t METRICS_BUCKET_COUNT = 40; // 1 ms .. ~9 min, the ends are open
+
+struct MetricsSummary {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t meanUs;
+    uint32_t p50Us;
+    uint32_t p95Us;
+};
+
+/**
+ * @brief Restores the histograms after a cold boot and starts timing setup().
+ * Call early in setup(), after Logger_Init().
+ */
+void Metrics_init();
+
+/**
+ * @brief Ends the running phase and starts timing the given state.
+ * Called by loop() on every state transition.
+ */
+void Metrics_enterState(AppState state);
+
+/**
+ * @brief Saves the histograms to flash if METRICS_PERSIST_EVERY_N cycles
+ * have passed. Call before the final log flush of the cycle.
+ */
+void Metrics_saveIfDue();
+
+/**
+ * @brief Ends the last phase and records the cycle total.
+ * Call immediately before deep sleep; does no I/O and no logging.
+ */
+void Metrics_endCycle();
+
+/**
+ * @brief Display name of a series ("BOOT", "INIT", ..., "CYCLE_TIMER").
+ */
+const char* Metrics_getSeriesName(uint8_t series);
+
+/**
+ * @brief Statistics of one series. Percentiles are bucket estimates,
+ * clamped to the exact min/max.
+ * @return false if the series has no samples.
+ */
+bool Metrics_getSummary(uint8_t series, MetricsSummary& out);
+
+/**
+ * @brief Number of completed wake cycles in the histograms.
+ */
+uint32_t Metrics_getCycleCount();
+
+/**
+ * @brief JSON for /api/metrics (all times in microseconds).
+ */
+String Metrics_toJson();
+
+/**
+ * @brief Prints a table of all series to the Serial port.
+ */
+void Metrics_dumpToSerial();
@@ -5,6 +5,9 @@
 #include "system_logger.h"
 #include "data_logger.h"
 #include "wifi_manager.h"
+#include "hal/hal_wifi.h"
+#include "subsystem.h"
+#include "trace.h"
 #include <Wire.h>
 #include <Adafruit_GFX.h>
 #include <Adafruit_SSD1306.h>
@@ -18,6 +21,8 @@ static String currentMessage = "";
 static int currentProgress = -1;
 
 bool OLEDDisplay_init() {
+    TRACE_SCOPE("oled.init");
+
     // Initialize I2C with explicit pins from config/pinout
     if (!Wire.begin(I2C_SDA_PIN, I2C_SCL_PIN)) {
         LOG_ERROR(LOG_TAG, "I2C initialization failed");
@@ -89,15 +94,15 @@ static void drawNetworkScene() {
     display.setTextSize(1);
     display.setCursor(0, 18);
 
-    // Pull status directly from WiFi library
-    if (WiFi.status() == WL_CONNECTED) {
+    // Pull status directly from the WiFi driver
+    if (HalWifi_isConnected()) {
         display.println("Status: Connected");
-        display.printf("IP:  %s\n", WiFi.localIP().toString().c_str());
+        display.printf("IP:  %s\n", HalWifi_getStationAddress().c_str());
         display.printf("URL: %s.local", wifi_manager_get_hostname().c_str());
     } else {
         display.println("Status: Connecting...");
         display.printf("AP:  %s\n", AP_SSID);
-        display.printf("IP:  %s", WiFi.softAPIP().toString().c_str());
+        display.printf("IP:  %s", HalWifi_getAPAddress().c_str());
     }
 }
 
@@ -116,6 +121,7 @@ static void drawMessageScene() {
 void OLEDDisplay_refresh() {
     if (currentMode == OLED_MODE_OFF) return;
 
+    TRACE_SCOPE("oled.refresh");
     display.clearDisplay();
     display.setTextColor(SSD1306_WHITE);
 
@@ -133,5 +139,6 @@ void OLEDDisplay_turnOff() {
     display.clearDisplay();
     display.display();
     display.ssd1306_command(SSD1306_DISPLAYOFF);
+    Subsystem_release(SUBSYSTEM_DISPLAY);
     LOG_INFO(LOG_TAG, "Display turned off (Hardware Command)");
 }
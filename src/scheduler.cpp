@@ -0,0 +1,205 @@
+// scheduler.cpp
+
+#include "scheduler.h"
+#include "config.h"
+#include "system_logger.h"
+#include "freertos/queue.h"
+
+#define LOG_TAG "SCHED"
+
+// Timers are armed, expired and waited on by the app controller task only;
+// other tasks and ISRs reach the scheduler through the queue.
+
+struct WheelTimer {
+    uint32_t expiryTick;  // Absolute tick (millis() / SCHEDULER_TICK_MS)
+    uint32_t periodTicks; // 0 = one-shot
+    int8_t next;          // Next timer in the same slot, -1 = end of list
+    bool armed;
+};
+
+static QueueHandle_t s_queue = nullptr;
+static WheelTimer s_timers[EVENT_COUNT];          // Indexed by event
+static int8_t s_slots[SCHEDULER_WHEEL_SLOTS];     // Head of each slot's list
+static uint32_t s_currentTick = 0;                // Last tick processed
+static uint32_t s_firedMask = 0;                  // Expired timers not yet returned
+
+static_assert(EVENT_COUNT <= 32, "s_firedMask holds one bit per event");
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static uint32_t nowTick_internal() {
+    return millis() / SCHEDULER_TICK_MS;
+}
+
+static void link_internal(uint8_t id) {
+    uint8_t slot = s_timers[id].expiryTick % SCHEDULER_WHEEL_SLOTS;
+    s_timers[id].next = s_slots[slot];
+    s_slots[slot] = (int8_t)id;
+}
+
+static void unlink_internal(uint8_t id) {
+    int8_t* link = &s_slots[s_timers[id].expiryTick % SCHEDULER_WHEEL_SLOTS];
+    while (*link >= 0) {
+        if (*link == (int8_t)id) {
+            *link = s_timers[id].next;
+            return;
+        }
+        link = &s_timers[*link].next;
+    }
+}
+
+/**
+ * @brief Expires the timers due up to now. Visits only the slots the wheel
+ * moved past; after a stall longer than one turn, every slot once.
+ */
+static void advance_internal() {
+    uint32_t now = nowTick_internal();
+    uint32_t elapsed = now - s_currentTick;
+    if (elapsed > SCHEDULER_WHEEL_SLOTS) elapsed = SCHEDULER_WHEEL_SLOTS;
+
+    for (uint32_t step = 1; step <= elapsed; step++) {
+        uint8_t slot = (s_currentTick + step) % SCHEDULER_WHEEL_SLOTS;
+        int8_t id = s_slots[slot];
+        while (id >= 0) {
+            WheelTimer& timer = s_timers[id];
+            int8_t next = timer.next;
+
+            // Timers a full turn (or more) ahead share the slot: not due yet
+            if ((int32_t)(timer.expiryTick - now) <= 0) {
+                unlink_internal((uint8_t)id);
+                s_firedMask |= (1UL << id);
+                if (timer.periodTicks > 0) {
+                    // Keep the period's phase, but skip periods missed while busy
+                    do {
+                        timer.expiryTick += timer.periodTicks;
+                    } while ((int32_t)(timer.expiryTick - now) <= 0);
+                    link_internal((uint8_t)id);
+                } else {
+                    timer.armed = false;
+                }
+            }
+            id = next;
+        }
+    }
+    s_currentTick = now;
+}
+
+/**
+ * @brief Milliseconds until the earliest armed deadline, or portMAX_DELAY.
+ * At most one timer per event, so this is a scan of EVENT_COUNT entries.
+ */
+static TickType_t ticksUntilNextDeadline_internal() {
+    bool found = false;
+    uint32_t earliest = 0;
+    for (uint8_t id = 0; id < EVENT_COUNT; id++) {
+        if (!s_timers[id].armed) continue;
+        if (!found || (int32_t)(s_timers[id].expiryTick - earliest) < 0) {
+            earliest = s_timers[id].expiryTick;
+            found = true;
+        }
+    }
+    if (!found) return portMAX_DELAY;
+
+    uint32_t deadlineMs = earliest * SCHEDULER_TICK_MS;
+    int32_t waitMs = (int32_t)(deadlineMs - (uint32_t)millis());
+    return (waitMs > 0) ? pdMS_TO_TICKS(waitMs) + 1 : 0; // +1: never wake a tick early
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void Scheduler_init() {
+    if (s_queue == nullptr) {
+        s_queue = xQueueCreate(SCHEDULER_QUEUE_LENGTH, sizeof(AppEvent));
+        if (s_queue == nullptr) {
+            LOG_ERROR(LOG_TAG, "Failed to create the event queue!");
+        }
+    }
+
+    AppEvent stale;
+    while (s_queue && xQueueReceive(s_queue, &stale, 0) == pdTRUE) {
+    }
+
+    for (uint8_t id = 0; id < EVENT_COUNT; id++) {
+        s_timers[id].armed = false;
+        s_timers[id].next = -1;
+    }
+    for (uint8_t slot = 0; slot < SCHEDULER_WHEEL_SLOTS; slot++) {
+        s_slots[slot] = -1;
+    }
+    s_firedMask = 0;
+    s_currentTick = nowTick_internal();
+}
+
+bool Scheduler_post(AppEvent event) {
+    if (s_queue == nullptr) return false;
+    return xQueueSend(s_queue, &event, 0) == pdTRUE;
+}
+
+void IRAM_ATTR Scheduler_postFromISR(AppEvent event) {
+    if (s_queue == nullptr) return;
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(s_queue, &event, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void Scheduler_startTimer(AppEvent event, uint32_t delayMs, uint32_t periodMs) {
+    if (event == EVENT_NONE || event >= EVENT_COUNT) return;
+
+    WheelTimer& timer = s_timers[event];
+    if (timer.armed) unlink_internal(event);
+
+    // Round up, and at least one tick: the current slot was already visited
+    uint32_t delayTicks = (delayMs + SCHEDULER_TICK_MS - 1) / SCHEDULER_TICK_MS;
+    timer.expiryTick = nowTick_internal() + (delayTicks > 0 ? delayTicks : 1);
+    timer.periodTicks = (periodMs + SCHEDULER_TICK_MS - 1) / SCHEDULER_TICK_MS;
+    timer.armed = true;
+    link_internal(event);
+}
+
+void Scheduler_stopTimer(AppEvent event) {
+    if (event == EVENT_NONE || event >= EVENT_COUNT) return;
+
+    if (s_timers[event].armed) {
+        unlink_internal(event);
+        s_timers[event].armed = false;
+    }
+}
+
+AppEvent Scheduler_wait() {
+    for (;;) {
+        advance_internal();
+
+        // Expired timers first, lowest event number first
+        if (s_firedMask != 0) {
+            for (uint8_t id = 0; id < EVENT_COUNT; id++) {
+                if (s_firedMask & (1UL << id)) {
+                    s_firedMask &= ~(1UL << id);
+                    return (AppEvent)id;
+                }
+            }
+        }
+
+        AppEvent event;
+        if (s_queue && xQueueReceive(s_queue, &event, ticksUntilNextDeadline_internal()) == pdTRUE) {
+            return event;
+        }
+        if (s_queue == nullptr) delay(SCHEDULER_TICK_MS); // No queue: degrade to polling
+    }
+}
+
+const char* Scheduler_getEventName(AppEvent event) {
+    switch (event) {
+        case EVENT_NONE:              return "NONE";
+        case EVENT_BUTTON:            return "BUTTON";
+        case EVENT_WEB_ACTIVITY:      return "WEB_ACTIVITY";
+        case EVENT_SENSOR_READY:      return "SENSOR_READY";
+        case EVENT_TIME_SYNC:         return "TIME_SYNC";
+        case EVENT_TIME_SET:          return "TIME_SET";
+        case EVENT_LIVE_SAMPLE:       return "LIVE_SAMPLE";
+        case EVENT_DISPLAY_REFRESH:   return "DISPLAY_REFRESH";
+        case EVENT_NETWORK_INFO_DONE: return "NETWORK_INFO_DONE";
+        case EVENT_SERIAL_POLL:       return "SERIAL_POLL";
+        case EVENT_IDLE_TIMEOUT:      return "IDLE_TIMEOUT";
+        default:                      return "UNKNOWN";
+    }
+}
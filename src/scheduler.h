@@ -0,0 +1,66 @@
+// scheduler.h
+
+#pragma once
+
+#include <Arduino.h>
+
+// --- Interactive Event Scheduler ---
+// While the device is awake for the user, the app controller sleeps in
+// Scheduler_wait() until something happens instead of polling. Things that
+// happen are events: posted from other tasks or ISRs (button, web request),
+// or fired by a timer (display refresh, live sample, idle timeout).
+// Timers sit in a hashed timer wheel of SCHEDULER_WHEEL_SLOTS slots of
+// SCHEDULER_TICK_MS each: arming and expiring a timer is O(1), and the
+// wait blocks on the event queue exactly until the next deadline.
+// Each event has at most one timer; arming it again moves the deadline.
+
+enum AppEvent : uint8_t {
+    EVENT_NONE,
+    EVENT_BUTTON,            // ISR: wake button pressed while awake
+    EVENT_WEB_ACTIVITY,      // Web server: a request was served
+    EVENT_SENSOR_READY,      // Sensor driver: a live sample was read
+    EVENT_TIME_SYNC,         // Time manager: station up or SNTP reply (see TimeManager_serviceNetworkSync())
+    EVENT_TIME_SET,          // Time manager: time set by hand (see TimeManager_serviceTimeSet())
+    EVENT_LIVE_SAMPLE,       // Timer: read the sensor for the live view
+    EVENT_DISPLAY_REFRESH,   // Timer: redraw the OLED
+    EVENT_NETWORK_INFO_DONE, // Timer: switch the OLED back to the sensor view
+    EVENT_SERIAL_POLL,       // Timer: check the Serial console for commands
+    EVENT_IDLE_TIMEOUT,      // Timer: no user activity for WEB_SERVER_INACTIVITY_TIMEOUT
+    EVENT_COUNT
+};
+
+/**
+ * @brief Creates the event queue (first call) and disarms all timers.
+ * Events still queued from a previous session are discarded.
+ */
+void Scheduler_init();
+
+/**
+ * @brief Queues an event from a task. Never blocks.
+ * @return false if the queue is full (the event is dropped).
+ */
+bool Scheduler_post(AppEvent event);
+
+/**
+ * @brief Queues an event from an interrupt handler.
+ */
+void IRAM_ATTR Scheduler_postFromISR(AppEvent event);
+
+/**
+ * @brief Arms the event's timer to fire after delayMs, then every periodMs
+ * (0 = once). Replaces a pending deadline of the same event.
+ */
+void Scheduler_startTimer(AppEvent event, uint32_t delayMs, uint32_t periodMs = 0);
+
+/**
+ * @brief Disarms the event's timer. Events already fired are still delivered.
+ */
+void Scheduler_stopTimer(AppEvent event);
+
+/**
+ * @brief Blocks until the next event (queued or timer) and returns it.
+ * The CPU is idle in between; there is no polling interval.
+ */
+AppEvent Scheduler_wait();
+
+const char* Scheduler_getEventName(AppEvent event);
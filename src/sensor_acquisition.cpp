@@ -0,0 +1,139 @@
+// sensor_acquisition.cpp
+
+#include "sensor_acquisition.h"
+#include "config.h"
+#include "system_logger.h"
+#include "dht_sensor.h"
+#include "trace.h"
+
+#define LOG_TAG "ACQUIRE"
+
+// Scales the MAD to a standard deviation for normally distributed noise
+static constexpr float MAD_TO_SIGMA = 1.4826f;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void sortValues(float* values, uint8_t count) {
+    for (uint8_t i = 1; i < count; i++) {
+        float v = values[i];
+        uint8_t j = i;
+        while (j > 0 && values[j - 1] > v) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = v;
+    }
+}
+
+static float median(const float* values, uint8_t count) {
+    float sorted[SENSOR_BURST_SIZE];
+    memcpy(sorted, values, count * sizeof(float));
+    sortValues(sorted, count);
+    return (count % 2) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0f;
+}
+
+/**
+ * @brief Marks reads too far from the median in rejected[].
+ * Needs 3 reads: with 2 there is no majority to tell which one is off.
+ */
+static void markOutliers(const float* values, uint8_t count, float minSpread, bool* rejected) {
+    if (count < 3) return;
+
+    float center = median(values, count);
+    float deviations[SENSOR_BURST_SIZE];
+    for (uint8_t i = 0; i < count; i++) {
+        deviations[i] = fabsf(values[i] - center);
+    }
+    float spread = median(deviations, count) * MAD_TO_SIGMA;
+    if (spread < minSpread) spread = minSpread;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (deviations[i] > SENSOR_OUTLIER_MADS * spread) rejected[i] = true;
+    }
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+bool SensorAcquisition_acquire(AcquiredSample& out, uint8_t reads) {
+    TRACE_SCOPE("sensor.acquire");
+    if (reads < 1) reads = 1;
+    if (reads > SENSOR_BURST_SIZE) reads = SENSOR_BURST_SIZE;
+
+    float temperatures[SENSOR_BURST_SIZE];
+    float humidities[SENSOR_BURST_SIZE];
+    out.reads = 0;
+    out.rejected = 0;
+    out.retries = 0;
+
+    // 1. Burst, with bounded retries for failed reads
+    unsigned long backoffMs = DHT_MIN_READ_INTERVAL_MS;
+    while (out.reads < reads) {
+        float t, h;
+        if (DHTSensor_read(t, h)) {
+            temperatures[out.reads] = t;
+            humidities[out.reads] = h;
+            out.reads++;
+            backoffMs = DHT_MIN_READ_INTERVAL_MS;
+            if (out.reads < reads) delay(DHT_MIN_READ_INTERVAL_MS);
+            continue;
+        }
+
+        if (out.retries >= SENSOR_MAX_RETRIES) break;
+        out.retries++;
+        LOG_WARN(LOG_TAG, "Sensor read failed. Retry %u/%u in %lu ms.", out.retries, SENSOR_MAX_RETRIES, backoffMs);
+        delay(backoffMs);
+        backoffMs = (backoffMs * 2 < SENSOR_RETRY_MAX_BACKOFF_MS) ? backoffMs * 2 : SENSOR_RETRY_MAX_BACKOFF_MS;
+    }
+
+    if (out.reads == 0) {
+        out.temperature = NAN;
+        out.humidity = NAN;
+        out.quality = SAMPLE_QUALITY_FAILED;
+        LOG_ERROR(LOG_TAG, "No usable sensor read after %u retries.", out.retries);
+        return false;
+    }
+
+    // 2. Outlier rejection per channel; a read rejected on either is dropped
+    bool rejected[SENSOR_BURST_SIZE] = {};
+    markOutliers(temperatures, out.reads, SENSOR_OUTLIER_MIN_TEMP_C, rejected);
+    markOutliers(humidities, out.reads, SENSOR_OUTLIER_MIN_HUM_PCT, rejected);
+
+    // 3. Mean of the reads that are left
+    float temperatureSum = 0.0f;
+    float humiditySum = 0.0f;
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < out.reads; i++) {
+        if (rejected[i]) {
+            out.rejected++;
+            LOG_WARN(LOG_TAG, "Outlier rejected: T: %.1f, H: %.1f", temperatures[i], humidities[i]);
+            continue;
+        }
+        temperatureSum += temperatures[i];
+        humiditySum += humidities[i];
+        kept++;
+    }
+    if (kept == 0) {
+        // Each channel rejected a different read: fall back to the medians
+        out.temperature = median(temperatures, out.reads);
+        out.humidity = median(humidities, out.reads);
+    } else {
+        out.temperature = temperatureSum / kept;
+        out.humidity = humiditySum / kept;
+    }
+
+    bool complete = (out.reads == reads) && out.rejected == 0 && out.retries == 0;
+    out.quality = complete ? SAMPLE_QUALITY_GOOD : SAMPLE_QUALITY_DEGRADED;
+
+    LOG_DEBUG(LOG_TAG, "Acquired from %u/%u reads (%u rejected, %u retries): %s", out.reads,
+              reads, out.rejected, out.retries, SensorAcquisition_getQualityName(out.quality));
+    return true;
+}
+
+const char* SensorAcquisition_getQualityName(SampleQuality quality) {
+    switch (quality) {
+        case SAMPLE_QUALITY_GOOD:     return "GOOD";
+        case SAMPLE_QUALITY_DEGRADED: return "DEGRADED";
+        case SAMPLE_QUALITY_FAILED:   return "FAILED";
+        default:                      return "UNKNOWN";
+    }
+}
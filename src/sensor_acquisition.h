@@ -0,0 +1,42 @@
+// sensor_acquisition.h
+
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// --- Robust Sensor Acquisition ---
+// One logged sample is built from one read or from a burst of up to
+// SENSOR_BURST_SIZE reads spaced DHT_MIN_READ_INTERVAL_MS apart (faster reads
+// would only return the cached result). A failed read (no answer, bad timing, checksum) is retried with a
+// backoff that doubles up to SENSOR_RETRY_MAX_BACKOFF_MS, at most
+// SENSOR_MAX_RETRIES times per sample. Per channel, reads further than
+// SENSOR_OUTLIER_MADS scaled median absolute deviations from the median are
+// rejected, and the sample is the mean of the rest.
+// A single NaN therefore no longer costs a whole LOG_INTERVAL_SECONDS.
+
+enum SampleQuality : uint8_t {
+    SAMPLE_QUALITY_GOOD,     // Every read of the burst answered and agreed
+    SAMPLE_QUALITY_DEGRADED, // Usable, but reads failed or were rejected
+    SAMPLE_QUALITY_FAILED    // No usable read (values are NaN)
+};
+
+struct AcquiredSample {
+    float temperature;
+    float humidity;
+    SampleQuality quality;
+    uint8_t reads;    // Successful reads
+    uint8_t rejected; // Of those, dropped as outliers (either channel)
+    uint8_t retries;  // Failed reads that were retried
+};
+
+/**
+ * @brief Takes one sample. Blocks the calling task for the burst
+ * (~(reads - 1) * DHT_MIN_READ_INTERVAL_MS, more with retries).
+ * @param reads Reads to combine, 1..SENSOR_BURST_SIZE. Outliers are only
+ * rejected with 3 or more.
+ * @return true unless the quality is SAMPLE_QUALITY_FAILED.
+ */
+bool SensorAcquisition_acquire(AcquiredSample& out, uint8_t reads = SENSOR_BURST_SIZE);
+
+const char* SensorAcquisition_getQualityName(SampleQuality quality);
@@ -2,6 +2,8 @@
 
 #include "settings_manager.h"
 #include "system_logger.h"
+#include "hal/hal_nvs.h"
+#include "trace.h"
 
 // --- FALLBACK HANDLING ---
 // We check if secrets.h exists. If code is downloaded from GitHub
@@ -28,14 +30,17 @@ SettingsManager::SettingsManager() {
     _isInitialized = false;
 }
 
-void SettingsManager::begin() {
-    // Open NVS in read/write mode (false)
-    if (_prefs.begin(_namespace, false)) { 
+bool SettingsManager::begin() {
+    TRACE_SCOPE("nvs.open");
+
+    // Open NVS in read/write mode
+    if (HalNvs_begin(_namespace)) { 
         _isInitialized = true;
         LOG_INFO(LOG_TAG, "NVS Storage initialized.");
     } else {
         LOG_ERROR(LOG_TAG, "Failed to initialize NVS!");
     }
+    return _isInitialized;
 }
 
 String SettingsManager::getWifiSSID() {
@@ -43,11 +48,11 @@ String SettingsManager::getWifiSSID() {
     if (!_isInitialized) return String(DEFAULT_WIFI_SSID);
     
     // Logic: Get string from NVS. If key "ssid" doesn't exist, return DEFAULT_WIFI_SSID.       
-    if (!_prefs.isKey("ssid")) {
+    if (!HalNvs_hasKey("ssid")) {
         return String(DEFAULT_WIFI_SSID);
     }
 
-    String ssid = _prefs.getString("ssid", DEFAULT_WIFI_SSID);
+    String ssid = HalNvs_getString("ssid", DEFAULT_WIFI_SSID);
     
     // Logging for debugging (Optional: remove if too verbose)
     if (ssid == DEFAULT_WIFI_SSID && String(DEFAULT_WIFI_SSID) != "") {
@@ -60,15 +65,25 @@ String SettingsManager::getWifiSSID() {
     return ssid;
 }
 
+size_t SettingsManager::getWifiSSID(char* out, size_t size) {
+    if (size == 0) return 0;
+    if (_isInitialized && HalNvs_hasKey("ssid")) {
+        return HalNvs_getString("ssid", out, size);
+    }
+    strncpy(out, DEFAULT_WIFI_SSID, size);
+    out[size - 1] = '\0';
+    return strlen(out);
+}
+
 String SettingsManager::getWifiPassword() {
     if (!_isInitialized) return String(DEFAULT_WIFI_PASS);
     
     // FIX: Samme sjekk for passord
-    if (!_prefs.isKey("pass")) {
+    if (!HalNvs_hasKey("pass")) {
         return String(DEFAULT_WIFI_PASS);
     }
 
-    return _prefs.getString("pass", DEFAULT_WIFI_PASS);
+    return HalNvs_getString("pass", DEFAULT_WIFI_PASS);
 }
 
 void SettingsManager::saveWifiCredentials(String ssid, String password) {
@@ -78,15 +93,22 @@ void SettingsManager::saveWifiCredentials(String ssid, String password) {
     }
     
     if (ssid.length() > 0) {
-        _prefs.putString("ssid", ssid);
-        _prefs.putString("pass", password);
+        HalNvs_putString("ssid", ssid);
+        HalNvs_putString("pass", password);
         LOG_INFO(LOG_TAG, "New credentials saved to NVS. Reboot to apply.");
     }
 }
 
+uint32_t SettingsManager::nextPowerOnSession() {
+    if (!_isInitialized) return 0;
+    uint32_t session = HalNvs_getUInt("pwr_session", 0) + 1;
+    HalNvs_putUInt("pwr_session", session);
+    return session;
+}
+
 void SettingsManager::clearWifiCredentials() {
     if (!_isInitialized) return;
-    _prefs.remove("ssid");
-    _prefs.remove("pass");
+    HalNvs_remove("ssid");
+    HalNvs_remove("pass");
     LOG_INFO(LOG_TAG, "NVS cleared. Reverting to factory defaults.");
 }
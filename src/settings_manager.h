@@ -2,16 +2,14 @@
 // settings_manager.h
 #pragma once
 #include <Arduino.h>
-#include <Preferences.h>
 
 /**
  * @brief Manages persistent storage (NVS) and configuration.
- * Acts as a wrapper around the ESP32 Preferences library.
+ * Acts as a wrapper around the NVS HAL (hal/hal_nvs.h).
  * Implements a fallback mechanism using secrets.h if NVS is empty.
  */
 class SettingsManager {
 private:
-    Preferences _prefs;         // The underlying NVS object
     bool _isInitialized;        // Flag to track if NVS opened successfully
     const char* _namespace = "app_config"; // The NVS partition name
 
@@ -19,14 +17,17 @@ public:
     SettingsManager(); // Constructor
 
     /**
-     * @brief Opens the NVS storage. Must be called in setup().
+     * @brief Opens the NVS storage. Started on first use through
+     * Subsystem_require(SUBSYSTEM_SETTINGS) (see subsystem.h).
+     * @return true if NVS is ready.
      */
-    void begin();
+    bool begin();
     
     // --- Getters ---
     // These return the value from NVS. 
     // If NVS is empty, they return the defaults from secrets.h.
     String getWifiSSID();
+    size_t getWifiSSID(char* out, size_t size); // Same, without String or logging
     String getWifiPassword();
     
     // --- Setters ---
@@ -36,6 +37,10 @@ public:
     // --- Utilities ---
     // Clears stored data to force a reversion to factory defaults.
     void clearWifiCredentials(); 
+
+    // Counts power-on sessions (RTC timer restarts), for provisional
+    // timestamps (see RECORD_FLAG_PROVISIONAL). Returns the new count.
+    uint32_t nextPowerOnSession();
 };
 
 // Global instance available to the entire application
@@ -2,11 +2,19 @@
 
 #include "sleep_manager.h"
 #include "config.h"
-#include "esp_sleep.h"
+#include "hal/hal_power.h"
 #include "system_logger.h" // New include for logging
+#include "metrics.h"
+#include "time_manager.h"
+#include "hal/hal_clock.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
 
 #define LOG_TAG "SLEEP" // Define a tag for Sleep Manager module logs
 
+// Wake overhead learning (survives deep sleep)
+RTC_DATA_ATTR static uint64_t s_plannedWakeMs = 0;     // RTC timer time the last sleep should end, 0 = none
+RTC_DATA_ATTR static float s_wakeOverheadMs = 0.0f;    // 0 = not measured yet
+
 int64_t calculateSleepTime(uint64_t timeLastLogged_ms, uint64_t currentTime_ms, uint64_t overhead_ms, uint64_t logInterval_ms) {
     // Explicitly cast all unsigned inputs to signed 64-bit integers BEFORE calculation.
     // This prevents unsigned integer underflow (wrapping around to huge numbers)
@@ -27,6 +35,56 @@ int64_t calculateSleepTime(uint64_t timeLastLogged_ms, uint64_t currentTime_ms,
     return remaining_time_ms * 1000LL;
 }
 
+int64_t calculateAlignedSleepTime(uint64_t timeLastLogged_ms, uint64_t currentTime_ms) {
+    int64_t overheadMs = (int64_t)getWakeOverheadMs();
+    int64_t intervalS = (int64_t)LOG_INTERVAL_SECONDS;
+
+    if (!SLEEP_ALIGN_TO_WALL_CLOCK || !TimeManager_isTimeSet()) {
+        return calculateSleepTime(timeLastLogged_ms, currentTime_ms, overheadMs, intervalS * 1000LL);
+    }
+
+    // 1. Wall time of the last sample, on the shifted slot grid
+    int64_t nowS = (int64_t)HalClock_getEpoch() + SLEEP_ALIGN_OFFSET_SEC;
+    int64_t sinceLastS = ((int64_t)currentTime_ms - (int64_t)timeLastLogged_ms) / 1000LL;
+    int64_t lastS = nowS - sinceLastS;
+
+    // 2. The next slot at least half an interval after it: a wake that landed
+    // just before its slot must not schedule that same slot again
+    int64_t slotS = ((lastS + intervalS / 2) / intervalS + 1) * intervalS;
+
+    // 3. Wall time until the wake, then in RTC timer time
+    int64_t wallUs = ((slotS - nowS) * 1000LL - overheadMs) * 1000LL;
+    int32_t driftPpm = TimeManager_getSlowClockDriftPpm();
+    int64_t rtcUs = wallUs * 1000000LL / (1000000LL + driftPpm);
+
+    time_t slotEpoch = (time_t)(slotS - SLEEP_ALIGN_OFFSET_SEC);
+    struct tm slotTm;
+    char slotStr[24];
+    localtime_r(&slotEpoch, &slotTm);
+    strftime(slotStr, sizeof(slotStr), "%Y-%m-%d %H:%M:%S", &slotTm);
+    LOG_INFO(LOG_TAG, "Next slot %s (drift %ld ppm, wake overhead %lld ms).", slotStr, (long)driftPpm,
+             (long long)overheadMs);
+
+    return rtcUs;
+}
+
+void recordScheduledSample(uint64_t sampleTime_ms, bool typical) {
+    uint64_t plannedMs = s_plannedWakeMs;
+    s_plannedWakeMs = 0; // Once per wake: later samples are not timed from the wake
+    if (!typical || plannedMs == 0 || HalPower_getWakeupCause() != HAL_WAKEUP_TIMER) return;
+    if (sampleTime_ms < plannedMs || sampleTime_ms - plannedMs > WAKEUP_OVERHEAD_MAX_MS) return;
+
+    float measuredMs = (float)(sampleTime_ms - plannedMs);
+    s_wakeOverheadMs = (s_wakeOverheadMs > 0.0f)
+        ? s_wakeOverheadMs + WAKEUP_OVERHEAD_FILTER_ALPHA * (measuredMs - s_wakeOverheadMs)
+        : measuredMs;
+    LOG_DEBUG(LOG_TAG, "Wake overhead: %.0f ms (filtered %.0f ms).", measuredMs, s_wakeOverheadMs);
+}
+
+unsigned long getWakeOverheadMs() {
+    return (s_wakeOverheadMs > 0.0f) ? (unsigned long)lroundf(s_wakeOverheadMs) : WAKEUP_OVERHEAD_MS;
+}
+
 void goToDeepSleep(int64_t sleep_time_us) {
   
     // --- SAFETY CHECK ---
@@ -43,50 +101,18 @@ void goToDeepSleep(int64_t sleep_time_us) {
     LOG_INFO(LOG_TAG, "Entering Deep Sleep for %.3f seconds...", (double)sleep_time_us / 1000000.0);
     LOG_INFO(LOG_TAG, "Wake up source: Timer or Button (GPIO %d)", BUTTON_PIN);
 
-    // Configure Timer Wakeup (Casting back to uint64_t is safe here because we ensured it's positive above)
-    esp_sleep_enable_timer_wakeup((uint64_t)sleep_time_us);
-
-    // 2. Configure Button Wakeup (Hardware Specific)
-    // We configure the pin as INPUT_PULLUP first
-    pinMode(BUTTON_PIN, INPUT_PULLUP);
-
-    #if defined(BOARD_FIREBEETLE_C6)
-        // --- ESP32-C6 / RISC-V Implementation (IDF 5.x / Arduino 3.x) ---
-        // On the C6, ext0_wakeup is deprecated/removed. We use gpio_wakeup.
-        // We must enable the GPIO wake-up logic for the specific pin, requiring LOW level.
-
-
-        
-        LOG_DEBUG(LOG_TAG, "Configuring Wakeup for RISC-V (C6)");
-
-        // Ensure the pin direction and pull-up state is maintained during sleep
-        gpio_set_direction((gpio_num_t)BUTTON_PIN, GPIO_MODE_INPUT);
-        gpio_pullup_en((gpio_num_t)BUTTON_PIN);
-
-        // Enable deep sleep wakeup for the specific pin bitmask
-        // We use 1ULL << BUTTON_PIN to target the correct GPIO
-        esp_deep_sleep_enable_gpio_wakeup(1ULL << BUTTON_PIN, ESP_GPIO_WAKEUP_GPIO_LOW);
-        
-
-        // // Enable wakeup for the pin (Low level triggers wakeup)
-        // gpio_wakeup_enable((gpio_num_t)BUTTON_PIN, GPIO_INTR_LOW_LEVEL);
-        
-        // // Enable GPIO wakeup source globally for sleep
-        // esp_sleep_enable_gpio_wakeup();
-
-    #else
-        // --- ESP32 Classic / Xtensa Implementation ---
-        // Uses the traditional EXT0 wakeup source for RTC IOs.
-        
-        LOG_DEBUG(LOG_TAG, "Configuring Wakeup for Classic ESP32");
-        esp_sleep_enable_ext0_wakeup((gpio_num_t)BUTTON_PIN, LOW);
-        
-    #endif
-
+    Metrics_saveIfDue();
+    Logger_Flush(); // RAM log buffer does not survive deep sleep
     Serial.flush(); // Ensure all serial data is sent before shutting down the radio/CPU
-    delay(100); // Give the USB stack time to push the final buffer to the PC
+    if (Serial) {
+        delay(100); // Give the USB stack time to push the final buffer to the PC (only if one is listening)
+    }
+    
+    Metrics_endCycle(); // Awake time ends here
+    s_plannedWakeMs = (HalClock_getRtcMicros() + (uint64_t)sleep_time_us) / 1000ULL;
     
-    esp_deep_sleep_start();
+    // Arms the timer and button wakeups (Casting back to uint64_t is safe here because we ensured it's positive above)
+    HalPower_deepSleep((uint64_t)sleep_time_us, BUTTON_PIN);
   
     // This line will never be reached unless deep sleep fails
     LOG_ERROR(LOG_TAG, "Deep sleep failed! This should not happen.");
@@ -9,6 +9,33 @@
  */
 int64_t calculateSleepTime(uint64_t timeLastLogged_ms, uint64_t currentTime_ms, uint64_t overhead_ms, uint64_t logInterval_ms);
 
+/**
+ * @brief Sleep time until the next sample is due, on the wall-clock slot grid.
+ * The slot after the last sample is the next multiple of LOG_INTERVAL_SECONDS
+ * (shifted by SLEEP_ALIGN_OFFSET_SEC) that is at least half an interval away
+ * from it. The wall time until then, less the learned wake overhead, is
+ * converted into RTC timer time with TimeManager_getSlowClockDriftPpm().
+ * Without valid time (or SLEEP_ALIGN_TO_WALL_CLOCK off) falls back to
+ * calculateSleepTime() with the learned overhead.
+ * @param timeLastLogged_ms RTC timer time of the last sample.
+ * @param currentTime_ms RTC timer time now.
+ * @return The time in microseconds. Negative if the slot is already overdue.
+ */
+int64_t calculateAlignedSleepTime(uint64_t timeLastLogged_ms, uint64_t currentTime_ms);
+
+/**
+ * @brief Learns the wake overhead: the time from the planned timer wake to
+ * the scheduled sample. Call when the sample is taken (RTC timer time).
+ * Only the first sample after a timer wake counts, and only if it was
+ * typical: pass false when sensor retries or a network sync delayed it.
+ */
+void recordScheduledSample(uint64_t sampleTime_ms, bool typical);
+
+/**
+ * @brief Learned wake overhead, WAKEUP_OVERHEAD_MS until the first measurement.
+ */
+unsigned long getWakeOverheadMs();
+
 /**
  * @brief Enters deep sleep safely.
  * Includes safety checks: If sleep_time_us is too short or negative, 
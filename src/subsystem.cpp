@@ -0,0 +1,92 @@
+// subsystem.cpp
+
+#include "subsystem.h"
+#include "system_logger.h"
+#include "settings_manager.h"
+#include "data_logger.h"
+#include "dht_sensor.h"
+#include "external_rtc.h"
+#include "oled_display.h"
+
+#define LOG_TAG "SUBSYS"
+
+enum SubsystemStatus : uint8_t {
+    STATUS_STOPPED,
+    STATUS_STARTING, // Guards against dependency cycles
+    STATUS_READY,
+    STATUS_FAILED
+};
+
+struct SubsystemEntry {
+    const char* name;
+    bool (*start)();       // nullptr: nothing to start besides the dependencies
+    uint8_t dependencies;  // Bit mask of Subsystem
+};
+
+#define DEPENDS_ON(id) (1u << (id))
+
+static bool startSettings() { return Settings.begin(); }
+static bool startSensor() { return DHTSensor_init(); }
+static bool startRtc() { return RTCManager.begin(); }
+
+// Indexed by Subsystem
+static const SubsystemEntry s_entries[SUBSYSTEM_COUNT] = {
+    { "settings", startSettings,            0 },
+    { "storage",  DataLogger_mountStorage,  0 },
+    { "sensor",   startSensor,              0 },
+    { "rtc",      startRtc,                 0 },
+    { "display",  OLEDDisplay_init,         0 },
+    { "wifi",     nullptr,                  DEPENDS_ON(SUBSYSTEM_SETTINGS) },
+};
+
+// RAM only: everything is stopped again after deep sleep
+static SubsystemStatus s_status[SUBSYSTEM_COUNT] = {};
+
+// --- PUBLIC FUNCTIONS ---
+
+bool Subsystem_require(Subsystem id) {
+    if (id >= SUBSYSTEM_COUNT) return false;
+
+    switch (s_status[id]) {
+        case STATUS_READY:    return true;
+        case STATUS_FAILED:   return false;
+        case STATUS_STARTING: return false;
+        default: break;
+    }
+
+    s_status[id] = STATUS_STARTING;
+    const SubsystemEntry& entry = s_entries[id];
+
+    // 1. Dependencies first
+    for (uint8_t dep = 0; dep < SUBSYSTEM_COUNT; dep++) {
+        if ((entry.dependencies & DEPENDS_ON(dep)) && !Subsystem_require((Subsystem)dep)) {
+            LOG_ERROR(LOG_TAG, "%s not started: %s is unavailable.", entry.name, s_entries[dep].name);
+            s_status[id] = STATUS_FAILED;
+            return false;
+        }
+    }
+
+    // 2. The subsystem itself
+    unsigned long start = millis();
+    bool ok = entry.start ? entry.start() : true;
+    s_status[id] = ok ? STATUS_READY : STATUS_FAILED;
+
+    if (ok) {
+        LOG_DEBUG(LOG_TAG, "Started %s (%lu ms).", entry.name, millis() - start);
+    } else {
+        LOG_ERROR(LOG_TAG, "Failed to start %s.", entry.name);
+    }
+    return ok;
+}
+
+bool Subsystem_isReady(Subsystem id) {
+    return id < SUBSYSTEM_COUNT && s_status[id] == STATUS_READY;
+}
+
+void Subsystem_release(Subsystem id) {
+    if (id < SUBSYSTEM_COUNT) s_status[id] = STATUS_STOPPED;
+}
+
+const char* Subsystem_getName(Subsystem id) {
+    return id < SUBSYSTEM_COUNT ? s_entries[id].name : "unknown";
+}
@@ -0,0 +1,41 @@
+// subsystem.h
+
+#pragma once
+
+#include <Arduino.h>
+
+// --- Lazy Subsystem Registry ---
+// Each subsystem starts on its first Subsystem_require() call instead of
+// unconditionally at boot, so a timer wake only pays for what the log cycle
+// actually touches (sensor, clock, and storage when a flush is due). The
+// result is remembered until deep sleep: later calls are free, and a
+// subsystem that failed is not retried during the same wake.
+
+enum Subsystem : uint8_t {
+    SUBSYSTEM_SETTINGS, // NVS (WiFi credentials)
+    SUBSYSTEM_STORAGE,  // LittleFS + datalog migrations
+    SUBSYSTEM_SENSOR,   // DHT
+    SUBSYSTEM_RTC,      // DS3231 over I2C
+    SUBSYSTEM_DISPLAY,  // SSD1306 over I2C
+    SUBSYSTEM_WIFI,     // Radio (the connection itself is made by wifi_manager)
+    SUBSYSTEM_COUNT
+};
+
+/**
+ * @brief Starts the subsystem and its dependencies if not done yet this wake.
+ * @return true if the subsystem is ready to use.
+ */
+bool Subsystem_require(Subsystem id);
+
+/**
+ * @brief True if the subsystem was started successfully this wake.
+ */
+bool Subsystem_isReady(Subsystem id);
+
+/**
+ * @brief Marks a subsystem as stopped (display off, radio off), so the next
+ * Subsystem_require() starts it again.
+ */
+void Subsystem_release(Subsystem id);
+
+const char* Subsystem_getName(Subsystem id);
@@ -1,40 +1,235 @@
 // system_logger.cpp
 
 #include "system_logger.h"
-#include <LittleFS.h>
+#include "log_tokenizer.h"
+#include "hal/hal_fs.h"
+#include "trace.h"
 #include <stdarg.h>
 #include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
 
 #define LOG_TAG "LOGGER"
 
-void Logger_Init() {
+// --- Line Buffer ---
+// Ring of complete entries waiting to be written to flash: '\n' terminated
+// lines, or length-prefixed frames in tokenized mode
+static char s_buffer[LOG_BUFFER_SIZE];
+static size_t s_head = 0;           // Offset of the oldest byte
+static size_t s_count = 0;          // Bytes in use
+static uint32_t s_droppedLines = 0; // Lines lost because the buffer was full
+
+// Guards the buffer: lines come from the main loop and the web server task
+static SemaphoreHandle_t s_mutex = nullptr;
+static TaskHandle_t s_flushTask = nullptr;
+
+static_assert(LOG_BUFFER_SIZE < LOG_SEGMENT_SIZE, "A full buffer must fit in one segment");
+
+// --- Segment Ring ---
+// Kept in RTC memory so timer wakeups never scan the segment files
+RTC_DATA_ATTR static bool s_segmentStateValid = false;
+RTC_DATA_ATTR static uint8_t s_currentSegment = 0;   // Segment being appended to
+RTC_DATA_ATTR static uint32_t s_currentSequence = 0; // Its "#SEG" number
+
+// LittleFS is mounted by the first flush or read, not at boot
+static bool s_storageChecked = false;
+static bool s_storageReady = false;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void segmentPath(uint8_t segment, char* path, size_t len) {
+    snprintf(path, len, LOG_SEGMENT_PATH_FORMAT, (unsigned)segment);
+}
+
+/**
+ * @brief Reads the sequence number from a segment's "#SEG <n>" first line.
+ */
+static bool readSegmentSequence(uint8_t segment, uint32_t& sequence) {
+    char path[24];
+    segmentPath(segment, path, sizeof(path));
+    if (!HalFs().exists(path)) return false;
+
+    File file = HalFs().open(path, "r");
+    if (!file) return false;
+    char line[24];
+    size_t len = file.read(reinterpret_cast<uint8_t*>(line), sizeof(line) - 1);
+    file.close();
+    line[len] = 0;
+
+    unsigned long value;
+    if (sscanf(line, "#SEG %lu", &value) != 1) return false;
+    sequence = (uint32_t)value;
+    return true;
+}
+
+/**
+ * @brief Finds the newest segment after a cold boot (RTC memory lost).
+ */
+static void recoverSegmentState() {
+    if (s_segmentStateValid) return;
+
+    s_currentSegment = 0;
+    s_currentSequence = 0;
+    bool found = false;
+    for (uint8_t i = 0; i < LOG_SEGMENT_COUNT; i++) {
+        uint32_t sequence;
+        if (readSegmentSequence(i, sequence) && (!found || sequence > s_currentSequence)) {
+            s_currentSegment = i;
+            s_currentSequence = sequence;
+            found = true;
+        }
+    }
+    s_segmentStateValid = true;
+}
+
+/**
+ * @brief Truncates a segment and writes its header. Returns the file open for writing.
+ */
+static File startSegment(uint8_t segment, uint32_t sequence) {
+    char path[24];
+    segmentPath(segment, path, sizeof(path));
+    File file = HalFs().open(path, "w");
+    if (file) {
+        file.printf("#SEG %lu\n", (unsigned long)sequence);
+    }
+    return file;
+}
+
+/**
+ * @brief Opens the current segment for appending `incoming` bytes.
+ * Moves on to the next (oldest) segment if they would not fit.
+ */
+static File openSegmentForAppend(size_t incoming) {
+    char path[24];
+    segmentPath(s_currentSegment, path, sizeof(path));
+    if (!HalFs().exists(path)) {
+        return startSegment(s_currentSegment, s_currentSequence);
+    }
+
+    File file = HalFs().open(path, "a");
+    if (!file) return file;
+    if (file.size() + incoming <= LOG_SEGMENT_SIZE) return file;
+
+    // Rotate: recycle the oldest segment in place
+    file.close();
+    uint8_t next = (s_currentSegment + 1) % LOG_SEGMENT_COUNT;
+    File nextFile = startSegment(next, s_currentSequence + 1);
+    if (nextFile) {
+        s_currentSegment = next;
+        s_currentSequence++;
+    }
+    return nextFile;
+}
+
+/**
+ * @brief Mounts LittleFS and locates the current segment, once per wake.
+ * Must hold the lock. Not retried after a failure.
+ */
+static bool mountStorage() {
+    if (s_storageChecked) return s_storageReady;
+    s_storageChecked = true;
+
     // 1. Mount LittleFS (true = format on first use)
-    if (!LittleFS.begin(true)) {
+    TRACE_SCOPE("fs.mount");
+    if (!HalFs_mount(true)) {
         if (Serial) Serial.println("ERR: LittleFS mount failed! Logging to file disabled.");
-        return;
+        return false;
     }
     
-    // 2. File Size Management
-    if (LittleFS.exists(LOG_FILE_PATH)) {
-        File logFile = LittleFS.open(LOG_FILE_PATH, "r");
-        size_t size = 0;
-        
-        if (logFile) {
-            size = logFile.size();
-            logFile.close();
-        }
+    // 2. Locate the current segment (only scans after a cold boot)
+    recoverSegmentState();
 
-        // Reset file if it exceeds the maximum allowed size
-        if (size > MAX_LOG_FILE_SIZE) {
-            LittleFS.remove(LOG_FILE_PATH);
-            if (Serial) Serial.println("\033[33m[WARN] Log file too large. Resetting history.\033[0m");
-            
-            File newFile = LittleFS.open(LOG_FILE_PATH, "w");
-            if (newFile) {
-                newFile.println("--- LOG RESET (Size Limit Reached) ---");
-                newFile.close();
-            }
-        }
+    // 3. Older firmware kept a single file that was deleted when full
+    if (HalFs().exists(LEGACY_LOG_FILE_PATH)) {
+        HalFs().remove(LEGACY_LOG_FILE_PATH);
+    }
+
+    s_storageReady = true;
+    return true;
+}
+
+static void lock() {
+    if (s_mutex) xSemaphoreTake(s_mutex, portMAX_DELAY);
+}
+
+static void unlock() {
+    if (s_mutex) xSemaphoreGive(s_mutex);
+}
+
+/**
+ * @brief Frees space by discarding the oldest buffered entry.
+ */
+static void dropOldestLine() {
+#if SYSTEM_LOG_TOKENIZED
+    size_t frameLen = 1 + (uint8_t)s_buffer[s_head];
+    if (frameLen > s_count) frameLen = s_count;
+    s_head = (s_head + frameLen) % LOG_BUFFER_SIZE;
+    s_count -= frameLen;
+#else
+    while (s_count > 0) {
+        char c = s_buffer[s_head];
+        s_head = (s_head + 1) % LOG_BUFFER_SIZE;
+        s_count--;
+        if (c == '\n') break;
+    }
+#endif
+    s_droppedLines++;
+}
+
+/**
+ * @brief Builds a tokenized frame: [len][token][millis][level][args].
+ * @return Frame size in bytes.
+ */
+static size_t buildFrame(uint8_t* frame, uint32_t token, LogLevel level, const uint8_t* args, size_t argsLen) {
+    uint32_t now = millis();
+    size_t len = 1;
+    memcpy(frame + len, &token, sizeof(token));
+    len += sizeof(token);
+    memcpy(frame + len, &now, sizeof(now));
+    len += sizeof(now);
+    frame[len++] = (uint8_t)level;
+    memcpy(frame + len, args, argsLen);
+    len += argsLen;
+    frame[0] = (uint8_t)(len - 1);
+    return len;
+}
+
+/**
+ * @brief Copies one line into the ring, dropping old lines if needed.
+ */
+static void appendToBuffer(const char* line, size_t len) {
+    if (len > LOG_BUFFER_SIZE) return;
+
+    while (LOG_BUFFER_SIZE - s_count < len) {
+        dropOldestLine();
+    }
+
+    size_t tail = (s_head + s_count) % LOG_BUFFER_SIZE;
+    size_t firstRun = LOG_BUFFER_SIZE - tail;
+    if (firstRun > len) firstRun = len;
+    memcpy(s_buffer + tail, line, firstRun);
+    memcpy(s_buffer, line + firstRun, len - firstRun);
+    s_count += len;
+}
+
+/**
+ * @brief Low-priority task used in interactive mode, where there is no
+ * deep sleep to trigger a flush.
+ */
+static void flushTask(void* param) {
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(LOG_FLUSH_INTERVAL_MS));
+        Logger_Flush();
+    }
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void Logger_Init() {
+    if (!s_mutex) {
+        s_mutex = xSemaphoreCreateMutex();
     }
 }
 
@@ -81,8 +276,14 @@ void Logger_Log(LogLevel level, const char* tag, const char* format, ...) {
 
     // 4. Create a clean string for the FILE (No ANSI color codes!)
     char fileLogLine[350];
-    snprintf(fileLogLine, sizeof(fileLogLine), "[%02lu:%02lu:%02lu.%03lu] [%s] [%s] %s", 
-             hours, mins, secs, ms, levelStr, tag, msgBuffer);
+    int lineLen = snprintf(fileLogLine, sizeof(fileLogLine), "[%02lu:%02lu:%02lu.%03lu] [%s] [%s] %s\n", 
+                           hours, mins, secs, ms, levelStr, tag, msgBuffer);
+    if (lineLen < 0) return;
+    if ((size_t)lineLen >= sizeof(fileLogLine)) {
+        // Truncated: keep the line terminator
+        lineLen = sizeof(fileLogLine) - 1;
+        fileLogLine[lineLen - 1] = '\n';
+    }
 
     // 5. Print to Serial WITH colors
     if (Serial) {
@@ -90,33 +291,142 @@ void Logger_Log(LogLevel level, const char* tag, const char* format, ...) {
                       hours, mins, secs, ms, colorCode, levelStr, tag, msgBuffer);
     }
 
-    // 6. Write to Flash Memory (LittleFS)
-    File logFile = LittleFS.open(LOG_FILE_PATH, "a");
-    if (logFile) {
-        logFile.println(fileLogLine);
-        logFile.close();
+    // 6. Queue for Flash Memory (LittleFS). Tokenized mode only stores frames.
+#if !SYSTEM_LOG_TOKENIZED
+    lock();
+    appendToBuffer(fileLogLine, (size_t)lineLen);
+    bool flushNow = (level == LogLevel::Error) || (s_count >= LOG_FLUSH_THRESHOLD);
+    unlock();
+
+    // Errors are written through so they survive a crash right after
+    if (flushNow) {
+        Logger_Flush();
     }
+#endif
 }
 
-void Logger_DumpToSerial() {
-    if (!LittleFS.exists(LOG_FILE_PATH)) {
-        if (Serial) Serial.println("--- No Log File Found ---");
-        return;
+void Logger_LogTokenized(LogLevel level, const char* token, const uint8_t* args, size_t argsLen) {
+    uint8_t frame[10 + LogTokenizer::MAX_ARGS_SIZE];
+    size_t len = buildFrame(frame, (uint32_t)(uintptr_t)token, level, args, argsLen);
+
+    lock();
+    appendToBuffer(reinterpret_cast<const char*>(frame), len);
+    bool flushNow = (level == LogLevel::Error) || (s_count >= LOG_FLUSH_THRESHOLD);
+    unlock();
+
+    if (flushNow) {
+        Logger_Flush();
     }
+}
 
-    File logFile = LittleFS.open(LOG_FILE_PATH, "r");
-    if (!logFile) return;
+bool Logger_Flush() {
+    lock();
 
-    if (Serial) {
-        Serial.println("\n--- READING SYSTEM LOG FROM FLASH ---");
-        while (logFile.available()) {
-            Serial.write(logFile.read());
-        }
-        Serial.println("--- END OF LOG ---\n");
-        
-        // From RTC logic: Ensure terminal colors are reset and buffer is clear
-        Serial.print("\033[0m"); 
-        Serial.flush(); 
+    if (s_count == 0 && s_droppedLines == 0) {
+        unlock();
+        return true;
+    }
+
+    TRACE_SCOPE("log.flush"); // Only real writes: idle background checks would flood the ring
+
+    if (!mountStorage()) {
+        unlock(); // Keep the lines in RAM (shown on Serial anyway)
+        return false;
+    }
+
+    File logFile = openSegmentForAppend(s_count + 64); // 64: room for the dropped-lines note
+    if (!logFile) {
+        unlock(); // Flash busy or not mounted: keep the lines for the next attempt
+        return false;
+    }
+
+    if (s_droppedLines > 0) {
+#if SYSTEM_LOG_TOKENIZED
+        LogTokenizer::ArgWriter w;
+        w.putSigned(s_droppedLines);
+        uint8_t frame[10 + LogTokenizer::MAX_ARGS_SIZE];
+        size_t len = buildFrame(frame, LogTokenizer::TOKEN_DROPPED, LogLevel::Warn, w.buffer, w.len);
+        logFile.write(frame, len);
+#else
+        logFile.printf("--- %lu log lines dropped (buffer full) ---\n", (unsigned long)s_droppedLines);
+#endif
+        s_droppedLines = 0;
+    }
+
+    // The ring may wrap, so write it as (up to) two contiguous runs
+    size_t firstRun = LOG_BUFFER_SIZE - s_head;
+    if (firstRun > s_count) firstRun = s_count;
+    size_t written = logFile.write(reinterpret_cast<const uint8_t*>(s_buffer + s_head), firstRun);
+    if (written == firstRun && s_count > firstRun) {
+        written += logFile.write(reinterpret_cast<const uint8_t*>(s_buffer), s_count - firstRun);
     }
     logFile.close();
+
+    // Whatever did not make it stays buffered
+    s_head = (s_head + written) % LOG_BUFFER_SIZE;
+    s_count -= written;
+    bool ok = (s_count == 0);
+
+    unlock();
+    return ok;
+}
+
+void Logger_StartBackgroundFlush() {
+    if (s_flushTask) return;
+    xTaskCreate(flushTask, "log_flush", 3072, nullptr, 1, &s_flushTask);
+}
+
+size_t Logger_ReadLog(LogReadCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    lock(); // Keeps a flush from recycling the segment being read
+    if (!mountStorage()) {
+        unlock();
+        return 0;
+    }
+
+    // Oldest segment is the one after the current segment
+    while (cursor.segment < LOG_SEGMENT_COUNT) {
+        uint8_t segment = (s_currentSegment + 1 + cursor.segment) % LOG_SEGMENT_COUNT;
+        char path[24];
+        segmentPath(segment, path, sizeof(path));
+
+        size_t read = 0;
+        if (HalFs().exists(path)) {
+            File file = HalFs().open(path, "r");
+            if (file) {
+                file.seek(cursor.offset);
+                read = file.read(buffer, maxLen);
+                file.close();
+            }
+        }
+        if (read > 0) {
+            cursor.offset += read;
+            unlock();
+            return read;
+        }
+
+        // Segment done (or never written): continue with the next one
+        cursor.segment++;
+        cursor.offset = 0;
+    }
+    unlock();
+    return 0;
+}
+
+void Logger_DumpToSerial() {
+    Logger_Flush();
+
+    if (!Serial) return;
+
+    Serial.println("\n--- READING SYSTEM LOG FROM FLASH ---");
+    LogReadCursor cursor;
+    uint8_t chunk[128];
+    size_t len;
+    while ((len = Logger_ReadLog(cursor, chunk, sizeof(chunk))) > 0) {
+        Serial.write(chunk, len);
+    }
+    Serial.println("--- END OF LOG ---\n");
+
+    // From RTC logic: Ensure terminal colors are reset and buffer is clear
+    Serial.print("\033[0m"); 
+    Serial.flush(); 
 }
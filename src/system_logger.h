@@ -13,14 +13,32 @@
 #ifndef SYSTEM_LOG_LEVEL
     #define SYSTEM_LOG_LEVEL _LOG_LVL_INFO
 #endif
+#ifndef SYSTEM_LOG_TOKENIZED
+    #define SYSTEM_LOG_TOKENIZED 0
+#endif
 
 // --- Configuration ---
-// The path to the log file in LittleFS
-#define LOG_FILE_PATH "/system.log"
+// The log is split into LOG_SEGMENT_COUNT segment files used as a ring.
+// Each segment starts with a "#SEG <sequence>" line. The current segment is
+// kept in RTC memory; after a cold boot it is found by reading those lines.
+// When the current segment is full, the oldest one is truncated and reused,
+// so flash use is bounded and rotation never deletes the whole history.
+// 4 x 8KB is roughly 500-600 lines of logs.
+#define LOG_SEGMENT_COUNT 4
+#define LOG_SEGMENT_SIZE 8192
+#define LOG_SEGMENT_PATH_FORMAT "/syslog%u.log"
+
+// Single-file log used by older firmware, removed on first boot
+#define LEGACY_LOG_FILE_PATH "/system.log"
 
-// Max size of the log file in bytes before we reset it.
-// 20KB is roughly 300-400 lines of logs.
-#define MAX_LOG_FILE_SIZE 20000
+// Lines are formatted into a RAM ring buffer and written to flash in one
+// append when it passes the threshold, on ERROR, before deep sleep and
+// periodically from a background task in interactive mode.
+// If the file cannot be opened the lines stay buffered; when the buffer is
+// full the oldest lines are dropped (and counted).
+#define LOG_BUFFER_SIZE 4096
+#define LOG_FLUSH_THRESHOLD 3072
+#define LOG_FLUSH_INTERVAL_MS 2000
 
 // C++ Enum for Type Safety in function calls
 enum class LogLevel {
@@ -35,31 +53,58 @@ enum class LogLevel {
 void Logger_Init();
 void Logger_Log(LogLevel level, const char* tag, const char* format, ...);
 
+// Writes buffered lines to the log file. Returns false if they stay buffered.
+// Call before anything that loses RAM (deep sleep, restart).
+bool Logger_Flush();
+
+// Starts a low-priority task that flushes every LOG_FLUSH_INTERVAL_MS.
+// Used while awake in interactive mode; safe to call more than once.
+void Logger_StartBackgroundFlush();
+
+// Position in the segmented log while reading it oldest to newest
+struct LogReadCursor {
+    uint8_t segment = 0; // 0 = oldest segment
+    size_t offset = 0;   // Byte offset within that segment
+};
+
+// Copies the next part of the log into buffer, crossing segment
+// boundaries. Returns 0 at the end of the log. In tokenized mode the
+// content is binary (decode with tools/decode_log.py).
+size_t Logger_ReadLog(LogReadCursor& cursor, uint8_t* buffer, size_t maxLen);
+
 // Helper to dump the file content to Serial (optional debugging)
 void Logger_DumpToSerial();
 
+// Text mode formats on the device; tokenized mode stores the call site's
+// token and raw arguments (see log_tokenizer.h)
+#if SYSTEM_LOG_TOKENIZED
+    #include "log_tokenizer.h"
+    #define LOG_EMIT_(level, tag, ...) LOG_TOKENIZED_(level, tag, __VA_ARGS__)
+#else
+    #define LOG_EMIT_(level, tag, ...) Logger_Log(level, tag, __VA_ARGS__)
+#endif
+
 // Macros use the Defines
 #if SYSTEM_LOG_LEVEL >= _LOG_LVL_ERROR
-    // Note: We cast the enum to pass it to the function
-    #define LOG_ERROR(tag, ...) Logger_Log(LogLevel::Error, tag, __VA_ARGS__)
+    #define LOG_ERROR(tag, ...) LOG_EMIT_(LogLevel::Error, tag, __VA_ARGS__)
 #else
     #define LOG_ERROR(tag, ...) 
 #endif
 
 #if SYSTEM_LOG_LEVEL >= _LOG_LVL_WARN
-    #define LOG_WARN(tag, ...)  Logger_Log(LogLevel::Warn,  tag, __VA_ARGS__)
+    #define LOG_WARN(tag, ...)  LOG_EMIT_(LogLevel::Warn,  tag, __VA_ARGS__)
 #else
     #define LOG_WARN(tag, ...) 
 #endif
 
 #if SYSTEM_LOG_LEVEL >= _LOG_LVL_INFO
-    #define LOG_INFO(tag, ...)  Logger_Log(LogLevel::Info,  tag, __VA_ARGS__)
+    #define LOG_INFO(tag, ...)  LOG_EMIT_(LogLevel::Info,  tag, __VA_ARGS__)
 #else
     #define LOG_INFO(tag, ...) 
 #endif
 
 #if SYSTEM_LOG_LEVEL >= _LOG_LVL_DEBUG
-    #define LOG_DEBUG(tag, ...) Logger_Log(LogLevel::Debug, tag, __VA_ARGS__)
+    #define LOG_DEBUG(tag, ...) LOG_EMIT_(LogLevel::Debug, tag, __VA_ARGS__)
 #else
     #define LOG_DEBUG(tag, ...) 
 #endif
@@ -5,10 +5,53 @@
 #include "wifi_manager.h" 
 #include "system_logger.h"
 #include "config.h"
-#include <sys/time.h> // For settimeofday
+#include "hal/hal_clock.h"
+#include "hal/hal_wifi.h"
+#include "subsystem.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
+#include "scheduler.h"
+#include "data_logger.h" // Provisional samples are resolved once time is trusted
+#include "trace.h"
+#include <atomic>
+#include <cmath>
 
 #define LOG_TAG "TIME"
 
+// Timer wakes since the last NTP attempt (survives deep sleep)
+RTC_DATA_ATTR static uint8_t s_timerWakesSinceNtp = 0;
+
+// NTP resync policy and DS3231 drift (survive deep sleep, not power loss)
+RTC_DATA_ATTR static uint32_t s_lastNtpSyncEpoch = 0;   // 0 = none since power-on
+RTC_DATA_ATTR static bool s_lastNtpFailed = false;
+RTC_DATA_ATTR static uint32_t s_rtcBaseEpoch = 0;       // DS3231 drift baseline, 0 = none
+RTC_DATA_ATTR static int32_t s_rtcBaseOffsetMs = 0;     // NTP - DS3231 at the baseline
+RTC_DATA_ATTR static float s_rtcDriftPpm = 0.0f;
+RTC_DATA_ATTR static bool s_rtcDriftKnown = false;
+
+// Background NTP sync (this wake only)
+enum NtpSyncState : uint8_t {
+    NTP_SYNC_IDLE,
+    NTP_SYNC_WAIT_STATION, // Handler registered, station not up yet
+    NTP_SYNC_WAIT_REPLY,   // SNTP running
+    NTP_SYNC_DONE          // Own radio: got the reply, nothing left to do
+};
+static NtpSyncState s_syncState = NTP_SYNC_IDLE;
+static bool s_syncOwnsRadio = false;
+static unsigned long s_syncStartMs = 0;
+static bool s_timeFromExternalRtc = false; // This wake's clock came from the DS3231
+
+// Written by the WiFi event / network tasks, consumed by the main task
+static std::atomic<bool> s_stationUp{false};
+static std::atomic<bool> s_replyReady{false};
+static int64_t s_replyOffsetUs = 0; // Server time - system clock, valid once s_replyReady
+
+// Slow clock drift (see TimeManager_getSlowClockDriftPpm()). The reference
+// is the last DS3231 sync: wall time and RTC timer read together.
+RTC_DATA_ATTR static uint32_t s_driftRefEpoch = 0;   // 0 = no reference
+RTC_DATA_ATTR static uint64_t s_driftRefRtcUs = 0;
+RTC_DATA_ATTR static float s_slowClockDriftPpm = 0.0f;
+RTC_DATA_ATTR static bool s_slowClockDriftKnown = false;
+
 // --- PRIVATE HELPER FUNCTIONS ---
 
 /**
@@ -21,27 +64,143 @@ static bool isValidYear(const struct tm *t) {
 }
 
 /**
- * @brief Performs the NTP synchronization sequence.
- * Assumes WiFi is already connected.
+ * @brief Reads the system clock as local time.
+ * Same check as getLocalTime() (year > 2016), but returns at once when the
+ * clock is not set instead of polling it for 5 seconds.
  */
-static bool performNtpSync() {
-    LOG_INFO(LOG_TAG, "Configuring NTP (Server: %s)...", NTP_SERVER);
-    
-    // Trigger the background NTP sync using ESP32 native function
-    ::configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER);
-    
-    unsigned long start = ::millis();
-    LOG_INFO(LOG_TAG, "Waiting for NTP time sync...");
-    
-    // Wait until the system time becomes valid
-    while (!TimeManager_isTimeSet()) {
-        if (::millis() - start > NTP_TIMEOUT_MS) {
-            LOG_ERROR(LOG_TAG, "NTP Sync Timeout!");
-            return false;
+static bool readLocalTime(struct tm *timeinfo) {
+    time_t now = HalClock_getEpoch();
+    if (::localtime_r(&now, timeinfo) == nullptr) return false;
+    return timeinfo->tm_year > (2016 - 1900);
+}
+
+/**
+ * @brief WiFi event task: the station got an IP address.
+ */
+static void onStationUp_internal() {
+    s_stationUp = true;
+    Scheduler_post(EVENT_TIME_SYNC); // Interactive: handled at once; otherwise polled
+}
+
+/**
+ * @brief Network task: an SNTP reply arrived. Only the offset is taken here;
+ * the clocks are corrected on the main task.
+ */
+static void onSntpReply_internal(int64_t serverEpochUs) {
+    s_replyOffsetUs = serverEpochUs - HalClock_getEpochMicros();
+    s_replyReady = true;
+    Scheduler_post(EVENT_TIME_SYNC);
+}
+
+/**
+ * @brief Writes the true time (system clock + correctionUs) to the DS3231.
+ * The DS3231 restarts its seconds countdown when written, so the write
+ * waits for the next second boundary (up to 1 s) to avoid a built-in error.
+ */
+static void writeExternalRtc_internal(int64_t correctionUs) {
+    int64_t trueUs = HalClock_getEpochMicros() + correctionUs;
+    uint32_t waitUs = 1000000UL - (uint32_t)(trueUs % 1000000LL);
+    ::delay(waitUs / 1000);
+    ::delayMicroseconds(waitUs % 1000);
+
+    time_t second = (time_t)((trueUs + waitUs) / 1000000LL);
+    struct tm t;
+    ::localtime_r(&second, &t);
+    RTCManager.setTime(t);
+
+    s_rtcBaseEpoch = (uint32_t)second;
+    s_rtcBaseOffsetMs = 0;
+    s_driftRefEpoch = 0; // Stepped: restart the slow clock measurement
+}
+
+/**
+ * @brief Applies an NTP offset (server time - system clock).
+ * 1. System clock: slewed when it was already set and the offset is within
+ *    NTP_SLEW_MAX_MS, so logged timestamps never jump; stepped otherwise.
+ * 2. DS3231 drift: while the DS3231 sets the clock on every wake, the offset
+ *    is the DS3231's own error. Compared with the baseline (last write or
+ *    first sync) over at least NTP_RTC_DRIFT_MIN_SPAN_S it gives the drift.
+ * 3. DS3231: written only if it was not the clock source (lost power) or is
+ *    off by NTP_RTC_UPDATE_THRESHOLD_MS. Each write costs it a sub-second
+ *    error, so small offsets are left alone.
+ */
+static void applyNetworkTime_internal(int64_t offsetUs) {
+    TRACE_SCOPE("ntp.apply");
+    bool wasSet = TimeManager_isTimeSet();
+    int64_t offsetMs = offsetUs / 1000;
+
+    // 1. System clock
+    if (wasSet && llabs(offsetUs) <= (int64_t)NTP_SLEW_MAX_MS * 1000LL) {
+        HalClock_slew(offsetUs);
+        LOG_INFO(LOG_TAG, "NTP offset %+lld ms. Slewing the system clock.", (long long)offsetMs);
+    } else {
+        HalClock_setEpochMicros(HalClock_getEpochMicros() + offsetUs);
+        offsetUs = 0; // Nothing left to correct
+        LOG_INFO(LOG_TAG, "NTP offset %+lld ms. System clock stepped.", (long long)offsetMs);
+    }
+    uint32_t now = (uint32_t)((HalClock_getEpochMicros() + offsetUs) / 1000000LL);
+
+    // 2. DS3231 drift
+    if (s_timeFromExternalRtc) {
+        if (s_rtcBaseEpoch == 0) {
+            s_rtcBaseEpoch = now;
+            s_rtcBaseOffsetMs = (int32_t)offsetMs;
+        } else if (now - s_rtcBaseEpoch >= NTP_RTC_DRIFT_MIN_SPAN_S) {
+            // ms per s = 1000 ppm
+            float ppm = (float)(offsetMs - s_rtcBaseOffsetMs) * 1000.0f / (float)(now - s_rtcBaseEpoch);
+            s_rtcDriftPpm = ppm;
+            s_rtcDriftKnown = true;
+            LOG_INFO(LOG_TAG, "DS3231 drift: %.1f ppm over %lu h.", ppm,
+                     (unsigned long)((now - s_rtcBaseEpoch) / 3600UL));
         }
-        ::delay(100);
     }
-    return true;
+
+    // 3. DS3231
+    if (Subsystem_require(SUBSYSTEM_RTC)) {
+        if (!s_timeFromExternalRtc || llabs(offsetMs) >= (int64_t)NTP_RTC_UPDATE_THRESHOLD_MS) {
+            writeExternalRtc_internal(offsetUs);
+            LOG_INFO(LOG_TAG, "External RTC updated from NTP.");
+        }
+    }
+
+    s_lastNtpSyncEpoch = now;
+    s_lastNtpFailed = false;
+
+    if (!wasSet) DataLogger_resolveProvisional();
+}
+
+/**
+ * @brief Compares the RTC timer with the DS3231 since the previous sync.
+ * The DS3231 reads whole seconds, so a short span is mostly quantization:
+ * spans under SLEEP_DRIFT_MIN_SPAN_S keep the old reference and wait for a
+ * longer one. Implausible rates (clock stepped, RTC timer reset) restart
+ * the measurement instead of polluting the estimate.
+ */
+static void measureSlowClockDrift(time_t epoch) {
+    uint64_t rtcUs = HalClock_getRtcMicros();
+
+    if (s_driftRefEpoch != 0 && (uint32_t)epoch > s_driftRefEpoch && rtcUs > s_driftRefRtcUs) {
+        uint32_t spanS = (uint32_t)epoch - s_driftRefEpoch;
+        if (spanS < SLEEP_DRIFT_MIN_SPAN_S) return;
+
+        int64_t rtcSpanUs = (int64_t)(rtcUs - s_driftRefRtcUs);
+        int64_t wallSpanUs = (int64_t)spanS * 1000000LL;
+        float ppm = (float)(wallSpanUs - rtcSpanUs) * 1e6f / (float)rtcSpanUs;
+
+        if (fabsf(ppm) <= SLEEP_DRIFT_MAX_PPM) {
+            s_slowClockDriftPpm = s_slowClockDriftKnown
+                ? s_slowClockDriftPpm + SLEEP_DRIFT_FILTER_ALPHA * (ppm - s_slowClockDriftPpm)
+                : ppm;
+            s_slowClockDriftKnown = true;
+            LOG_INFO(LOG_TAG, "Slow clock drift: %.0f ppm over %lu s (filtered %.0f ppm).", ppm,
+                     (unsigned long)spanS, s_slowClockDriftPpm);
+        } else {
+            LOG_WARN(LOG_TAG, "Slow clock drift of %.0f ppm is implausible. Restarting measurement.", ppm);
+        }
+    }
+
+    s_driftRefEpoch = (uint32_t)epoch;
+    s_driftRefRtcUs = rtcUs;
 }
 
 // --- PUBLIC FUNCTIONS ---
@@ -51,10 +210,9 @@ void TimeManager_setTime(struct tm t, bool updateRTC) {
     // 1. Always update Internal ESP32 System Clock
     // Convert struct tm to time_t (seconds since epoch)
     time_t timeVal = ::mktime(&t);
-    struct timeval tv = { timeVal, 0 };
     
     // Apply to OS
-    ::settimeofday(&tv, NULL);
+    HalClock_setEpoch(timeVal);
     
     LOG_INFO(LOG_TAG, "Internal System Clock set.");
 
@@ -62,33 +220,53 @@ void TimeManager_setTime(struct tm t, bool updateRTC) {
     // We only write to RTC when the source is external (NTP or Web).
     // Writing to RTC constantly (reading then writing back) resets the 
     // internal prescaler, causing the clock to drift/lag over time.
+    // The write waits for a second boundary and the fix-up below rewrites
+    // log records, so both run on the main task (EVENT_TIME_SET).
     if (updateRTC) {
-        if (RTCManager.isRunning()) {
-            RTCManager.setTime(t);
-            // RTCManager handles its own success logging
-        } else {
-            LOG_WARN(LOG_TAG, "Cannot update External RTC (Not found).");
+        if (!Scheduler_post(EVENT_TIME_SET)) {
+            LOG_WARN(LOG_TAG, "Event queue full. External RTC not updated.");
         }
+        return;
     }
+
+    // 3. Samples logged without trusted time can be dated now
+    DataLogger_resolveProvisional();
+}
+
+void TimeManager_serviceTimeSet() {
+    TRACE_SCOPE("time.set");
+
+    // 1. Stepped: the next span would measure the step, not the drift
+    s_driftRefEpoch = 0;
+
+    // 2. External RTC
+    if (RTCManager.isRunning()) {
+        writeExternalRtc_internal(0);
+        s_rtcBaseEpoch = 0; // Set by hand, not a drift baseline
+        // RTCManager handles its own success logging
+    } else {
+        LOG_WARN(LOG_TAG, "Cannot update External RTC (Not found).");
+    }
+
+    // 3. Samples logged without trusted time can be dated now
+    DataLogger_resolveProvisional();
 }
 
 bool TimeManager_isTimeSet() {
     struct tm timeinfo;
-    if (!::getLocalTime(&timeinfo)) return false;
+    if (!readLocalTime(&timeinfo)) return false;
     // Reuse centralized validation logic
     return isValidYear(&timeinfo);
 }
 
 bool TimeManager_startAndSync() {
     struct tm timeinfo;
-    bool rtcFound = false;
 
     // --- PRIORITY 1: EXTERNAL RTC (The Master Clock) ---
     // DS3231 is a TCXO (Temperature Compensated) and is highly accurate.
     // We always attempt to sync from it first to correct any drift 
     // in the ESP32's internal RC oscillator.
-    if (RTCManager.begin()) {
-        rtcFound = true;
+    if (Subsystem_require(SUBSYSTEM_RTC)) {
         if (RTCManager.getTime(timeinfo)) {
             if (isValidYear(&timeinfo)) {
                 LOG_INFO(LOG_TAG, "Syncing system time from External RTC.");
@@ -96,6 +274,8 @@ bool TimeManager_startAndSync() {
                 // IMPORTANT: Pass 'false' to prevent writing back to RTC.
                 // This avoids the "prescaler reset" drift issue.
                 TimeManager_setTime(timeinfo, false); 
+                measureSlowClockDrift(HalClock_getEpoch());
+                s_timeFromExternalRtc = true;
                 
                 return true; 
             } else {
@@ -114,41 +294,126 @@ bool TimeManager_startAndSync() {
          return true; 
     }
 
-    // --- PRIORITY 3: NTP (Last Resort) ---
-    // Neither RTC nor Internal clock is valid. We must connect to WiFi.
-    LOG_WARN(LOG_TAG, "No valid time source. Starting WiFi for NTP...");
-    
-    if (wifi_manager_connect_STA()) {
-        if (performNtpSync()) {
-            LOG_INFO(LOG_TAG, "NTP Sync Success.");
-            
-            // Now that internal time is correct (thanks to NTP),
-            // we grab it and push it through our Master Function.
-            if (::getLocalTime(&timeinfo)) {
-                // Pass 'true' because we WANT to save this fresh network time 
-                // to the External RTC for future boot cycles.
-                if (rtcFound) {
-                    TimeManager_setTime(timeinfo, true);
-                    LOG_INFO(LOG_TAG, "Time synced and saved to External RTC.");
-                }
-            }
-            
+    // NTP is not waited for here: it runs in the background once a station
+    // connects (see TimeManager_startNetworkSync()).
+    LOG_ERROR(LOG_TAG, "CRITICAL: No valid time source.");
+    return false;
+}
+
+bool TimeManager_isNetworkSyncDue(bool timerWake) {
+    bool due = !TimeManager_isTimeSet() || s_lastNtpSyncEpoch == 0 ||
+               (uint32_t)HalClock_getEpoch() - s_lastNtpSyncEpoch >= NTP_RESYNC_INTERVAL_S;
+    if (!due) return false;
+
+    // After a failed attempt (no network, no reply), timer wakes retry only
+    // every Nth time instead of paying for the radio on every wake
+    if (timerWake && s_lastNtpFailed && ++s_timerWakesSinceNtp < NTP_RETRY_EVERY_N_TIMER_WAKES) {
+        LOG_DEBUG(LOG_TAG, "NTP retry in %u timer wakes.",
+                  (unsigned)(NTP_RETRY_EVERY_N_TIMER_WAKES - s_timerWakesSinceNtp));
+        return false;
+    }
+    s_timerWakesSinceNtp = 0;
+    return true;
+}
+
+void TimeManager_startNetworkSync(bool ownRadio) {
+    if (s_syncState != NTP_SYNC_IDLE) return;
+
+    // No network configured: not an attempt, and nothing to wait for
+    if (ownRadio && !wifi_manager_has_credentials()) {
+        LOG_DEBUG(LOG_TAG, "No SSID configured. Skipping NTP sync.");
+        return;
+    }
+
+    s_syncOwnsRadio = ownRadio;
+    s_syncStartMs = ::millis();
+    s_stationUp = false;
+    s_replyReady = false;
+    s_syncState = NTP_SYNC_WAIT_STATION;
+    HalWifi_setStationHandler(onStationUp_internal);
+
+    if (ownRadio) {
+        LOG_INFO(LOG_TAG, "Starting background NTP sync.");
+        if (!wifi_manager_begin_STA()) {
+            // Not a failed sync either: back to idle without waiting
+            HalWifi_setStationHandler(nullptr);
             wifi_manager_turnOff();
-            return true;
+            s_syncState = NTP_SYNC_IDLE;
+            return;
         }
-        wifi_manager_turnOff();
     }
+    if (HalWifi_isConnected()) s_stationUp = true;
+    TimeManager_serviceNetworkSync();
+}
 
-    LOG_ERROR(LOG_TAG, "CRITICAL: Failed to synchronize time.");
-    return false;
+void TimeManager_serviceNetworkSync() {
+    if (s_syncState == NTP_SYNC_WAIT_STATION && s_stationUp) {
+        LOG_INFO(LOG_TAG, "Station up. Starting SNTP (Server: %s)...", NTP_SERVER);
+        HalWifi_startSntp(NTP_SERVER, GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, onSntpReply_internal);
+        s_syncState = NTP_SYNC_WAIT_REPLY;
+    }
+
+    // Interactive: SNTP keeps polling, every reply is applied
+    if (s_syncState == NTP_SYNC_WAIT_REPLY && s_replyReady.exchange(false)) {
+        applyNetworkTime_internal(s_replyOffsetUs);
+        if (s_syncOwnsRadio) s_syncState = NTP_SYNC_DONE;
+    }
 }
 
-String getFormattedTime() {
-    struct tm timeinfo;
-    if (!::getLocalTime(&timeinfo)) {
-        return "Time Not Set";
+void TimeManager_finishNetworkSync() {
+    if (s_syncState == NTP_SYNC_IDLE) return;
+
+    if (s_syncOwnsRadio) {
+        // Whatever is left of NTP_TIMEOUT_MS; the sample was taken meanwhile
+        TRACE_SCOPE("ntp.wait");
+        while (s_syncState != NTP_SYNC_DONE && ::millis() - s_syncStartMs < NTP_TIMEOUT_MS) {
+            ::delay(100);
+            TimeManager_serviceNetworkSync();
+        }
     }
+
+    if (s_syncOwnsRadio) {
+        s_lastNtpFailed = (s_syncState != NTP_SYNC_DONE);
+        if (s_lastNtpFailed) LOG_WARN(LOG_TAG, "NTP sync did not complete.");
+        if (s_lastNtpFailed && HalWifi_isConnected()) wifi_manager_forget_lease(); // Connected, yet no reply
+    }
+
+    HalWifi_setStationHandler(nullptr);
+    if (s_syncOwnsRadio) wifi_manager_turnOff();
+    s_syncState = NTP_SYNC_IDLE;
+}
+
+bool TimeManager_isNetworkSyncActive() {
+    return s_syncState != NTP_SYNC_IDLE;
+}
+
+int32_t TimeManager_getSlowClockDriftPpm() {
+    return s_slowClockDriftKnown ? (int32_t)lroundf(s_slowClockDriftPpm) : 0;
+}
+
+uint32_t TimeManager_getLastNtpSyncEpoch() {
+    return s_lastNtpSyncEpoch;
+}
+
+int32_t TimeManager_getExternalRtcDriftPpm() {
+    return s_rtcDriftKnown ? (int32_t)lroundf(s_rtcDriftPpm) : 0;
+}
+
+String getFormattedTime() {
     char timeStr[30];
-    ::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", &timeinfo);
+    TimeManager_formatTime(timeStr, sizeof(timeStr));
     return String(timeStr);
 }
+
+size_t TimeManager_formatTime(char* out, size_t size) {
+    if (size == 0) return 0;
+    struct tm timeinfo;
+    if (!readLocalTime(&timeinfo)) {
+        strncpy(out, "Time Not Set", size);
+        out[size - 1] = '\0';
+        return strlen(out);
+    }
+    size_t len = ::strftime(out, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
+    if (len == 0) out[0] = '\0';
+    return len;
+}
@@ -8,27 +8,99 @@
  * Priority: 
  * 1. External RTC (DS3231) - Most accurate.
  * 2. Internal ESP32 Clock - If valid (survived Deep Sleep).
- * 3. NTP (WiFi) - Fallback if hardware clocks are invalid.
+ * Never touches the network: NTP runs in the background (see below).
  * * @return true if valid time is set, false otherwise.
  */
 bool TimeManager_startAndSync();
 
+// --- Background NTP ---
+// SNTP starts whenever the station connects and never blocks a state.
+// Replies are applied on the main task: small offsets are slewed, large
+// ones stepped, and the DS3231 is only rewritten when it is off by more
+// than NTP_RTC_UPDATE_THRESHOLD_MS. Interactive sessions sync whenever the
+// station is up; timer wakes bring the radio up only when a sync is due
+// (TimeManager_isNetworkSyncDue()), overlapping it with the sample.
+
+/**
+ * @brief true if the clock is not set, no NTP sync happened since power-on,
+ * or the last one is NTP_RESYNC_INTERVAL_S ago. After a failed attempt,
+ * timer wakes only retry every NTP_RETRY_EVERY_N_TIMER_WAKES wakes.
+ */
+bool TimeManager_isNetworkSyncDue(bool timerWake);
+
+/**
+ * @brief Starts a background NTP sync; SNTP begins once the station is up.
+ * @param ownRadio Timer wake: bring the station up here (without waiting),
+ * and take it down again in TimeManager_finishNetworkSync().
+ */
+void TimeManager_startNetworkSync(bool ownRadio);
+
+/**
+ * @brief Advances the sync (main task). Call on EVENT_TIME_SYNC, which the
+ * station and SNTP handlers post.
+ */
+void TimeManager_serviceNetworkSync();
+
+/**
+ * @brief Ends the sync before sleep. With its own radio it first waits for
+ * the reply for whatever is left of NTP_TIMEOUT_MS since the start.
+ */
+void TimeManager_finishNetworkSync();
+
+/**
+ * @brief True between TimeManager_startNetworkSync() and the end of the sync.
+ */
+bool TimeManager_isNetworkSyncActive();
+
+/**
+ * @brief Epoch of the last applied NTP reply, 0 if none since power-on.
+ */
+uint32_t TimeManager_getLastNtpSyncEpoch();
+
+/**
+ * @brief DS3231 drift measured by NTP over at least NTP_RTC_DRIFT_MIN_SPAN_S
+ * (ppm, positive = DS3231 slow). 0 until known.
+ */
+int32_t TimeManager_getExternalRtcDriftPpm();
+
 /**
  * @brief Master function to set the system time.
  * Updates the internal ESP32 clock and conditionally updates the External RTC.
  * * @param t The time structure containing the new time.
  * @param updateRTC If true, the time is also written to the External RTC (DS3231).
  * Set this to 'false' if the time originated FROM the RTC (to prevent drift).
- * Default is 'true' (e.g. for Web/NTP updates).
+ * Default is 'true' (e.g. for Web/NTP updates): safe from any task, as the
+ * RTC write and the log fix-up are left to TimeManager_serviceTimeSet().
  */
 void TimeManager_setTime(struct tm t, bool updateRTC = true);
 
+/**
+ * @brief Finishes TimeManager_setTime(t, true) on the main task: writes the
+ * DS3231 and dates provisional samples. Call on EVENT_TIME_SET.
+ */
+void TimeManager_serviceTimeSet();
+
 /**
  * @brief Get current time as a formatted String (YYYY-MM-DD HH:MM:SS).
  */
 String getFormattedTime();
 
+/**
+ * @brief Same as getFormattedTime(), into a caller buffer ("Time Not Set" if unknown).
+ * @return Length written.
+ */
+size_t TimeManager_formatTime(char* out, size_t size);
+
 /**
  * @brief Checks if the current system time is valid (Year > 2024).
  */
 bool TimeManager_isTimeSet();
+
+/**
+ * @brief Measured rate of the RTC timer (HalClock_getRtcMicros(), the RC
+ * slow clock that times deep sleep) against the DS3231, in ppm.
+ * Positive: the slow clock runs slow, so wall time passes faster than it counts.
+ * Each sync from the DS3231 compares both clocks over the span since the
+ * previous one and folds the result into a filtered estimate. 0 until known.
+ */
+int32_t TimeManager_getSlowClockDriftPpm();
@@ -0,0 +1,177 @@
+// trace.cpp
+
+#include "trace.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+struct TraceEvent {
+    const char* name;
+    uint32_t startUs;
+    uint32_t durationUs;
+    uint8_t thread;      // Index into s_threads
+};
+
+struct TraceThread {
+    TaskHandle_t handle;
+    const char* name;
+};
+
+static TraceEvent s_events[TRACE_RING_SIZE];
+static uint32_t s_total = 0; // Events recorded since boot; the ring holds the last TRACE_RING_SIZE
+
+static TraceThread s_threads[TRACE_MAX_THREADS];
+static uint8_t s_threadCount = 0;
+
+// Guards the ring: events come from the main loop and the web server task
+static SemaphoreHandle_t s_mutex = nullptr;
+
+enum TraceStage : uint8_t {
+    STAGE_HEADER,
+    STAGE_THREADS,
+    STAGE_EVENTS,
+    STAGE_FOOTER,
+    STAGE_DONE
+};
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+static void lock() {
+    if (!s_mutex) s_mutex = xSemaphoreCreateMutex(); // First event comes from setup()
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+}
+
+static void unlock() {
+    xSemaphoreGive(s_mutex);
+}
+
+/**
+ * @brief Index of the calling task, registered on first use. Must hold the lock.
+ */
+static uint8_t currentThread() {
+    TaskHandle_t handle = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 0; i < s_threadCount; i++) {
+        if (s_threads[i].handle == handle) return i;
+    }
+    if (s_threadCount == TRACE_MAX_THREADS) return TRACE_MAX_THREADS - 1; // Share the last slot
+    s_threads[s_threadCount].handle = handle;
+    s_threads[s_threadCount].name = pcTaskGetName(nullptr);
+    return s_threadCount++;
+}
+
+/**
+ * @brief Formats the next piece of the JSON document into the cursor.
+ * @return false when the document is complete.
+ */
+static bool formatNext(TraceReadCursor& cursor) {
+    char* out = cursor.pending;
+    size_t size = sizeof(cursor.pending);
+    int len = 0;
+
+    while (len == 0) {
+        switch (cursor.stage) {
+            case STAGE_HEADER:
+                len = snprintf(out, size, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+                cursor.stage = STAGE_THREADS;
+                cursor.next = 0;
+                break;
+
+            case STAGE_THREADS: {
+                lock();
+                bool more = cursor.next < s_threadCount;
+                const char* name = more ? s_threads[cursor.next].name : nullptr;
+                unlock();
+                if (!more) {
+                    lock();
+                    cursor.next = (s_total > TRACE_RING_SIZE) ? s_total - TRACE_RING_SIZE : 0;
+                    unlock();
+                    cursor.stage = STAGE_EVENTS;
+                    break;
+                }
+                len = snprintf(out, size,
+                               "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+                               (unsigned)cursor.next, name ? name : "?");
+                cursor.next++;
+                break;
+            }
+
+            case STAGE_EVENTS: {
+                lock();
+                // Skip events overwritten since the last piece
+                uint32_t oldest = (s_total > TRACE_RING_SIZE) ? s_total - TRACE_RING_SIZE : 0;
+                if (cursor.next < oldest) cursor.next = oldest;
+                bool more = cursor.next < s_total;
+                TraceEvent event = {};
+                if (more) event = s_events[cursor.next % TRACE_RING_SIZE];
+                unlock();
+                if (!more) {
+                    cursor.stage = STAGE_FOOTER;
+                    break;
+                }
+                len = snprintf(out, size,
+                               "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%lu,\"dur\":%lu},\n",
+                               event.name, (unsigned)event.thread,
+                               (unsigned long)event.startUs, (unsigned long)event.durationUs);
+                cursor.next++;
+                break;
+            }
+
+            case STAGE_FOOTER:
+                // Closing marker keeps the ",\n" separators valid JSON
+                len = snprintf(out, size, "{\"name\":\"export\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%lu}\n]}\n",
+                               (unsigned long)micros());
+                cursor.stage = STAGE_DONE;
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    cursor.pendingLen = (len < (int)size) ? (size_t)len : size - 1;
+    cursor.pendingPos = 0;
+    return true;
+}
+
+// --- PUBLIC FUNCTIONS ---
+
+void Trace_record(const char* name, uint32_t startUs) {
+    uint32_t now = micros();
+
+    lock();
+    TraceEvent& event = s_events[s_total % TRACE_RING_SIZE];
+    event.name = name;
+    event.startUs = startUs;
+    event.durationUs = now - startUs;
+    event.thread = currentThread();
+    s_total++;
+    unlock();
+}
+
+size_t Trace_readJson(TraceReadCursor& cursor, uint8_t* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (cursor.pendingPos == cursor.pendingLen && !formatNext(cursor)) break;
+
+        size_t n = cursor.pendingLen - cursor.pendingPos;
+        if (n > maxLen - written) n = maxLen - written;
+        memcpy(buffer + written, cursor.pending + cursor.pendingPos, n);
+        cursor.pendingPos += n;
+        written += n;
+    }
+    return written;
+}
+
+void Trace_dumpToSerial() {
+    if (!Serial) return;
+
+    Serial.println("\n--- TRACE JSON (save as trace.json) ---");
+    TraceReadCursor cursor;
+    uint8_t chunk[128];
+    size_t len;
+    while ((len = Trace_readJson(cursor, chunk, sizeof(chunk))) > 0) {
+        Serial.write(chunk, len);
+    }
+    Serial.println("--- END OF TRACE ---\n");
+    Serial.flush();
+}
@@ -0,0 +1,66 @@
+// trace.h
+
+#pragma once
+
+#include <Arduino.h>
+#include "config.h"
+
+// --- Event Tracing ---
+// TRACE_SCOPE("name") records how long the enclosing block took, as one
+// complete event (start + duration, microseconds since boot) in a fixed RAM
+// ring of TRACE_RING_SIZE events. The newest events win. Events from
+// different tasks (main loop, web server, log flush) are kept apart, so
+// overlaps and blocking waits are visible in a timeline.
+// Export with GET /trace.json or the "trace" serial command, then open the
+// file in chrome://tracing or https://ui.perfetto.dev.
+// Names must be string literals (only the pointer is stored).
+// TRACE_ENABLED 0 compiles all trace points out.
+
+#define TRACE_RING_SIZE 256
+#define TRACE_MAX_THREADS 8
+
+/**
+ * @brief Records a complete event that started at startUs (micros()) and ends now.
+ */
+void Trace_record(const char* name, uint32_t startUs);
+
+// Export cursor, see Trace_readJson()
+struct TraceReadCursor {
+    uint8_t stage = 0;       // Header, thread names, events, footer, done
+    uint32_t next = 0;       // Thread index or event sequence number
+    char pending[192];       // Formatted piece not yet copied out
+    size_t pendingLen = 0;
+    size_t pendingPos = 0;
+};
+
+/**
+ * @brief Copies the next part of the trace, in Chrome trace-event JSON, into
+ * buffer. Events recorded while reading are included; overwritten ones are skipped.
+ * @return Bytes written, 0 at the end.
+ */
+size_t Trace_readJson(TraceReadCursor& cursor, uint8_t* buffer, size_t maxLen);
+
+/**
+ * @brief Prints the trace JSON to the Serial port.
+ */
+void Trace_dumpToSerial();
+
+// Records the enclosing scope
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : _name(name), _startUs(micros()) {}
+    ~TraceScope() { Trace_record(_name, _startUs); }
+
+private:
+    const char* _name;
+    uint32_t _startUs;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#if TRACE_ENABLED
+    #define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(_traceScope, __LINE__)(name)
+#else
+    #define TRACE_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,251 @@
+// web_assets.h
+// Generated by tools/embed_web_assets.py from web/. Do not edit.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct WebAsset {
+    const char* path;          // URL
+    const char* contentType;
+    const uint8_t* data;       // gzip, served as-is from flash
+    size_t length;
+    const char* etag;          // Quoted strong ETag
+    const char* cacheControl;
+};
+
+// index.html: 3718 bytes, 1169 gzipped
+static constexpr uint8_t WEB_ASSET_INDEX_HTML_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x57, 0x6d, 0x73, 0xe2, 0x36,
+    0x10, 0xfe, 0x9e, 0x5f, 0xa1, 0x2a, 0xd3, 0x5c, 0x32, 0x2d, 0x2f, 0x09, 0xbd, 0x84, 0x80, 0x71,
+    0xe7, 0x0a, 0x49, 0x73, 0x33, 0xcd, 0xcb, 0x1c, 0xf4, 0x3a, 0xf7, 0xe9, 0x46, 0xd8, 0x8b, 0xad,
+    0x46, 0x96, 0x5c, 0x49, 0x86, 0xd0, 0x5f, 0xdf, 0x95, 0x31, 0x60, 0x08, 0x90, 0x23, 0x97, 0x29,
+    0x5f, 0xb0, 0xf5, 0xf2, 0xec, 0xb3, 0xeb, 0x67, 0x77, 0x25, 0xef, 0x87, 0xde, 0x7d, 0x77, 0xf0,
+    0xe5, 0xe1, 0x8a, 0xc4, 0x36, 0x11, 0xfe, 0x81, 0x37, 0xff, 0x03, 0x16, 0xfa, 0x07, 0x04, 0x7f,
+    0x9e, 0xe5, 0x56, 0x80, 0x7f, 0xd5, 0x7f, 0x68, 0x9c, 0x91, 0x3f, 0x54, 0x14, 0x81, 0xf6, 0x6a,
+    0xb3, 0xb1, 0xd9, 0x7c, 0x02, 0x96, 0x11, 0xc9, 0x12, 0xe8, 0xd0, 0x31, 0x87, 0x49, 0xaa, 0xb4,
+    0xa5, 0x24, 0x50, 0xd2, 0x82, 0xb4, 0x1d, 0x3a, 0xe1, 0xa1, 0x8d, 0x3b, 0x21, 0x8c, 0x79, 0x00,
+    0x95, 0xfc, 0xe5, 0x67, 0xc2, 0x25, 0xb7, 0x9c, 0x89, 0x8a, 0x09, 0x98, 0x80, 0xce, 0x29, 0x2d,
+    0x80, 0x04, 0x97, 0x8f, 0x44, 0x83, 0xe8, 0x50, 0x63, 0xa7, 0x02, 0x4c, 0x0c, 0x80, 0x48, 0xb1,
+    0x86, 0x51, 0x87, 0xd6, 0xf2, 0xa1, 0x6a, 0x60, 0xcc, 0xaf, 0xe3, 0xce, 0xa8, 0xde, 0xa8, 0x5f,
+    0x34, 0xdf, 0x37, 0x70, 0xa3, 0x57, 0x9b, 0x31, 0xf5, 0x86, 0x2a, 0x9c, 0x16, 0x38, 0x21, 0x1f,
+    0x93, 0x40, 0x30, 0x63, 0x3a, 0xd4, 0xd1, 0x60, 0x5c, 0x82, 0x2e, 0x6c, 0xe4, 0xf3, 0xf1, 0x59,
+    0xe1, 0xcd, 0x95, 0x1c, 0x73, 0xad, 0x64, 0x82, 0x44, 0x17, 0x9e, 0xe1, 0xe4, 0x62, 0xe5, 0x72,
+    0x4b, 0x19, 0x92, 0xe9, 0xb0, 0x84, 0x36, 0x43, 0x6c, 0xf8, 0xdd, 0x4c, 0x6b, 0x87, 0xf3, 0x09,
+    0xe9, 0x70, 0x19, 0x19, 0x44, 0x6a, 0xac, 0xad, 0x2a, 0x81, 0x18, 0x90, 0x46, 0xe9, 0x8a, 0x56,
+    0x93, 0x35, 0xa8, 0xf9, 0xc2, 0xe7, 0xa3, 0x0b, 0x88, 0x3c, 0x12, 0x1d, 0x3a, 0x42, 0xd7, 0x2a,
+    0x86, 0xff, 0x0b, 0xad, 0x7a, 0xf5, 0x52, 0x43, 0xd2, 0xc6, 0x98, 0x0b, 0xa5, 0x5b, 0x87, 0xcd,
+    0x66, 0xb3, 0x4d, 0xfd, 0x01, 0x24, 0x29, 0x68, 0x66, 0x33, 0x0d, 0x5e, 0x6d, 0x37, 0x60, 0xc1,
+    0x69, 0xcc, 0x04, 0xf5, 0x3d, 0x93, 0x32, 0x49, 0x78, 0xd8, 0xa1, 0x76, 0x09, 0x40, 0xfd, 0x4a,
+    0xc5, 0xab, 0xb9, 0x99, 0x62, 0xbe, 0xd8, 0x91, 0xe1, 0x77, 0xa4, 0xfe, 0x51, 0x08, 0x51, 0xbb,
+    0x3b, 0x9f, 0xdf, 0x6c, 0x6b, 0xdb, 0xf0, 0x5b, 0x78, 0x7a, 0x93, 0x25, 0x3c, 0xe4, 0x76, 0xfa,
+    0x3a, 0x37, 0xe3, 0x62, 0xf7, 0x6e, 0x1f, 0x7f, 0xdc, 0xdb, 0xbd, 0x4d, 0x43, 0x25, 0x16, 0x96,
+    0x27, 0x60, 0x2c, 0x4b, 0xd2, 0x8a, 0x60, 0x43, 0x40, 0x46, 0xb7, 0xc0, 0x0c, 0x86, 0x3a, 0x24,
+    0xcc, 0xb6, 0xc8, 0x92, 0x5e, 0x52, 0x0c, 0x7f, 0xb0, 0x65, 0x82, 0xab, 0xd8, 0xc5, 0xeb, 0x3e,
+    0x6a, 0x45, 0xb5, 0x93, 0x1b, 0x6e, 0xac, 0xd2, 0xd3, 0xdd, 0x42, 0xb5, 0x6c, 0x28, 0x00, 0x13,
+    0x55, 0x2b, 0x21, 0xb6, 0x48, 0x35, 0xe7, 0x19, 0x32, 0xcb, 0x06, 0x6e, 0x2d, 0x9d, 0xef, 0x14,
+    0x2a, 0x4f, 0x04, 0xea, 0x5f, 0x83, 0x0d, 0x62, 0x7c, 0x22, 0x6e, 0x4d, 0xb5, 0x5a, 0xdd, 0x3f,
+    0x58, 0x23, 0xa5, 0x93, 0x6d, 0xb9, 0x32, 0xcc, 0xac, 0x55, 0xb3, 0x58, 0x49, 0x98, 0x80, 0xfe,
+    0xcd, 0xca, 0x05, 0x85, 0xa1, 0x95, 0x15, 0x03, 0x58, 0x03, 0x42, 0xa6, 0xa7, 0x94, 0x28, 0x19,
+    0x08, 0x1e, 0x3c, 0xce, 0xa8, 0x3d, 0xb0, 0x08, 0x8e, 0x83, 0x59, 0xd2, 0xba, 0x67, 0x52, 0x21,
+    0xa7, 0x27, 0x94, 0x84, 0xdc, 0x38, 0x2f, 0x42, 0xff, 0x48, 0x30, 0xad, 0xdb, 0xe4, 0xce, 0x61,
+    0x7a, 0xb5, 0x99, 0x95, 0xdd, 0xe6, 0x95, 0x08, 0xbf, 0xc3, 0xfc, 0x4f, 0xab, 0xe6, 0xef, 0x1d,
+    0x18, 0x39, 0xd2, 0x8e, 0xc4, 0x66, 0xf3, 0xdb, 0x62, 0xe6, 0xa8, 0xa4, 0x88, 0xf8, 0x51, 0x8e,
+    0x14, 0xdd, 0x2a, 0xb7, 0x4d, 0xbb, 0x0b, 0x5f, 0x4a, 0x3c, 0x03, 0x66, 0xb9, 0x92, 0xd5, 0xbc,
+    0x04, 0xbf, 0xab, 0x85, 0x6a, 0x22, 0x1d, 0xf7, 0x77, 0xd4, 0xef, 0x15, 0x8f, 0xa4, 0xdb, 0xff,
+    0x4c, 0xae, 0xb9, 0x80, 0xe7, 0x1c, 0x5f, 0xa1, 0xca, 0xfe, 0xd4, 0x60, 0xd5, 0x21, 0x7d, 0xb0,
+    0x76, 0x73, 0x09, 0x5d, 0xdd, 0xe1, 0x64, 0x41, 0x58, 0xe0, 0x28, 0xba, 0x06, 0x01, 0xf6, 0xab,
+    0x73, 0x93, 0x12, 0x6c, 0x48, 0xb1, 0xc2, 0x28, 0xfc, 0x7e, 0x35, 0xd8, 0x26, 0xd9, 0xa2, 0xb2,
+    0x58, 0x78, 0xb2, 0x15, 0x26, 0x78, 0x24, 0x5b, 0x02, 0x46, 0xb6, 0x4d, 0x12, 0xa6, 0x23, 0x2e,
+    0x2b, 0x43, 0x85, 0xbe, 0x24, 0xad, 0xf7, 0xe9, 0x53, 0x9b, 0xe4, 0xd5, 0x67, 0x02, 0x3c, 0x8a,
+    0x6d, 0x6b, 0x88, 0xdf, 0x78, 0x51, 0x7d, 0xce, 0xcf, 0xcf, 0xb1, 0xfa, 0x20, 0x59, 0xd2, 0x63,
+    0x16, 0xc8, 0x11, 0x19, 0xa0, 0xf5, 0x2d, 0x05, 0xe2, 0x60, 0x57, 0x45, 0xda, 0x21, 0x6f, 0xb7,
+    0x92, 0xcb, 0x34, 0xb3, 0xc4, 0x4e, 0x53, 0x24, 0x2c, 0xb3, 0x64, 0x88, 0xcd, 0xac, 0x68, 0xb7,
+    0x5f, 0x28, 0x49, 0x05, 0x0b, 0x20, 0xce, 0xa5, 0x87, 0xef, 0xc0, 0x70, 0x4e, 0xc3, 0x3f, 0x19,
+    0x77, 0x95, 0x64, 0x5e, 0x3e, 0x05, 0x3c, 0xb5, 0xce, 0xf6, 0x06, 0xbf, 0x5d, 0x03, 0xbf, 0xc5,
+    0x38, 0xc4, 0x4b, 0xf4, 0x7d, 0xe1, 0x7a, 0x6b, 0x70, 0x3d, 0x36, 0xdd, 0x05, 0xb6, 0xae, 0x9e,
+    0x37, 0x8d, 0x5b, 0xbc, 0xc6, 0xe5, 0x46, 0x65, 0xfa, 0xf5, 0x9e, 0x25, 0xeb, 0x81, 0xe2, 0x32,
+    0xb3, 0xf0, 0x0d, 0xce, 0xbd, 0x2c, 0x92, 0xb2, 0x51, 0x93, 0x0d, 0x13, 0x6c, 0x45, 0x04, 0xfb,
+    0x57, 0x86, 0xaf, 0x7f, 0xa6, 0xa1, 0x53, 0xdd, 0x20, 0x57, 0x7c, 0xf1, 0xa5, 0x87, 0x2c, 0x78,
+    0x8c, 0xb4, 0xca, 0x64, 0xd8, 0x22, 0x87, 0x17, 0xa3, 0x66, 0xd0, 0x0c, 0x51, 0xa1, 0xe4, 0x1b,
+    0xd5, 0xf8, 0xac, 0xdb, 0x92, 0x7a, 0xb5, 0x59, 0x6a, 0xb7, 0xe4, 0xf0, 0xf2, 0xf2, 0x72, 0x91,
+    0x22, 0x56, 0xa5, 0x2d, 0xe2, 0x12, 0x84, 0x2e, 0x8e, 0x3e, 0x45, 0xfa, 0x3a, 0x4a, 0xe5, 0x16,
+    0x66, 0xf2, 0xe1, 0x9c, 0xe8, 0xd6, 0x16, 0x36, 0x8b, 0x8a, 0xfb, 0xa0, 0xbb, 0x12, 0x3e, 0xd6,
+    0x0b, 0x4f, 0x95, 0xc6, 0x58, 0xb7, 0xea, 0x6d, 0x32, 0x7b, 0xca, 0xe9, 0x9c, 0xa6, 0x4f, 0xc4,
+    0x28, 0xc1, 0x43, 0x72, 0x08, 0x00, 0x73, 0xa6, 0xad, 0x33, 0x64, 0x49, 0xea, 0xc8, 0xf3, 0xe0,
+    0xa5, 0xf2, 0x31, 0xe1, 0x23, 0xbe, 0x2c, 0x1f, 0x0f, 0xf7, 0xfd, 0xff, 0xa1, 0x7e, 0xfc, 0xc5,
+    0xaf, 0x39, 0xe9, 0x2a, 0x39, 0xe2, 0x51, 0xa6, 0xf3, 0x72, 0xbb, 0xed, 0x8c, 0x51, 0x16, 0x83,
+    0x33, 0x3c, 0xd7, 0x9f, 0x31, 0x3c, 0x5c, 0x93, 0xe0, 0x1d, 0xd8, 0x89, 0xd2, 0x8f, 0xe4, 0x0e,
+    0x17, 0x90, 0xe3, 0x7e, 0xff, 0x63, 0xef, 0x64, 0xa7, 0x1e, 0xcb, 0xd0, 0x29, 0xe6, 0x16, 0x6e,
+    0x0e, 0xe7, 0xf0, 0xee, 0x7d, 0x0b, 0xfc, 0xc3, 0x7c, 0xa9, 0xbf, 0x97, 0x74, 0xfb, 0x6c, 0x0c,
+    0xa4, 0x8b, 0x4c, 0x50, 0x34, 0x78, 0x0d, 0x30, 0x58, 0x3a, 0x3f, 0xb9, 0xee, 0xe4, 0xee, 0x0d,
+    0xcf, 0x95, 0x7c, 0x08, 0x17, 0xbf, 0x04, 0x8d, 0x80, 0xbe, 0x2c, 0x16, 0x2f, 0xc5, 0xa3, 0x5b,
+    0xc2, 0x84, 0x98, 0xa3, 0x14, 0x81, 0x76, 0xb2, 0xa5, 0xfe, 0x07, 0xfc, 0xd2, 0x68, 0xd7, 0x05,
+    0x63, 0x45, 0x9d, 0x2e, 0x7a, 0xfe, 0x42, 0x95, 0xf9, 0x7e, 0xfc, 0x4f, 0xd7, 0xd5, 0xf2, 0xbd,
+    0xda, 0x7b, 0xae, 0xe6, 0xb7, 0xd5, 0x51, 0x8f, 0xb3, 0x48, 0x2a, 0x63, 0x79, 0x60, 0x36, 0xe5,
+    0x16, 0x9b, 0xdf, 0xa3, 0x84, 0x8a, 0x28, 0xc1, 0x58, 0x47, 0x80, 0x97, 0xb3, 0xaf, 0x43, 0xc1,
+    0xe4, 0xe3, 0xca, 0x81, 0x25, 0xbf, 0x84, 0xad, 0x9e, 0x5c, 0xfc, 0xcf, 0x78, 0xad, 0x9b, 0x67,
+    0xb7, 0x3b, 0x39, 0x1e, 0xf7, 0x60, 0x98, 0x45, 0x27, 0x5e, 0x8d, 0x95, 0xfb, 0xfb, 0xd2, 0x6a,
+    0xb9, 0x78, 0x7b, 0x78, 0x76, 0xe4, 0xa9, 0x25, 0x46, 0x07, 0x68, 0x9d, 0xa5, 0x69, 0xf5, 0x6f,
+    0x77, 0x85, 0x63, 0x17, 0x97, 0x0c, 0x2e, 0x2e, 0xcf, 0xf3, 0xd0, 0xe7, 0x2b, 0xdc, 0x5d, 0x6e,
+    0x76, 0x89, 0xc3, 0xbe, 0x9f, 0x5f, 0x42, 0xff, 0x03, 0xb3, 0x2e, 0x9b, 0xef, 0x9c, 0x0e, 0x00,
+    0x00,
+};
+
+// style.css: 2183 bytes, 972 gzipped
+static constexpr uint8_t WEB_ASSET_STYLE_CSS_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x55, 0xc1, 0x8e, 0xdb, 0x36,
+    0x10, 0xbd, 0xef, 0x57, 0x0c, 0x52, 0xb4, 0x48, 0x02, 0xd1, 0x91, 0x65, 0xcb, 0xab, 0x95, 0xd1,
+    0x43, 0xd3, 0x36, 0x48, 0x80, 0xe6, 0x92, 0x4d, 0x7b, 0x29, 0x7a, 0xa0, 0x24, 0xca, 0x62, 0x97,
+    0x22, 0x05, 0x92, 0x5a, 0x5b, 0x09, 0xf6, 0xdf, 0x3b, 0x24, 0x25, 0xaf, 0xa5, 0x75, 0x21, 0xec,
+    0x42, 0xa2, 0xc9, 0x99, 0x37, 0x6f, 0xde, 0x3c, 0x16, 0xaa, 0x1a, 0xe0, 0x3b, 0xd4, 0x4a, 0x5a,
+    0x52, 0xd3, 0x96, 0x8b, 0x21, 0x07, 0x42, 0xbb, 0x4e, 0x30, 0x62, 0x06, 0x63, 0x59, 0x1b, 0xc1,
+    0x7b, 0xc1, 0xe5, 0xc3, 0x67, 0x5a, 0xde, 0xfb, 0xef, 0x0f, 0xb8, 0x33, 0x82, 0x57, 0xf7, 0xec,
+    0xa0, 0x18, 0xfc, 0xf9, 0xe9, 0x55, 0x04, 0x5f, 0x54, 0xa1, 0xac, 0x8a, 0xe0, 0x23, 0x13, 0x8f,
+    0xcc, 0xf2, 0x92, 0x46, 0xf0, 0x8b, 0xe6, 0x54, 0x44, 0x60, 0xa8, 0x34, 0xc4, 0x30, 0xcd, 0xeb,
+    0x3d, 0x58, 0x76, 0xb2, 0x84, 0x0a, 0x7e, 0x90, 0x39, 0x94, 0x4c, 0x5a, 0xa6, 0xf7, 0xd0, 0x52,
+    0x7d, 0xe0, 0xf8, 0x9d, 0xc4, 0xdd, 0x69, 0x0f, 0x05, 0x2d, 0x1f, 0x0e, 0x5a, 0xf5, 0xb2, 0x22,
+    0xa5, 0x12, 0x4a, 0xe7, 0xf0, 0x43, 0xbd, 0xad, 0x6f, 0xeb, 0xdd, 0x1e, 0xa6, 0xef, 0xcd, 0x66,
+    0xb3, 0x87, 0xa7, 0x9b, 0x55, 0x89, 0x20, 0x28, 0x97, 0x4c, 0x23, 0xf4, 0x96, 0x9e, 0xc8, 0x91,
+    0x57, 0xb6, 0xc9, 0x21, 0x8b, 0x7d, 0xa0, 0x29, 0x6c, 0x0c, 0xb4, 0xb7, 0xca, 0x1d, 0xb8, 0x79,
+    0xf7, 0x16, 0x7e, 0xa5, 0xba, 0x82, 0x7b, 0x3b, 0x08, 0x06, 0x6f, 0xdf, 0x61, 0x08, 0xf7, 0xf9,
+    0xfd, 0x22, 0xa9, 0x4b, 0x57, 0x23, 0xd0, 0x8e, 0x56, 0x15, 0x97, 0x87, 0x09, 0x55, 0x08, 0x46,
+    0xb0, 0x44, 0xab, 0xda, 0x33, 0x54, 0xa5, 0x2b, 0xa6, 0x89, 0xa6, 0x15, 0xef, 0x4d, 0x0e, 0xeb,
+    0x24, 0x2c, 0x9e, 0x88, 0x69, 0x68, 0xa5, 0x8e, 0x2e, 0xf5, 0xb6, 0x3b, 0xc1, 0x0e, 0xff, 0xf4,
+    0xa1, 0xa0, 0xaf, 0xe3, 0xc8, 0x3f, 0xab, 0xf5, 0x9b, 0x09, 0xcd, 0xd7, 0xa1, 0x53, 0x07, 0x4d,
+    0xbb, 0x66, 0x70, 0x68, 0x9a, 0x04, 0xa1, 0x4c, 0x45, 0x26, 0xe5, 0x86, 0xa5, 0xf1, 0x8b, 0xcc,
+    0x6b, 0x9f, 0xd9, 0x37, 0xea, 0xc8, 0xf8, 0xa1, 0xb1, 0x39, 0xec, 0xe2, 0x78, 0xff, 0x74, 0xd3,
+    0x6c, 0x5c, 0x1d, 0x01, 0xd1, 0x19, 0x26, 0x66, 0x36, 0x4a, 0xf0, 0x0a, 0x8b, 0x8a, 0xdd, 0x73,
+    0xae, 0x6b, 0x11, 0x6f, 0x4c, 0x62, 0x55, 0x87, 0xa0, 0x9f, 0x89, 0x4e, 0xd3, 0x74, 0xcc, 0x65,
+    0xf8, 0x37, 0x86, 0x9b, 0x57, 0x89, 0x66, 0xed, 0x04, 0xfe, 0x9e, 0x49, 0xa3, 0x34, 0xfc, 0x45,
+    0x45, 0xcf, 0x8c, 0x67, 0xd3, 0xf8, 0x15, 0xa2, 0xd5, 0x11, 0xb1, 0x54, 0xdc, 0x74, 0x82, 0xa2,
+    0x90, 0x6a, 0xc1, 0x30, 0xc5, 0xbf, 0xbd, 0xb1, 0xbc, 0x1e, 0x88, 0x6b, 0x1a, 0x36, 0x3e, 0x07,
+    0xd3, 0xd1, 0x92, 0x11, 0xea, 0x59, 0xdf, 0x83, 0xd7, 0x04, 0xe1, 0x28, 0x2d, 0xb3, 0x54, 0xc6,
+    0x02, 0x2b, 0x36, 0xfe, 0x91, 0x8a, 0x49, 0xad, 0x01, 0x58, 0xb2, 0x4a, 0x1c, 0xae, 0x19, 0x2d,
+    0x85, 0x12, 0xd5, 0x85, 0x66, 0xb6, 0x77, 0x59, 0x55, 0xf8, 0xd3, 0xbd, 0xe4, 0x76, 0x7e, 0x3c,
+    0x5e, 0xa5, 0xee, 0xf8, 0xb4, 0xf7, 0xb6, 0xce, 0xca, 0xac, 0x5a, 0x84, 0x93, 0x4a, 0xb7, 0x54,
+    0x9c, 0x31, 0x09, 0x56, 0x5b, 0x4f, 0xb0, 0x0f, 0x69, 0x79, 0xcb, 0x8c, 0xa5, 0x6d, 0x47, 0x04,
+    0x2d, 0x98, 0x58, 0x46, 0xcf, 0x52, 0x7d, 0x19, 0x3f, 0xcb, 0xb2, 0x39, 0xe5, 0xe9, 0xb9, 0xa7,
+    0xc6, 0x29, 0x33, 0x07, 0x6e, 0x91, 0x8f, 0x72, 0x22, 0xfa, 0x93, 0xec, 0x7a, 0x6b, 0xe0, 0x27,
+    0x78, 0xdf, 0x23, 0x11, 0xd2, 0x73, 0x5d, 0xf8, 0xd7, 0x08, 0xb8, 0xfb, 0xed, 0x6f, 0x3b, 0x74,
+    0xec, 0x67, 0xd3, 0x17, 0x2d, 0xb7, 0xff, 0x44, 0xb0, 0x2a, 0x2c, 0x02, 0xc4, 0x71, 0xbd, 0xec,
+    0x42, 0x21, 0x54, 0xf9, 0x30, 0xca, 0x93, 0x7f, 0xf3, 0xd2, 0x3e, 0xab, 0x65, 0x36, 0x76, 0x17,
+    0x64, 0x8d, 0x80, 0x8f, 0x0d, 0xf6, 0x65, 0x92, 0xbb, 0x63, 0x42, 0xb2, 0x8b, 0x01, 0x99, 0x64,
+    0x3f, 0x9b, 0x85, 0xcc, 0xad, 0x95, 0xbd, 0x36, 0xee, 0x7c, 0xa7, 0x78, 0xe8, 0xe7, 0x38, 0xa0,
+    0xeb, 0x38, 0xfe, 0x71, 0xae, 0x2b, 0x4f, 0xcf, 0x25, 0x23, 0xeb, 0xf4, 0x85, 0xcc, 0x53, 0x94,
+    0x39, 0x58, 0x8d, 0x66, 0xc2, 0x2d, 0x57, 0x38, 0xd8, 0xcf, 0x90, 0x91, 0xe2, 0xc4, 0x8c, 0xe6,
+    0x52, 0xb1, 0x52, 0x69, 0x1a, 0x76, 0x78, 0xa4, 0x4f, 0x23, 0x57, 0x79, 0xa3, 0x1e, 0x99, 0xbe,
+    0xc6, 0xd8, 0xf4, 0xcb, 0x99, 0xb7, 0xb0, 0xb0, 0xf4, 0x85, 0xe4, 0x2e, 0x8b, 0x8b, 0x3b, 0xdf,
+    0x6f, 0xb7, 0xd1, 0x60, 0x22, 0x59, 0x51, 0x3d, 0x2c, 0xf7, 0x4d, 0xf2, 0x79, 0xd1, 0xe1, 0xe5,
+    0xc1, 0xeb, 0x69, 0x76, 0x9b, 0x1d, 0xbb, 0x4d, 0xa6, 0xde, 0x7f, 0x40, 0xd9, 0xc1, 0x1f, 0x74,
+    0x50, 0xbd, 0x75, 0xd6, 0xda, 0x31, 0x1d, 0x46, 0xad, 0xc6, 0xf5, 0xeb, 0x83, 0x76, 0xa0, 0xdd,
+    0xd9, 0x26, 0x70, 0x81, 0x1c, 0xb5, 0x5b, 0x70, 0xff, 0x3d, 0x82, 0xf3, 0x41, 0xcf, 0x83, 0x53,
+    0x2a, 0x6e, 0xc2, 0x03, 0x88, 0x17, 0xc1, 0x8e, 0x1d, 0xba, 0x0d, 0x93, 0x06, 0x08, 0xe0, 0x77,
+    0x69, 0x7a, 0x8d, 0xf3, 0xcd, 0x83, 0x08, 0xa9, 0x31, 0x7d, 0xcb, 0xa0, 0xee, 0x85, 0x08, 0xed,
+    0x04, 0x25, 0x01, 0xab, 0x18, 0xc0, 0xe0, 0x78, 0x08, 0x30, 0xa5, 0x66, 0xe8, 0x02, 0x80, 0xc6,
+    0x80, 0x2e, 0xa8, 0x59, 0x18, 0x73, 0xb7, 0x49, 0x20, 0x1d, 0xee, 0x25, 0x78, 0x85, 0xab, 0xed,
+    0x37, 0x6a, 0x29, 0x7c, 0xa5, 0x05, 0x7a, 0xb1, 0x77, 0xe4, 0x50, 0x99, 0x75, 0x0b, 0x04, 0xe3,
+    0x28, 0x21, 0x46, 0x63, 0x6f, 0x46, 0x09, 0x6c, 0x83, 0xb3, 0x3b, 0xd6, 0x6a, 0xa1, 0x8e, 0x04,
+    0x6b, 0x0e, 0xde, 0xfe, 0x52, 0xe5, 0x41, 0xaa, 0xeb, 0x67, 0x03, 0x64, 0x8c, 0xbd, 0x50, 0xe9,
+    0x36, 0x74, 0xc5, 0x67, 0xc4, 0x54, 0x33, 0x79, 0x8e, 0x5b, 0x71, 0x04, 0x04, 0xed, 0x0c, 0x8a,
+    0x74, 0x7a, 0xdb, 0x5f, 0x9d, 0x6d, 0x8c, 0xd2, 0x44, 0x60, 0xdd, 0x65, 0x32, 0x9b, 0x8c, 0x30,
+    0x09, 0xd7, 0xae, 0xbd, 0x85, 0x57, 0x2f, 0xa1, 0xba, 0x80, 0x33, 0x69, 0x3c, 0x5f, 0x87, 0x59,
+    0x7d, 0x57, 0xd3, 0x6b, 0x2e, 0x7d, 0x79, 0x23, 0xe0, 0xd4, 0x4d, 0x83, 0x82, 0xc6, 0x5b, 0x3e,
+    0x0c, 0x88, 0x62, 0xb4, 0xf7, 0xf9, 0x15, 0xe5, 0x12, 0x27, 0xcb, 0x2b, 0x2a, 0x4e, 0xfd, 0x1d,
+    0x65, 0x75, 0x2e, 0x6d, 0x43, 0xca, 0x86, 0x8b, 0xea, 0x35, 0x7b, 0x64, 0xf2, 0xcd, 0xff, 0x40,
+    0x2a, 0xdc, 0xe3, 0xf5, 0x25, 0x14, 0x75, 0xd5, 0x5f, 0xf2, 0x10, 0x6e, 0xcb, 0x99, 0xfb, 0x5d,
+    0x37, 0xbb, 0xff, 0x00, 0xd0, 0xbd, 0x3d, 0xee, 0x87, 0x08, 0x00, 0x00,
+};
+
+// app.js: 3815 bytes, 1310 gzipped
+static constexpr uint8_t WEB_ASSET_APP_JS_GZ[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x57, 0x6d, 0x4f, 0xe3, 0x46,
+    0x10, 0xfe, 0xce, 0xaf, 0x98, 0x43, 0xea, 0xd9, 0x2e, 0x60, 0x07, 0xda, 0x7e, 0x21, 0x24, 0x27,
+    0x8e, 0x4b, 0x0b, 0x15, 0x6f, 0x52, 0xf8, 0x54, 0x84, 0xaa, 0xc5, 0x3b, 0x21, 0xdb, 0x73, 0xbc,
+    0xd6, 0xee, 0x26, 0x21, 0xbd, 0xe3, 0xbf, 0x77, 0x66, 0x1d, 0x1b, 0x1b, 0x12, 0x8e, 0xde, 0x8b,
+    0x25, 0x62, 0x7b, 0x76, 0x3d, 0xf3, 0xcc, 0xdb, 0x33, 0x4b, 0x92, 0xc0, 0xb1, 0xb2, 0x4e, 0x9b,
+    0x05, 0x28, 0x0b, 0x23, 0x74, 0xe9, 0x18, 0x25, 0xe8, 0x1c, 0xa1, 0x10, 0x77, 0x08, 0xc2, 0x81,
+    0x00, 0xa7, 0x26, 0x08, 0x61, 0x8e, 0x73, 0xb4, 0x0e, 0x46, 0xca, 0x58, 0x17, 0x6d, 0x83, 0xd5,
+    0xe0, 0xc6, 0xb8, 0x91, 0x24, 0x70, 0x6b, 0xf4, 0xdc, 0xa2, 0x81, 0x1c, 0x67, 0xf4, 0x3b, 0xd6,
+    0x99, 0xb4, 0x30, 0xd1, 0x06, 0x69, 0x5d, 0xe4, 0x70, 0x79, 0xf8, 0xc7, 0xe0, 0xef, 0xe1, 0xc9,
+    0x5f, 0x03, 0xe0, 0x6d, 0xf1, 0x46, 0xaa, 0x73, 0xd2, 0xf2, 0x28, 0xed, 0xc1, 0x6f, 0x9d, 0xee,
+    0x46, 0x86, 0x0e, 0xd2, 0xa9, 0x31, 0x98, 0xbb, 0x4b, 0xb6, 0xdb, 0x03, 0x12, 0xb2, 0xf2, 0xab,
+    0xf1, 0x12, 0x89, 0x72, 0x16, 0xb3, 0x11, 0x83, 0xb4, 0x4e, 0x38, 0x95, 0x42, 0x98, 0x0a, 0x8f,
+    0xf5, 0x76, 0xc1, 0x40, 0x2a, 0x14, 0x51, 0xd7, 0xbf, 0xcd, 0x44, 0x36, 0x45, 0x0b, 0xa9, 0x26,
+    0xe4, 0x23, 0xa3, 0x27, 0x5e, 0xf8, 0xe7, 0xf0, 0xe2, 0x1c, 0x0e, 0x2f, 0x4f, 0x36, 0x46, 0xd3,
+    0x3c, 0x75, 0x4a, 0xe7, 0x90, 0x69, 0x21, 0x8f, 0x4a, 0xb3, 0x61, 0x04, 0x9f, 0x36, 0x80, 0x2e,
+    0x1f, 0x83, 0x30, 0x48, 0x44, 0xa1, 0x92, 0x25, 0xa4, 0x20, 0xf2, 0x2b, 0x31, 0x29, 0xc9, 0x43,
+    0x83, 0xb6, 0x20, 0x1f, 0x08, 0x63, 0x1f, 0xaa, 0xe7, 0xf8, 0x1f, 0xab, 0xf3, 0x30, 0x6a, 0x6e,
+    0x93, 0xc2, 0x09, 0xde, 0x52, 0x2a, 0xe5, 0x4b, 0xea, 0x74, 0x3a, 0x21, 0x6d, 0xf1, 0x1d, 0xba,
+    0x41, 0x86, 0xfc, 0xf8, 0x7e, 0x71, 0x22, 0xc3, 0xc0, 0xe1, 0xa4, 0x40, 0x23, 0xdc, 0xd4, 0x60,
+    0x10, 0xc5, 0x0e, 0xef, 0xdd, 0x91, 0xce, 0x1d, 0x2d, 0x53, 0x18, 0xbc, 0x9e, 0xb8, 0xb1, 0x03,
+    0x7a, 0xbd, 0x1e, 0xe4, 0xd3, 0x2c, 0x8b, 0xe0, 0x1d, 0x04, 0x3b, 0x3b, 0x01, 0xec, 0xc3, 0xd3,
+    0x3d, 0xb1, 0xd3, 0xbf, 0xab, 0x7b, 0x94, 0xe1, 0x6e, 0xd4, 0xfd, 0xb2, 0xf9, 0xf1, 0x74, 0xa2,
+    0xa4, 0x72, 0x8b, 0x35, 0xb6, 0xab, 0xe5, 0xb5, 0x86, 0xab, 0x0d, 0xff, 0xcf, 0xea, 0x04, 0x85,
+    0x25, 0xa8, 0xf2, 0xd0, 0x3d, 0xb3, 0x5b, 0xba, 0x43, 0x45, 0x57, 0xaa, 0x79, 0x58, 0x86, 0x35,
+    0x15, 0x9c, 0x18, 0x34, 0x46, 0x1b, 0x0e, 0x2c, 0x17, 0x92, 0xce, 0x30, 0xf6, 0x82, 0x30, 0x18,
+    0xf0, 0x6d, 0x3f, 0xd8, 0x06, 0xff, 0x1e, 0x11, 0x84, 0x67, 0xd9, 0xe4, 0xc2, 0x99, 0xda, 0x6f,
+    0x4a, 0xe6, 0x7a, 0x7f, 0xec, 0xc2, 0x52, 0x06, 0xae, 0x08, 0xf5, 0x0b, 0xfe, 0x7c, 0x3f, 0x5f,
+    0xe8, 0x8b, 0x91, 0xba, 0xfb, 0x51, 0xbe, 0x58, 0x25, 0x57, 0x7b, 0xc1, 0x2b, 0x5f, 0xef, 0xc5,
+    0x83, 0x6f, 0xe9, 0x53, 0x35, 0x43, 0x02, 0x28, 0xa4, 0xca, 0xef, 0x2c, 0xcc, 0xc7, 0x2a, 0x43,
+    0xdf, 0x9e, 0x12, 0x67, 0x2a, 0x45, 0xee, 0x70, 0x31, 0x17, 0x1f, 0x89, 0x71, 0x86, 0x68, 0x88,
+    0x51, 0x76, 0x86, 0x6c, 0x7f, 0x30, 0xa3, 0x5f, 0x5b, 0xf6, 0x72, 0x82, 0xfe, 0x25, 0x8a, 0x2b,
+    0x82, 0xa8, 0x18, 0xc8, 0x20, 0x41, 0xc8, 0x31, 0xa5, 0x8d, 0xd4, 0xdc, 0x8a, 0x6f, 0xf3, 0x1c,
+    0x44, 0x2e, 0xc1, 0x62, 0x4e, 0xac, 0x74, 0x2a, 0xac, 0xdb, 0xf1, 0x9a, 0x76, 0x4e, 0x3e, 0x54,
+    0x14, 0xb6, 0xb4, 0xcb, 0xba, 0x0c, 0x16, 0x99, 0x58, 0x30, 0x26, 0xe2, 0xbd, 0xb9, 0x20, 0x1a,
+    0x53, 0xd6, 0xa2, 0x8c, 0xe1, 0x22, 0x4f, 0x5b, 0x18, 0x6d, 0x86, 0x58, 0xd8, 0x6d, 0x2f, 0xca,
+    0x48, 0x69, 0xc5, 0x37, 0x54, 0x61, 0x0b, 0xb0, 0x63, 0xb2, 0x1a, 0x3f, 0x92, 0x0c, 0x09, 0x8d,
+    0x63, 0xa7, 0x6b, 0x8a, 0x51, 0x23, 0x08, 0xdf, 0xcc, 0x55, 0x2e, 0xf5, 0x3c, 0xf6, 0x70, 0x86,
+    0x7a, 0x6a, 0x52, 0x8c, 0x08, 0x00, 0xb5, 0x6f, 0x5e, 0x96, 0x7d, 0x49, 0x94, 0xd6, 0xaf, 0x50,
+    0xf8, 0x89, 0x7e, 0xa1, 0xb1, 0x97, 0xca, 0xa0, 0x8c, 0x42, 0xb0, 0x6c, 0xb6, 0x72, 0x63, 0x2c,
+    0xa4, 0xf4, 0xbb, 0x4e, 0x89, 0xd4, 0x31, 0x47, 0x4a, 0x83, 0x15, 0x93, 0x22, 0x43, 0x4e, 0xc3,
+    0xcc, 0x27, 0xb2, 0x49, 0x49, 0x4b, 0x1b, 0xa4, 0x9e, 0xb9, 0x31, 0x2e, 0x84, 0xb1, 0x18, 0xfa,
+    0x7d, 0x31, 0xa7, 0xbb, 0xd1, 0xc7, 0x0c, 0xd9, 0xae, 0xe4, 0x21, 0xf8, 0xfc, 0x19, 0xec, 0x2a,
+    0x96, 0x68, 0x3a, 0xf3, 0xd5, 0xfc, 0x67, 0x7f, 0x00, 0xaf, 0xd9, 0xef, 0x4f, 0x59, 0x01, 0xe7,
+    0x77, 0x1b, 0x02, 0xd8, 0xf2, 0x89, 0xfa, 0x20, 0x1c, 0x65, 0x9b, 0xb4, 0x9f, 0xea, 0x54, 0x64,
+    0xc8, 0xac, 0x30, 0x74, 0x86, 0xea, 0x3d, 0x8c, 0x2a, 0x4e, 0xf3, 0xdd, 0xd0, 0x1a, 0x44, 0x3c,
+    0xf8, 0x42, 0x9e, 0x75, 0xcd, 0x32, 0xf1, 0xb3, 0xef, 0x00, 0x3a, 0xed, 0x70, 0xae, 0x85, 0xc8,
+    0x43, 0xda, 0xbc, 0x77, 0x39, 0x01, 0x94, 0xca, 0x8a, 0xdb, 0x8c, 0x06, 0x64, 0x0f, 0x9c, 0x99,
+    0xe2, 0x17, 0x3e, 0xa4, 0xa9, 0xbd, 0xf6, 0xc3, 0x67, 0xe4, 0x33, 0x2e, 0x4f, 0x0c, 0xef, 0x18,
+    0x5c, 0x8f, 0x7d, 0xf6, 0x28, 0xb7, 0x20, 0x78, 0x6b, 0xd5, 0xbf, 0xa5, 0xa4, 0x1e, 0xf0, 0xeb,
+    0x18, 0xea, 0x53, 0xab, 0xb4, 0xde, 0xd4, 0x84, 0xa5, 0x3f, 0x46, 0xd4, 0x56, 0xd4, 0xd0, 0x65,
+    0xc5, 0x7b, 0x2a, 0xd9, 0x3c, 0xd7, 0x9e, 0x7e, 0x36, 0x1b, 0x59, 0x2a, 0xc3, 0xf1, 0x94, 0xe8,
+    0xda, 0x13, 0x63, 0xcd, 0x20, 0x66, 0x83, 0x25, 0x27, 0x6b, 0x27, 0x32, 0x5f, 0xb1, 0x9d, 0xa8,
+    0xb1, 0xfe, 0x62, 0xa0, 0xf8, 0xc3, 0x2b, 0x8e, 0x0f, 0x45, 0x4a, 0x11, 0xd9, 0x98, 0xe3, 0xab,
+    0xb3, 0x53, 0x0a, 0xd5, 0xe6, 0x81, 0x54, 0x33, 0xea, 0xf5, 0x45, 0x46, 0x01, 0x28, 0xa8, 0x0d,
+    0x29, 0xdb, 0xfb, 0x7b, 0x9d, 0xe2, 0x3e, 0xe8, 0x2f, 0xd1, 0x53, 0x92, 0xef, 0xee, 0x28, 0xac,
+    0x0b, 0x74, 0xf1, 0x41, 0x42, 0xbb, 0xfb, 0x9b, 0xdd, 0x96, 0xcd, 0xa7, 0x0d, 0xf3, 0xb0, 0x51,
+    0x3f, 0xf2, 0xf9, 0xc8, 0xb1, 0xd5, 0x63, 0x37, 0xc9, 0xb8, 0xde, 0x0e, 0xfc, 0x5b, 0xff, 0x80,
+    0x5c, 0x14, 0x92, 0x6e, 0x86, 0x1f, 0xfb, 0x5c, 0x68, 0x44, 0x37, 0x93, 0xe2, 0x20, 0xa1, 0x37,
+    0x96, 0x1c, 0x57, 0x7d, 0x19, 0xfe, 0x14, 0xd5, 0xc2, 0xab, 0x46, 0x1b, 0x87, 0x47, 0x4b, 0x79,
+    0xc2, 0x3a, 0x92, 0x4a, 0xdf, 0xad, 0x96, 0x8b, 0x7e, 0xd0, 0x68, 0x0a, 0x8e, 0x17, 0xf3, 0xab,
+    0x91, 0x36, 0x1e, 0x69, 0x33, 0xa0, 0xc3, 0x57, 0x68, 0xda, 0x71, 0xe5, 0x8b, 0x58, 0x74, 0x94,
+    0x09, 0xe2, 0xf5, 0x5b, 0xe5, 0xa0, 0xc3, 0x25, 0x54, 0x41, 0x62, 0x8e, 0x54, 0x72, 0xdb, 0x2f,
+    0xec, 0xd1, 0x42, 0x61, 0xf4, 0x4c, 0x59, 0x2a, 0x7e, 0x4a, 0x41, 0x68, 0x99, 0xb9, 0x89, 0xa1,
+    0xad, 0x62, 0xa6, 0x2d, 0x34, 0x55, 0xf1, 0x8e, 0xce, 0xa3, 0x96, 0xea, 0x92, 0xac, 0x1c, 0xb3,
+    0x55, 0x68, 0xae, 0x7f, 0xb9, 0x81, 0xb7, 0xb0, 0xcb, 0x67, 0x91, 0xba, 0xe1, 0xcc, 0x75, 0xe7,
+    0x06, 0x7e, 0x86, 0xdd, 0x4e, 0xa7, 0xf3, 0xd8, 0x7b, 0x55, 0xdf, 0xb5, 0x54, 0xd5, 0xd7, 0x7e,
+    0xad, 0xea, 0x57, 0x7f, 0xac, 0xb9, 0x6c, 0x82, 0xda, 0xe2, 0x42, 0xf6, 0x4a, 0xa9, 0xb4, 0xc1,
+    0x46, 0x7c, 0xe2, 0x09, 0x38, 0xc4, 0x70, 0xae, 0x1d, 0x0c, 0xd1, 0x05, 0xed, 0xfc, 0x3d, 0x26,
+    0x68, 0xcb, 0x67, 0x88, 0x73, 0x22, 0xfb, 0xac, 0x84, 0x40, 0x93, 0x0a, 0x8a, 0xae, 0xac, 0x45,
+    0xe6, 0x7a, 0xef, 0xa6, 0x41, 0x3f, 0x2b, 0xd6, 0x77, 0x57, 0xaf, 0x73, 0x9e, 0x1a, 0x86, 0x1f,
+    0x1a, 0x3d, 0xf1, 0x04, 0x40, 0x52, 0x66, 0x91, 0xee, 0xbe, 0x56, 0x82, 0xee, 0x63, 0x3d, 0xb5,
+    0xcf, 0xda, 0xdc, 0xbe, 0xdd, 0x27, 0x43, 0x81, 0x65, 0x47, 0x7a, 0xea, 0xd9, 0xed, 0x4c, 0xb8,
+    0x71, 0x9c, 0xa2, 0xca, 0x9a, 0x6d, 0x93, 0x34, 0x7a, 0xfc, 0x15, 0xe4, 0xb9, 0xae, 0x6f, 0x6a,
+    0xcc, 0xaf, 0xd0, 0xc1, 0x98, 0x4e, 0xf2, 0x91, 0x7e, 0x4e, 0xbf, 0xde, 0x11, 0x0e, 0x5b, 0xb8,
+    0xa4, 0xa2, 0x32, 0x62, 0xa0, 0x47, 0x50, 0xf1, 0x53, 0xe9, 0x0c, 0x0b, 0x43, 0x16, 0x35, 0x3c,
+    0x61, 0x19, 0xe9, 0x31, 0x0a, 0x29, 0xc7, 0xaf, 0x80, 0xb1, 0x9a, 0x64, 0x4b, 0xcb, 0x25, 0x99,
+    0xbc, 0x42, 0xc9, 0x6a, 0xc2, 0xad, 0xe1, 0x43, 0xbf, 0xf7, 0x88, 0x3a, 0x7a, 0xf1, 0x20, 0xdc,
+    0x1e, 0xe7, 0xeb, 0x0f, 0x60, 0xdf, 0x90, 0xa4, 0xb5, 0xe4, 0xd6, 0x25, 0x9b, 0x19, 0x19, 0xa1,
+    0xa9, 0x18, 0xf4, 0xbd, 0x3d, 0x3f, 0xca, 0x68, 0xb9, 0x0c, 0x70, 0x8b, 0xe7, 0x96, 0x43, 0xaf,
+    0xb6, 0xfe, 0xfc, 0xac, 0xf2, 0xe1, 0xe2, 0x6c, 0x99, 0xd4, 0x53, 0xd2, 0x42, 0x3a, 0xb7, 0xa1,
+    0x1a, 0x91, 0xf5, 0xe1, 0xa9, 0xf5, 0x3f, 0x5b, 0xb7, 0x16, 0xf9, 0xe9, 0x59, 0x45, 0xbe, 0x71,
+    0xe4, 0x22, 0x93, 0xf4, 0xf7, 0x1f, 0x12, 0x5c, 0x46, 0x47, 0xe7, 0x0e, 0x00, 0x00,
+};
+
+static constexpr WebAsset WEB_ASSETS[] = {
+    { "/", "text/html", WEB_ASSET_INDEX_HTML_GZ, sizeof(WEB_ASSET_INDEX_HTML_GZ), "\"796c44ae88646cf2\"", "no-cache" },
+    { "/style.css", "text/css", WEB_ASSET_STYLE_CSS_GZ, sizeof(WEB_ASSET_STYLE_CSS_GZ), "\"f03078533cda72d6\"", "public, max-age=31536000, immutable" },
+    { "/app.js", "application/javascript", WEB_ASSET_APP_JS_GZ, sizeof(WEB_ASSET_APP_JS_GZ), "\"a79ae796fe419700\"", "public, max-age=31536000, immutable" },
+};
@@ -8,13 +8,23 @@
 #include <sys/time.h>           // For settimeofday
 #include <FS.h> 
 #include <LittleFS.h> 
+#include <stdarg.h>
 
 #include "config.h"
 #include "data_logger.h" 
+#include "data_rollup.h"
 #include "time_manager.h" 
 #include "settings_manager.h" 
 #include "system_logger.h" 
 #include "external_rtc.h"
+#include "hal/hal_wifi.h"
+#include "wifi_manager.h"
+#include "metrics.h"
+#include "live_data.h"
+#include "subsystem.h"
+#include "web_assets.h" // Generated from web/ by tools/embed_web_assets.py
+#include "trace.h"
+#include "scheduler.h"
 
 #define LOG_TAG "WEB"
 
@@ -22,6 +32,11 @@
 // Create AsyncWebServer object on port 80
 AsyncWebServer server(WEBSERVER_PORT); 
 
+// Live readings pushed to the browser (Server-Sent Events)
+static AsyncEventSource liveEvents("/events");
+
+extern int deep_sleep_count; // main.cpp (RTC memory)
+
 static uint64_t webServerLastActivityTime = 0;
 static bool isServerRunning = false;
 
@@ -30,7 +45,30 @@ static void setupWebServerRoutes_internal();
 static void resetWebServerActivityTimer_internal();
 static bool isWebServerTimeoutReached_internal();
 static void stopWebServer_internal();
-String getRootHtml(); // Helper to generate HTML
+static size_t fillCsvChunk_internal(size_t &nextRecord, uint8_t *buffer, size_t maxLen, size_t index);
+
+// Cursor state for a streamed /api/history response
+struct HistoryQuery {
+    bool newestFirst;    // Page mode: walk backwards from the tail
+    size_t nextRecord;   // Window mode: next record. Page mode: one past the next record.
+    uint32_t to;         // Window mode: inclusive upper time bound (epoch seconds)
+    size_t remaining;    // Records still allowed by ?limit= or ?size=
+    bool firstRow;       // No separator before the first row
+    bool finished;       // Closing bracket written
+    char opening[112];   // JSON written before the first row
+};
+static size_t fillHistoryChunk_internal(HistoryQuery &query, uint8_t *buffer, size_t maxLen, size_t index);
+
+// Cursor state for a streamed /api/rollup response
+struct RollupQuery {
+    RollupTier tier;
+    size_t nextBucket;   // Next bucket to emit
+    uint32_t to;         // Inclusive upper bound on period start (epoch seconds)
+    size_t remaining;    // Buckets still allowed by ?limit=
+    bool firstRow;       // No separator before the first row
+    bool finished;       // Closing bracket written
+};
+static size_t fillRollupChunk_internal(RollupQuery &query, uint8_t *buffer, size_t maxLen, size_t index);
 
 // --- PUBLIC FUNCTIONS ---
 
@@ -45,6 +83,9 @@ bool activateWebServer() {
         return false;
     }
 
+    // Make sure buffered samples are on flash before clients can read the datalog
+    DataLogger_flush();
+
     // Configure URL routes and handlers
     setupWebServerRoutes_internal();
     
@@ -71,6 +112,10 @@ void handleWebServerClients() {
     // Kept empty to maintain compatibility with app_controller structure.
 }
 
+void resetWebServerIdleTimer() {
+    webServerLastActivityTime = millis();
+}
+
 bool stopWebServerIfIdle() {
     if (isServerRunning && isWebServerTimeoutReached_internal()) {
         stopWebServer_internal();
@@ -79,6 +124,27 @@ bool stopWebServerIfIdle() {
     return false;
 }
 
+unsigned long getWebServerIdleRemainingMs() {
+    uint64_t idleMs = millis() - webServerLastActivityTime;
+    return (idleMs >= WEB_SERVER_INACTIVITY_TIMEOUT) ? 0 : (unsigned long)(WEB_SERVER_INACTIVITY_TIMEOUT - idleMs);
+}
+
+void publishLiveSample(const LiveSample& sample) {
+    if (!isServerRunning || liveEvents.count() == 0) return;
+
+    // Backpressure: a browser on a weak soft-AP link must not pile up queued
+    // packets in the heap. A skipped sample stays in the ring and is replayed
+    // by id when the browser reconnects.
+    if (liveEvents.avgPacketsWaiting() > LIVE_MAX_QUEUED_PACKETS) {
+        LOG_DEBUG(LOG_TAG, "Live view: clients behind, skipping sample %lu.", (unsigned long)sample.id);
+        return;
+    }
+
+    char json[112];
+    LiveData_formatJson(sample, json, sizeof(json));
+    liveEvents.send(json, "sample", sample.id);
+}
+
 bool isWebServerActive() {
     return isServerRunning;
 }
@@ -87,6 +153,7 @@ bool isWebServerActive() {
 
 static void resetWebServerActivityTimer_internal() {
     webServerLastActivityTime = millis();
+    Scheduler_post(EVENT_WEB_ACTIVITY); // Dropped if the queue is full; the timestamp above still counts
 }
 
 static bool isWebServerTimeoutReached_internal() {
@@ -95,6 +162,7 @@ static bool isWebServerTimeoutReached_internal() {
 
 static void stopWebServer_internal() {
     if (isServerRunning) {
+        liveEvents.close();
         server.end(); // Use .end() for AsyncWebServer
         delay(100); // Allow time for server to close connections
         isServerRunning = false;
@@ -102,199 +170,506 @@ static void stopWebServer_internal() {
     }
 }
 
-// --- HTML GENERATOR ---
-String getRootHtml() {
-    float h = DataLogger_getLastHumidity();
-    float t = DataLogger_getLastTemperature();
-    String timeStr = DataLogger_getLastLogTime();
-
-    String html = R"raw(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>ESP32 Logger</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1">
-    <style>
-        body { font-family: -apple-system, BlinkMacSystemFont, "Segoe UI", Roboto, Helvetica, Arial, sans-serif; text-align: center; margin: 20px; background-color: #f4f7f6; color: #333; }
-        .container { max-width: 800px; margin: 0 auto; }
-        
-        /* Card Style */
-        .card { background: #fff; padding: 20px; margin-bottom: 20px; border-radius: 12px; box-shadow: 0 4px 6px rgba(0,0,0,0.1); }
-        
-        /* Typography */
-        h2 { color: #2c3e50; margin-bottom: 10px; font-weight: 600;}
-        h3 { border-bottom: 2px solid #f0f0f0; padding-bottom: 10px; margin-top: 0; color: #555; font-size: 1.2rem; }
-        
-        /* Sensor Values */
-        .sensor-row { display: flex; justify-content: space-around; align-items: center; margin-bottom: 10px; }
-        .val { font-size: 2.2em; font-weight: bold; color: #3498db; }
-        .unit { font-size: 0.5em; color: #7f8c8d; font-weight: normal; margin-left: 2px; }
-        .timestamp-label { font-size: 0.85rem; color: #888; margin-top: 5px; font-style: italic; }
-
-        /* Inputs & Buttons */
-        button, input[type=submit], .btn-link { display: block; box-sizing: border-box; background: #3498db; color: white; border: none; padding: 12px; border-radius: 8px; cursor: pointer; width: 100%; font-size: 1rem; margin-top: 15px; font-weight: 500; transition: background 0.2s; text-decoration: none;}
-        button:hover, input[type=submit]:hover, .btn-link:hover { background: #2980b9; }
-        .btn-secondary { background: #7f8c8d; margin-top: 5px; }
-        .btn-secondary:hover { background: #636e72; }
-        
-        /* Form Layout Helpers */
-        .form-row { display: flex; gap: 10px; flex-wrap: wrap; }
-        .form-row input { flex: 1; min-width: 70px; } /* Ensures inputs assume full width on very small screens or share space on large ones */
-
-        /* Data Table Styles */
-        .table-scroll { max-height: 400px; overflow-y: auto; display: block; border: 1px solid #eee; border-radius: 4px; }
-        table { width: 100%; border-collapse: collapse; font-size: 0.85rem; }
-        th, td { padding: 12px 8px; text-align: center; border-bottom: 1px solid #eee; }
-        th { background-color: #f8f9fa; color: #555; font-weight: 600; position: sticky; top: 0; box-shadow: 0 1px 2px rgba(0,0,0,0.05); }
-        tr:nth-child(even) { background-color: #fbfbfb; }
-        .loading { padding: 20px; color: #888; font-style: italic; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h2>ESP32 Environment Logger</h2>
-        
-        <div class="card">
-            <h3>Current Readings</h3>
-            <div class="sensor-row">
-                <div>
-                    <div style="font-size:0.9rem; color:#888;">Temperature</div>
-                    <div class="val">)raw";
-    html += (isnan(t) ? "--" : String(t, 1));
-    html += R"raw(<span class="unit">&deg;C</span></div>
-                </div>
-                <div>
-                    <div style="font-size:0.9rem; color:#888;">Humidity</div>
-                    <div class="val">)raw";
-    html += (isnan(h) ? "--" : String(h, 1));
-    html += R"raw(<span class="unit">%</span></div>
-                </div>
-            </div>
-            <div class="timestamp-label">Measured at: )raw";
-    html += timeStr;
-    html += R"raw(</div>
-        </div>
-
-        <div class="card">
-            <h3>Log History</h3>
-            <div class="table-scroll">
-                <div id="dataTable" class="loading">Fetching data...</div>
-            </div>
-            <button onclick="location.href='/download'">Download CSV File</button>
-        </div>
-
-        <div class="card">
-            <h3>System Settings</h3>
-            
-            <form action="/set_time" method="GET">
-                <div style="text-align:left; margin-bottom:5px; font-weight:bold; color:#666;">Set Date & Time</div>
-                
-                <div class="form-row">
-                   <input type="number" name="Y" placeholder="Year" required style="flex:2">
-                   <input type="number" name="M" placeholder="Month" required>
-                   <input type="number" name="D" placeholder="Day" required>
-                </div>
-
-                <div class="form-row">
-                   <input type="number" name="h" placeholder="Hour" required>
-                   <input type="number" name="m" placeholder="Minute" required>
-                </div>
-                
-                <input type="submit" value="Update Time" style="background: #7f8c8d;"> 
-                
-                <div style="font-size: 0.8rem; color: #999; margin-top: 5px;">Current System Time: )raw";
-    html += timeStr;
-    html += R"raw(</div>
-            </form>
-            
-            <hr style="border:0; border-top:1px solid #eee; margin:25px 0;">
-
-            <form action="/set_wifi" method="POST">
-                <div style="text-align:left; margin-bottom:5px; font-weight:bold; color:#666;">WiFi Configuration</div>
-                <input type="text" name="ssid" placeholder="Network Name (SSID)" required>
-                <input type="password" name="pass" placeholder="Network Password">
-                <input type="submit" value="Save Credentials & Restart" style="background:#e74c3c">
-            </form>
-            <p><small style="color:#999;">Active SSID: )raw";
-    html += Settings.getWifiSSID();
-    html += R"raw(</small></p>
-
-            <hr style="border:0; border-top:1px solid #eee; margin:25px 0;">
-    
-            <div style="text-align:left; margin-bottom:5px; font-weight:bold; color:#666;">Diagnostics</div>
-            <a href="/log" target="_blank" class="btn-link btn-secondary">View System Log (Debug)</a>
-
-        </div>
-    </div>
-
-    <script>
-        document.addEventListener('DOMContentLoaded', function() {
-            fetch('/download')
-            .then(response => {
-                if (!response.ok) throw new Error("No data");
-                return response.text();
-            })
-            .then(csvText => {
-                const lines = csvText.trim().split('\n');
-                if (lines.length < 2) {
-                    document.getElementById('dataTable').innerHTML = "<div style='padding:20px'>No data logged yet.</div>";
-                    return;
-                }
-
-                const headers = lines[0].split(',');
-                // Reverse to show newest first
-                const dataLines = lines.slice(1).reverse();
-
-                let tableHtml = '<table><thead><tr>';
-                headers.forEach(h => tableHtml += '<th>' + h + '</th>');
-                tableHtml += '</tr></thead><tbody>';
-
-                dataLines.forEach(line => {
-                    const cols = line.split(',');
-                    if(cols.length > 1) { 
-                        tableHtml += '<tr>';
-                        cols.forEach(col => tableHtml += '<td>' + col + '</td>');
-                        tableHtml += '</tr>';
-                    }
-                });
-                tableHtml += '</tbody></table>';
-
-                document.getElementById('dataTable').innerHTML = tableHtml;
-            })
-            .catch(error => {
-                console.error('Error:', error);
-                document.getElementById('dataTable').innerHTML = "<div style='padding:20px; color:red'>Error loading data.</div>";
-            });
-        });
-    </script>
-</body>
-</html>
-)raw";
-    return html;
+/**
+ * @brief Chunked-response filler that renders the binary datalog as CSV.
+ * Only whole lines are emitted; a line that does not fit is sent in the next chunk.
+ * @param nextRecord Cursor into the datalog, advanced as lines are written.
+ * @return Bytes written to buffer. 0 ends the response.
+ */
+static size_t fillCsvChunk_internal(size_t &nextRecord, uint8_t *buffer, size_t maxLen, size_t index) {
+    TRACE_SCOPE("web.download_chunk");
+    size_t written = 0;
+
+    // 1. Header line on the first chunk
+    if (index == 0) {
+        int len = snprintf((char*)buffer, maxLen, "%s\n", DataLogger_getCsvHeader());
+        if (len < 0 || (size_t)len >= maxLen) return 0;
+        written = (size_t)len;
+    }
+
+    // 2. Records, read from flash in small batches
+    SensorRecord records[16];
+    char line[64];
+    while (written < maxLen) {
+        size_t count = DataLogger_readRecords(nextRecord, records, sizeof(records) / sizeof(records[0]));
+        if (count == 0) break; // End of datalog
+
+        for (size_t i = 0; i < count; i++) {
+            if (!DataLogger_isRecordValid(records[i])) {
+                nextRecord++; // Skip corrupted records
+                continue;
+            }
+            size_t len = DataLogger_formatCsvRow(records[i], line, sizeof(line));
+            if (written + len > maxLen) return written; // Chunk full
+            memcpy(buffer + written, line, len);
+            written += len;
+            nextRecord++;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Chunked-response filler for /api/history.
+ * Window mode streams records oldest-first from an index lookup and skips
+ * records without a valid timestamp. Page mode streams newest-first by
+ * reading the datalog backwards from the tail, so a page costs the same
+ * regardless of how long the log is.
+ * Rows are [epoch,temperature,humidity,flags]. Records with a bad CRC are skipped.
+ * @return Bytes written to buffer. 0 ends the response.
+ */
+static size_t fillHistoryChunk_internal(HistoryQuery &query, uint8_t *buffer, size_t maxLen, size_t index) {
+    TRACE_SCOPE("web.history_chunk");
+    if (query.finished) return 0;
+
+    char *out = (char*)buffer;
+    size_t written = 0;
+
+    // 1. Opening on the first chunk
+    if (index == 0) {
+        int len = snprintf(out, maxLen, "%s", query.opening);
+        if (len < 0 || (size_t)len >= maxLen) return 0;
+        written = (size_t)len;
+    }
+
+    // 2. Rows until the window, the limit or the chunk is exhausted
+    const size_t batchSize = 16;
+    SensorRecord records[batchSize];
+    char row[48];
+    bool endOfWindow = (query.remaining == 0);
+    while (!endOfWindow) {
+        size_t count;
+        if (query.newestFirst) {
+            if (query.nextRecord == 0) break; // Reached the oldest record
+            size_t wanted = (query.nextRecord < batchSize) ? query.nextRecord : batchSize;
+            count = DataLogger_readRecords(query.nextRecord - wanted, records, wanted);
+            if (count != wanted) break;
+        } else {
+            count = DataLogger_readRecords(query.nextRecord, records, batchSize);
+        }
+        if (count == 0) break; // End of datalog
+
+        for (size_t i = 0; i < count; i++) {
+            const SensorRecord &r = query.newestFirst ? records[count - 1 - i] : records[i];
+            bool usable = DataLogger_isRecordValid(r) &&
+                          (query.newestFirst || (r.flags & RECORD_FLAG_TIME_VALID));
+
+            if (usable && !query.newestFirst && r.epoch > query.to) {
+                endOfWindow = true;
+                break;
+            }
+
+            if (usable) {
+                int len = snprintf(row, sizeof(row), "%s[%lu,%.2f,%.2f,%u]", query.firstRow ? "" : ",",
+                                   (unsigned long)r.epoch, r.temperature / 100.0f, r.humidity / 100.0f, r.flags);
+                if (len < 0 || written + (size_t)len > maxLen) return written; // Chunk full
+
+                memcpy(out + written, row, (size_t)len);
+                written += (size_t)len;
+                query.firstRow = false;
+            }
+
+            if (query.newestFirst) query.nextRecord--;
+            else query.nextRecord++;
+
+            if (usable && --query.remaining == 0) {
+                endOfWindow = true;
+                break;
+            }
+        }
+    }
+
+    // 3. Closing brackets (may spill into the next chunk)
+    if (written + 2 > maxLen) return written;
+    memcpy(out + written, "]}", 2);
+    query.finished = true;
+    return written + 2;
+}
+
+/**
+ * @brief Chunked-response filler for /api/rollup.
+ * Rows are [start,count,tempMin,tempMax,tempMean,humMin,humMax,humMean].
+ * @return Bytes written to buffer. 0 ends the response.
+ */
+static size_t fillRollupChunk_internal(RollupQuery &query, uint8_t *buffer, size_t maxLen, size_t index) {
+    TRACE_SCOPE("web.rollup_chunk");
+    if (query.finished) return 0;
+
+    char *out = (char*)buffer;
+    size_t written = 0;
+
+    // 1. Opening on the first chunk
+    if (index == 0) {
+        int len = snprintf(out, maxLen,
+                           "{\"res\":\"%s\",\"fields\":[\"start\",\"count\",\"tempMin\",\"tempMax\",\"tempMean\",\"humMin\",\"humMax\",\"humMean\"],\"rows\":[",
+                           DataRollup_getTierName(query.tier));
+        if (len < 0 || (size_t)len >= maxLen) return 0;
+        written = (size_t)len;
+    }
+
+    // 2. Rows
+    RollupBucket buckets[8];
+    char row[96];
+    bool endOfWindow = (query.remaining == 0);
+    while (!endOfWindow) {
+        size_t count = DataRollup_read(query.tier, query.nextBucket, buckets, sizeof(buckets) / sizeof(buckets[0]));
+        if (count == 0) break;
+
+        for (size_t i = 0; i < count; i++) {
+            const RollupBucket &b = buckets[i];
+            if (b.periodStart > query.to) {
+                endOfWindow = true;
+                break;
+            }
+
+            int len = snprintf(row, sizeof(row), "%s[%lu,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f]",
+                               query.firstRow ? "" : ",",
+                               (unsigned long)b.periodStart, (unsigned long)b.count,
+                               b.tempMin / 100.0f, b.tempMax / 100.0f, (float)b.tempSum / (float)b.count / 100.0f,
+                               b.humMin / 100.0f, b.humMax / 100.0f, (float)b.humSum / (float)b.count / 100.0f);
+            if (len < 0 || written + (size_t)len > maxLen) return written; // Chunk full
+
+            memcpy(out + written, row, (size_t)len);
+            written += (size_t)len;
+            query.firstRow = false;
+            query.nextBucket++;
+
+            if (--query.remaining == 0) {
+                endOfWindow = true;
+                break;
+            }
+        }
+    }
+
+    // 3. Closing brackets (may spill into the next chunk)
+    if (written + 2 > maxLen) return written;
+    memcpy(out + written, "]}", 2);
+    query.finished = true;
+    return written + 2;
+}
+
+// --- CONDITIONAL RESPONSES ---
+
+/**
+ * @brief Checks If-None-Match against our (strong) ETag.
+ * The header may list several tags separated by commas, and caches may send
+ * them back weak (W/"..."): If-None-Match uses the weak comparison, so the
+ * prefix is ignored. "*" matches any version.
+ */
+static bool isNotModified_internal(AsyncWebServerRequest *request, const char *etag) {
+    const AsyncWebHeader *ifNoneMatch = request->getHeader("If-None-Match");
+    if (!ifNoneMatch) return false;
+
+    size_t etagLen = strlen(etag);
+    const char *p = ifNoneMatch->value().c_str();
+    while (*p) {
+        // 1. Next tag, without surrounding blanks and the weak prefix
+        while (*p == ' ' || *p == '\t' || *p == ',') p++;
+        const char *end = p;
+        while (*end && *end != ',') end++;
+        const char *last = end;
+        while (last > p && (last[-1] == ' ' || last[-1] == '\t')) last--;
+        if (last - p >= 2 && p[0] == 'W' && p[1] == '/') p += 2;
+
+        // 2. Compare
+        size_t len = (size_t)(last - p);
+        if ((len == 1 && *p == '*') || (len == etagLen && strncmp(p, etag, len) == 0)) return true;
+        p = end;
+    }
+    return false;
+}
+
+static void sendNotModified_internal(AsyncWebServerRequest *request, const char *etag, const char *cacheControl = "no-cache") {
+    AsyncWebServerResponse *response = request->beginResponse(304);
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+}
+
+// --- STATIC ASSETS ---
+
+/**
+ * @brief Sends a pre-compressed asset straight from flash (no copy, no heap).
+ * Answers 304 when the browser already has this version.
+ */
+static void sendWebAsset_internal(AsyncWebServerRequest *request, const WebAsset &asset) {
+    if (isNotModified_internal(request, asset.etag)) {
+        sendNotModified_internal(request, asset.etag, asset.cacheControl);
+        return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse(200, asset.contentType, asset.data, asset.length);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", asset.cacheControl);
+    request->send(response);
+}
+
+// --- JSON RESPONSES ---
+// Bodies are built in one preallocated buffer: handlers run one at a time on the async_tcp task.
+static char s_json[512];
+
+static void appendJson_internal(size_t &len, const char *format, ...) {
+    if (len >= sizeof(s_json) - 1) return;
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(s_json + len, sizeof(s_json) - len, format, args);
+    va_end(args);
+    if (n > 0) len += (size_t)n;
+    if (len > sizeof(s_json) - 1) len = sizeof(s_json) - 1; // Truncated
+}
+
+/**
+ * @brief Appends src as a JSON string literal (quoted and escaped).
+ */
+static void appendJsonString_internal(size_t &len, const char *src) {
+    appendJson_internal(len, "\"");
+    for (; *src && len + 8 < sizeof(s_json); src++) {
+        unsigned char c = (unsigned char)*src;
+        if (c == '"' || c == '\\') {
+            s_json[len++] = '\\';
+            s_json[len++] = (char)c;
+        } else if (c < 0x20) {
+            appendJson_internal(len, "\\u%04x", c);
+        } else {
+            s_json[len++] = (char)c;
+        }
+    }
+    s_json[len] = '\0';
+    appendJson_internal(len, "\"");
+}
+
+static uint32_t fnv1a_internal(const char *data, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Sends s_json. With an ETag, clients must revalidate; without, nothing is cached.
+ */
+static void sendJson_internal(AsyncWebServerRequest *request, const char *etag) {
+    AsyncWebServerResponse *response = request->beginResponse(200, "application/json", s_json);
+    if (etag) {
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", "no-cache");
+    } else {
+        response->addHeader("Cache-Control", "no-store");
+    }
+    request->send(response);
 }
 
 // --- SETUP ROUTES (LAMBDA FUNCTIONS) ---
 static void setupWebServerRoutes_internal() {
 
-    // 1. ROOT (Home Page)
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
+    // 1. STATIC PAGE (index.html, style.css, app.js - gzip in flash, see web/)
+    for (const WebAsset &asset : WEB_ASSETS) {
+        server.on(asset.path, HTTP_GET, [&asset](AsyncWebServerRequest *request){
+            TRACE_SCOPE("web.asset");
+            resetWebServerActivityTimer_internal();
+            sendWebAsset_internal(request, asset);
+        });
+    }
+
+    // 1b. JSON API (current reading, device state, configuration)
+    // /api/current and /api/config answer If-None-Match with 304, so pollers only pay for changes
+    server.on("/api/current", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.current");
+        resetWebServerActivityTimer_internal();
+
+        // Keyed on the sample sequence: checked before anything is serialized
+        char etag[32];
+        snprintf(etag, sizeof(etag), "\"s%lu-%lx\"",
+                 (unsigned long)DataLogger_getSampleSequence(), (unsigned long)DataLogger_getLastLogEpoch());
+        if (isNotModified_internal(request, etag)) {
+            sendNotModified_internal(request, etag);
+            return;
+        }
+
+        float t = DataLogger_getLastTemperature();
+        float h = DataLogger_getLastHumidity();
+        size_t len = 0;
+        appendJson_internal(len, "{\"seq\":%lu", (unsigned long)DataLogger_getSampleSequence());
+        appendJson_internal(len, isnan(t) ? ",\"temperature\":null" : ",\"temperature\":%.1f", t);
+        appendJson_internal(len, isnan(h) ? ",\"humidity\":null" : ",\"humidity\":%.1f", h);
+        appendJson_internal(len, ",\"epoch\":%lu,\"time\":", (unsigned long)DataLogger_getLastLogEpoch());
+        appendJsonString_internal(len, DataLogger_getLastLogTime());
+        appendJson_internal(len, "}");
+        sendJson_internal(request, etag);
+    });
+
+    server.on("/api/status", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.status");
         resetWebServerActivityTimer_internal();
-        request->send(200, "text/html", getRootHtml());
+
+        char timeStr[32];
+        TimeManager_formatTime(timeStr, sizeof(timeStr));
+
+        size_t len = 0;
+        appendJson_internal(len, "{\"uptimeMs\":%lu,\"wakeCycles\":%d", (unsigned long)millis(), deep_sleep_count);
+        appendJson_internal(len, ",\"timeSet\":%s,\"epoch\":%lu,\"time\":",
+                            TimeManager_isTimeSet() ? "true" : "false", (unsigned long)time(nullptr));
+        appendJsonString_internal(len, timeStr);
+        appendJson_internal(len, ",\"lastNtpSync\":%lu,\"rtcDriftPpm\":%ld,\"slowClockDriftPpm\":%ld",
+                            (unsigned long)TimeManager_getLastNtpSyncEpoch(),
+                            (long)TimeManager_getExternalRtcDriftPpm(), (long)TimeManager_getSlowClockDriftPpm());
+        appendJson_internal(len, ",\"samples\":%lu,\"pendingSamples\":%u",
+                            (unsigned long)DataLogger_getSampleSequence(), (unsigned)DataLogger_getPendingCount());
+        bool usedLink = false;
+        uint32_t connectMs = wifi_manager_get_connect_time_ms(usedLink);
+        appendJson_internal(len, ",\"staConnected\":%s,\"staConnectMs\":%lu,\"staCachedLink\":%s",
+                            HalWifi_isConnected() ? "true" : "false", (unsigned long)connectMs,
+                            usedLink ? "true" : "false");
+        appendJson_internal(len, ",\"freeHeap\":%lu}", (unsigned long)ESP.getFreeHeap());
+        sendJson_internal(request, nullptr); // Changes every call
+    });
+
+    server.on("/api/config", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.config");
+        resetWebServerActivityTimer_internal();
+
+        char ssid[33];
+        Subsystem_require(SUBSYSTEM_SETTINGS);
+        Settings.getWifiSSID(ssid, sizeof(ssid));
+
+        size_t len = 0;
+        appendJson_internal(len, "{\"ssid\":");
+        appendJsonString_internal(len, ssid);
+        appendJson_internal(len, ",\"hostname\":\"%s\",\"sensor\":\"DHT%d\"", MDNS_HOSTNAME, (int)DHT_TYPE_DEF);
+        appendJson_internal(len, ",\"logIntervalS\":%lu,\"flushEveryN\":%u,\"webTimeoutS\":%lu",
+                            (unsigned long)LOG_INTERVAL_SECONDS, (unsigned)DATALOG_FLUSH_EVERY_N,
+                            (unsigned long)(WEB_SERVER_INACTIVITY_TIMEOUT / 1000));
+        if (DATALOG_DEADBAND_ENABLED) {
+            appendJson_internal(len, ",\"deadband\":{\"tempC\":%.1f,\"humPct\":%.1f,\"heartbeatS\":%lu}",
+                                DATALOG_DEADBAND_TEMP_C, DATALOG_DEADBAND_HUM_PCT,
+                                (unsigned long)DATALOG_HEARTBEAT_SECONDS);
+        }
+        appendJson_internal(len, "}");
+
+        // Small and rarely changing: key on a hash of the body
+        char etag[16];
+        snprintf(etag, sizeof(etag), "\"c%08lx\"", (unsigned long)fnv1a_internal(s_json, len));
+        if (isNotModified_internal(request, etag)) {
+            sendNotModified_internal(request, etag);
+            return;
+        }
+        sendJson_internal(request, etag);
     });
 
-    // 2. DOWNLOAD (Streams file from LittleFS - Non-blocking)
+    // 2. DOWNLOAD (CSV generated from the binary datalog - Chunked, Non-blocking)
     server.on("/download", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.download");
         resetWebServerActivityTimer_internal();
-        if (LittleFS.exists(LOG_FILE_NAME)) {
-            // send(FileSystem, Path, MimeType, Download=true)
-            request->send(LittleFS, LOG_FILE_NAME, "text/csv", true); 
-        } else {
+        if (DataLogger_getRecordCount() == 0) {
             request->send(404, "text/plain", "Log file not found.");
+            return;
         }
+
+        // Index of the next record to emit. Shared with the filler across chunks.
+        auto nextRecord = std::make_shared<size_t>(0);
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse("text/csv",
+            [nextRecord](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return fillCsvChunk_internal(*nextRecord, buffer, maxLen, index);
+            });
+        response->addHeader("Content-Disposition", String("attachment; filename=\"") + CSV_DOWNLOAD_NAME + "\"");
+        request->send(response);
+    });
+
+    // 2b. HISTORY API (Chunked JSON)
+    // Page mode:   GET /api/history?page=<n>&size=<m>   (newest first, page 0 = latest)
+    // Window mode: GET /api/history?from=<epoch>&to=<epoch>&limit=<n>   (oldest first)
+    server.on("/api/history", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.history");
+        resetWebServerActivityTimer_internal();
+
+        auto query = std::make_shared<HistoryQuery>();
+        query->firstRow = true;
+        query->finished = false;
+        query->to = UINT32_MAX;
+
+        if (request->hasParam("page")) {
+            long page = request->getParam("page")->value().toInt();
+            long size = request->hasParam("size") ? request->getParam("size")->value().toInt() : (long)HISTORY_PAGE_SIZE_DEFAULT;
+            if (page < 0) page = 0;
+            if (size < 1) size = 1;
+            if (size > (long)HISTORY_MAX_LIMIT) size = HISTORY_MAX_LIMIT;
+
+            // Pages are counted back from the tail; no need to touch older records
+            size_t total = DataLogger_getRecordCount();
+            size_t skip = (size_t)page * (size_t)size;
+
+            query->newestFirst = true;
+            query->nextRecord = (skip < total) ? total - skip : 0;
+            query->remaining = (size_t)size;
+            snprintf(query->opening, sizeof(query->opening),
+                     "{\"page\":%ld,\"size\":%ld,\"total\":%u,\"fields\":[\"epoch\",\"temperature\",\"humidity\",\"flags\"],\"records\":[",
+                     page, size, (unsigned)total);
+        } else {
+            uint32_t from = request->hasParam("from") ? strtoul(request->getParam("from")->value().c_str(), nullptr, 10) : 0;
+            long limit = request->hasParam("limit") ? request->getParam("limit")->value().toInt() : (long)HISTORY_DEFAULT_LIMIT;
+            if (request->hasParam("to")) query->to = strtoul(request->getParam("to")->value().c_str(), nullptr, 10);
+            if (limit < 1) limit = 1;
+            if (limit > (long)HISTORY_MAX_LIMIT) limit = HISTORY_MAX_LIMIT;
+
+            // Seek straight to the window start instead of scanning the whole log
+            query->newestFirst = false;
+            query->nextRecord = DataLogger_findFirstRecordAtOrAfter(from);
+            query->remaining = (size_t)limit;
+            snprintf(query->opening, sizeof(query->opening),
+                     "{\"fields\":[\"epoch\",\"temperature\",\"humidity\",\"flags\"],\"records\":[");
+        }
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+            [query](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return fillHistoryChunk_internal(*query, buffer, maxLen, index);
+            });
+        request->send(response);
+    });
+
+    // 2c. ROLLUP API (Pre-aggregated tiers - Chunked JSON)
+    // GET /api/rollup?res=hour|day|month&from=<epoch>&to=<epoch>&limit=<n>
+    server.on("/api/rollup", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.rollup");
+        resetWebServerActivityTimer_internal();
+
+        RollupTier tier = ROLLUP_DAY;
+        if (request->hasParam("res") && !DataRollup_parseTier(request->getParam("res")->value().c_str(), tier)) {
+            request->send(400, "text/plain", "Invalid res (use hour, day or month)");
+            return;
+        }
+
+        uint32_t from = request->hasParam("from") ? strtoul(request->getParam("from")->value().c_str(), nullptr, 10) : 0;
+        long limit = request->hasParam("limit") ? request->getParam("limit")->value().toInt() : (long)HISTORY_MAX_LIMIT;
+        if (limit < 1) limit = 1;
+        if (limit > (long)HISTORY_MAX_LIMIT) limit = HISTORY_MAX_LIMIT;
+
+        auto query = std::make_shared<RollupQuery>();
+        query->tier = tier;
+        query->nextBucket = DataRollup_findFirstAtOrAfter(tier, from);
+        query->to = request->hasParam("to") ? strtoul(request->getParam("to")->value().c_str(), nullptr, 10) : UINT32_MAX;
+        query->remaining = (size_t)limit;
+        query->firstRow = true;
+        query->finished = false;
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+            [query](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return fillRollupChunk_internal(*query, buffer, maxLen, index);
+            });
+        request->send(response);
+    });
+
+    // 2d. METRICS API (Wake cycle phase timings, microseconds)
+    server.on("/api/metrics", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.metrics");
+        resetWebServerActivityTimer_internal();
+        request->send(200, "application/json", Metrics_toJson());
     });
 
     // 3. SET TIME (GET Request)
     server.on("/set_time", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.set_time");
         resetWebServerActivityTimer_internal();
         
         // Validate inputs
@@ -318,6 +693,7 @@ static void setupWebServerRoutes_internal() {
 
     // 4. SET WIFI (POST Request)
     server.on("/set_wifi", HTTP_POST, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.set_wifi");
         resetWebServerActivityTimer_internal();
         
         // Check if SSID was posted
@@ -326,9 +702,14 @@ static void setupWebServerRoutes_internal() {
             String p = request->hasParam("pass", true) ? request->getParam("pass", true)->value() : "";
             
             // Save to NVS via SettingsManager
+            Subsystem_require(SUBSYSTEM_SETTINGS);
             Settings.saveWifiCredentials(s, p);
             
             request->send(200, "text/html", "<h1>Credentials Saved. Restarting...</h1>");
+
+            // RTC memory and the RAM log buffer do not survive a software restart
+            DataLogger_flush();
+            Logger_Flush();
             
             // Allow response to send before restarting
             delay(1000); 
@@ -340,16 +721,57 @@ static void setupWebServerRoutes_internal() {
 
     // 5. SYSTEM LOG VIEWER ---
     server.on("/log", HTTP_GET, [](AsyncWebServerRequest *request){
+        TRACE_SCOPE("web.log");
         resetWebServerActivityTimer_internal();
-        
-        // LOG_FILE_PATH comes from system_logger.h ("/system.log")
-        if (LittleFS.exists(LOG_FILE_PATH)) {
-            // send(FileSystem, Path, MimeType, Download=false)
-            request->send(LittleFS, LOG_FILE_PATH, "text/plain", false); 
-        } else {
-            request->send(200, "text/plain", "System log is empty or missing.");
+        Logger_Flush(); // Include lines still in the RAM buffer
+
+        // Segments are streamed oldest to newest. Shared with the filler across chunks.
+        auto cursor = std::make_shared<LogReadCursor>();
+        AsyncWebServerResponse *response = request->beginChunkedResponse(
+            SYSTEM_LOG_TOKENIZED ? "application/octet-stream" : "text/plain",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return Logger_ReadLog(*cursor, buffer, maxLen);
+            });
+        if (SYSTEM_LOG_TOKENIZED) {
+            // Binary frames: decode on the host with tools/decode_log.py
+            response->addHeader("Content-Disposition", "attachment; filename=\"syslog.bin\"");
+        }
+        request->send(response);
+    });
+
+    // 6. EVENT TRACE (Chrome trace-event JSON, open in chrome://tracing or ui.perfetto.dev)
+    server.on("/trace.json", HTTP_GET, [](AsyncWebServerRequest *request){
+        resetWebServerActivityTimer_internal();
+
+        // Events recorded while streaming are appended. Shared with the filler across chunks.
+        auto cursor = std::make_shared<TraceReadCursor>();
+        AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+            [cursor](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                return Trace_readJson(*cursor, buffer, maxLen);
+            });
+        response->addHeader("Content-Disposition", "attachment; filename=\"trace.json\"");
+        request->send(response);
+    });
+
+    // 7. LIVE READINGS (Server-Sent Events, see live_data.h)
+    liveEvents.onConnect([](AsyncEventSourceClient *client){
+        resetWebServerActivityTimer_internal();
+        if (liveEvents.count() > LIVE_MAX_CLIENTS) {
+            LOG_WARN(LOG_TAG, "Live view: %u clients already connected, closing the new one.", (unsigned)LIVE_MAX_CLIENTS);
+            client->close();
+            return;
+        }
+
+        // Catch up from the last event the browser saw (recent samples for a new page)
+        LiveSample samples[LIVE_REPLAY_MAX];
+        size_t count = LiveData_getSince(client->lastId(), samples, LIVE_REPLAY_MAX);
+        char json[112];
+        for (size_t i = 0; i < count; i++) {
+            LiveData_formatJson(samples[i], json, sizeof(json));
+            client->send(json, "sample", samples[i].id);
         }
     });
+    server.addHandler(&liveEvents);
 
     // 404 NOT FOUND
     server.onNotFound([](AsyncWebServerRequest *request){
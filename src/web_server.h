@@ -28,3 +28,23 @@ bool isWebServerActive();
  * @return true if the server was stopped.
  */
 bool stopWebServerIfIdle();
+
+/**
+ * @brief Time left until the inactivity timeout, by the server's own
+ * activity clock (0 if reached).
+ */
+unsigned long getWebServerIdleRemainingMs();
+
+/**
+ * @brief Restarts the inactivity timeout for activity outside the server
+ * (e.g. a button press).
+ */
+void resetWebServerIdleTimer();
+
+struct LiveSample;
+
+/**
+ * @brief Pushes a live sample to the browsers connected to /events.
+ * Skipped while clients are not keeping up (see LIVE_MAX_QUEUED_PACKETS).
+ */
+void publishLiveSample(const LiveSample& sample);
@@ -4,23 +4,122 @@
 #include "config.h"
 #include "settings_manager.h" 
 #include "system_logger.h"
-#include <ESPmDNS.h> 
+#include "hal/hal_wifi.h"
+#include "subsystem.h"
+#include "trace.h"
+#include "hal/hal_clock.h"
+#include "esp_system.h" // Needed for RTC_DATA_ATTR
 
 #define LOG_TAG "WIFI"
 
+// Last good link (survives deep sleep, not power loss). The next connect
+// joins its BSSID on its channel without scanning, and while the DHCP
+// lease is young (WIFI_LEASE_REUSE_S) also skips DHCP.
+RTC_DATA_ATTR static HalWifiLink s_link;
+RTC_DATA_ATTR static bool s_linkValid = false;
+RTC_DATA_ATTR static bool s_leaseValid = false;
+RTC_DATA_ATTR static uint64_t s_leaseRtcMs = 0;       // RTC clock when DHCP handed out s_link.ip
+RTC_DATA_ATTR static uint32_t s_lastConnectMs = 0;    // Last measured connect time, 0 = none
+RTC_DATA_ATTR static bool s_lastConnectUsedLink = false;
+
+// This wake only
+static bool s_offeredLease = false; // The connect attempt reuses the cached lease
+
 // --- PRIVATE HELPER FUNCTIONS ---
 
+/**
+ * @brief Parses a dotted IPv4 address.
+ * @return false if text is empty or malformed.
+ */
+static bool _parseAddress_internal(const char* text, uint8_t* out) {
+    unsigned int octets[4];
+    char extra;
+    if (sscanf(text, "%u.%u.%u.%u%c", &octets[0], &octets[1], &octets[2], &octets[3], &extra) != 4) {
+        return false;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (octets[i] > 255) return false;
+        out[i] = (uint8_t)octets[i];
+    }
+    return true;
+}
+
+/**
+ * @brief Fills in what is known ahead of the next connect.
+ * 1. BSSID and channel of the last good link (no scan).
+ * 2. Addresses: WIFI_STATIC_IP if set, else the cached lease while it is
+ *    young, else none (DHCP).
+ * @return false if nothing is known: plain scan and DHCP.
+ */
+static bool _prepareLink_internal(HalWifiLink& link) {
+    memset(&link, 0, sizeof(link));
+    s_offeredLease = false;
+    bool known = false;
+
+    // 1. Where the router was
+    if (WIFI_FAST_CONNECT_ENABLED && s_linkValid) {
+        memcpy(link.bssid, s_link.bssid, sizeof(link.bssid));
+        link.channel = s_link.channel;
+        known = true;
+    }
+
+    // 2. Which address to use
+    if (_parseAddress_internal(WIFI_STATIC_IP, link.ip) &&
+        _parseAddress_internal(WIFI_STATIC_GATEWAY, link.gateway) &&
+        _parseAddress_internal(WIFI_STATIC_SUBNET, link.subnet)) {
+        if (!_parseAddress_internal(WIFI_STATIC_DNS, link.dns)) {
+            memcpy(link.dns, link.gateway, sizeof(link.dns));
+        }
+        link.isLease = false;
+        known = true;
+    } else if (link.channel != 0 && s_leaseValid &&
+               HalClock_getRtcMicros() / 1000ULL - s_leaseRtcMs < WIFI_LEASE_REUSE_S * 1000ULL) {
+        memcpy(link.ip, s_link.ip, sizeof(link.ip));
+        memcpy(link.gateway, s_link.gateway, sizeof(link.gateway));
+        memcpy(link.subnet, s_link.subnet, sizeof(link.subnet));
+        memcpy(link.dns, s_link.dns, sizeof(link.dns));
+        link.isLease = true;
+        s_offeredLease = true;
+    }
+    return known;
+}
+
+/**
+ * @brief Records how the station connected, for the next connect and for
+ * /api/status. Called before the radio goes down.
+ */
+static void _saveLink_internal() {
+    bool usedLink = false;
+    uint32_t connectMs = HalWifi_getConnectTimeMs(usedLink);
+    HalWifiLink link;
+    if (connectMs == 0 || !HalWifi_getLink(link)) return;
+
+    s_lastConnectMs = connectMs;
+    s_lastConnectUsedLink = usedLink;
+
+    // A reused lease was not renewed: it keeps aging from the original DHCP
+    if (!(usedLink && s_offeredLease)) {
+        s_leaseRtcMs = HalClock_getRtcMicros() / 1000ULL;
+        s_leaseValid = true;
+    }
+    s_link = link;
+    s_linkValid = true;
+    LOG_INFO(LOG_TAG, "STA connect took %lu ms (%s).", (unsigned long)connectMs, usedLink ? "cached link" : "scan");
+}
+
 /**
  * @brief Internal helper to start the Access Point.
  * Contains the logic for softAP configuration and waiting for IP.
  */
 static bool _startAP_internal() {
+    TRACE_SCOPE("wifi.ap_start");
+
     // We use the fixed AP credentials from config.h
-    WiFi.softAP(AP_SSID, AP_PASSWORD); 
+    HalWifi_startAP(AP_SSID, AP_PASSWORD); 
     
     // Wait for IP address assignment (usually very fast for AP)
     unsigned long start = ::millis();
-    while (WiFi.softAPIP() == IPAddress(0,0,0,0)) {
+    while (HalWifi_getAPAddress() == "0.0.0.0") {
         if (::millis() - start > 2000) { // Short timeout (2s) is enough for AP
             LOG_ERROR(LOG_TAG, "AP Setup Failed.");
             return false;
@@ -28,43 +127,69 @@ static bool _startAP_internal() {
         ::delay(100); 
     }
 
-    String ipAddr = WiFi.softAPIP().toString();
+    String ipAddr = HalWifi_getAPAddress();
     LOG_INFO(LOG_TAG, "AP Started. IP: %s", ipAddr.c_str());
     return true;
 }
 
 /**
- * @brief Internal helper to connect to a Router (Station).
- * @param timeout_ms How long to block waiting for connection.
- * @return true if connected, false if timeout (but connection might continue in bg).
+ * @brief Internal helper to start connecting to a Router (Station).
+ * @return false if no SSID is configured.
  */
-static bool _connectSTA_internal(unsigned long timeout_ms) {
+static bool _beginSTA_internal() {
+    // Credentials live in NVS, opened on first use (defaults apply if that fails)
+    Subsystem_require(SUBSYSTEM_WIFI);
     String ssid = Settings.getWifiSSID();
     String pass = Settings.getWifiPassword();
 
     // Basic validation
     if (ssid == "") {
-        if (timeout_ms > 2000) {
-            LOG_WARN(LOG_TAG, "Skipping STA: No custom SSID configured.");
-        }
+        LOG_DEBUG(LOG_TAG, "Skipping STA: No custom SSID configured.");
         return false;
     }
 
-    LOG_INFO(LOG_TAG, "Connecting to: %s", ssid.c_str());
-    WiFi.begin(ssid.c_str(), pass.c_str());
+    HalWifiLink link;
+    if (_prepareLink_internal(link)) {
+        LOG_INFO(LOG_TAG, "Connecting to: %s (channel %u%s)", ssid.c_str(), link.channel,
+                 (link.ip[0] != 0) ? (link.isLease ? ", cached lease" : ", static IP") : "");
+        HalWifi_beginStation(ssid.c_str(), pass.c_str(), &link);
+    } else {
+        LOG_INFO(LOG_TAG, "Connecting to: %s", ssid.c_str());
+        HalWifi_beginStation(ssid.c_str(), pass.c_str());
+    }
+    return true;
+}
 
-    unsigned long start = ::millis(); 
-    while (WiFi.status() != WL_CONNECTED) {
-        // Check timeout
-        if (::millis() - start > timeout_ms) {
-            LOG_INFO(LOG_TAG, "STA Wait Timeout (waited %lu ms). Continuing in background...", timeout_ms);
-            return false;
+/**
+ * @brief Internal helper to connect to a Router (Station).
+ * @param timeout_ms How long to block waiting for connection.
+ * @return true if connected, false if timeout (but connection might continue in bg).
+ */
+static bool _connectSTA_internal(unsigned long timeout_ms) {
+    TRACE_SCOPE("wifi.connect");
+
+    if (!_beginSTA_internal()) {
+        return false;
+    }
+
+    {
+        TRACE_SCOPE("wifi.sta_wait"); // Blocking poll for association + DHCP
+        unsigned long start = ::millis(); 
+        while (!HalWifi_isConnected()) {
+            // Check timeout
+            if (::millis() - start > timeout_ms) {
+                LOG_INFO(LOG_TAG, "STA Wait Timeout (waited %lu ms). Continuing in background...", timeout_ms);
+                return false;
+            }
+            ::delay(100);
         }
-        ::delay(100);
     }
 
-    String ipAddr = WiFi.localIP().toString();
-    LOG_INFO(LOG_TAG, "STA Connected! IP: %s", ipAddr.c_str());
+    String ipAddr = HalWifi_getStationAddress();
+    bool usedLink = false;
+    uint32_t connectMs = HalWifi_getConnectTimeMs(usedLink);
+    LOG_INFO(LOG_TAG, "STA Connected in %lu ms (%s)! IP: %s", (unsigned long)connectMs,
+             usedLink ? "cached link" : "scan", ipAddr.c_str());
 
     // --- Unique mDNS Hostname Logic ---
     
@@ -72,7 +197,7 @@ static bool _connectSTA_internal(unsigned long timeout_ms) {
     String hostname = MDNS_HOSTNAME;
 
     // 2. Get MAC Address to make the name unique
-    String mac = WiFi.macAddress();
+    String mac = HalWifi_getMacAddress();
     // Format is "AA:BB:CC:DD:EE:FF". We remove colons.
     mac.replace(":", ""); 
     
@@ -82,7 +207,7 @@ static bool _connectSTA_internal(unsigned long timeout_ms) {
     hostname.toLowerCase(); // mDNS standards prefer lowercase
 
     // 4. Start mDNS
-    if (MDNS.begin(hostname.c_str())) {
+    if (HalWifi_startMdns(hostname.c_str())) {
         LOG_INFO(LOG_TAG, "mDNS responder started! URL: http://%s.local", hostname.c_str());
     } else {
         LOG_ERROR(LOG_TAG, "Error setting up mDNS responder!");
@@ -97,23 +222,29 @@ static bool _connectSTA_internal(unsigned long timeout_ms) {
 
 bool wifi_manager_init_AP() {
     LOG_INFO(LOG_TAG, "Setting mode: AP Only");
-    WiFi.mode(WIFI_AP);
+    HalWifi_setMode(HAL_WIFI_AP);
     return _startAP_internal();
 }
 
-bool wifi_manager_connect_STA() {
+bool wifi_manager_begin_STA() {
     LOG_INFO(LOG_TAG, "Setting mode: Station Only");
-    WiFi.mode(WIFI_STA);
-    
-    // For NTP sync, we wait the full timeout (critical operation)
-    return _connectSTA_internal(WIFI_CONNECT_TIMEOUT_MS);
+    HalWifi_setMode(HAL_WIFI_STA);
+
+    // Nothing waits for it: the caller hears back from the station handler
+    return _beginSTA_internal();
+}
+
+bool wifi_manager_has_credentials() {
+    Subsystem_require(SUBSYSTEM_SETTINGS);
+    char ssid[33];
+    return Settings.getWifiSSID(ssid, sizeof(ssid)) > 0;
 }
 
 bool wifi_manager_start_Interactive_DualMode() {
     LOG_INFO(LOG_TAG, "Setting mode: Dual (AP + Station)");
     
     // 1. Set Dual Mode (Critical step!)
-    WiFi.mode(WIFI_AP_STA);
+    HalWifi_setMode(HAL_WIFI_AP_STA);
 
     // 2. Start AP (Must work for user interaction immediately)
     bool apSuccess = _startAP_internal();
@@ -132,7 +263,7 @@ String wifi_manager_get_hostname() {
     String hostname = MDNS_HOSTNAME;
     
     // 2. Get MAC Address to make the name unique
-    String mac = WiFi.macAddress();
+    String mac = HalWifi_getMacAddress();
     // Format is "AA:BB:CC:DD:EE:FF". We remove colons.
     mac.replace(":", ""); 
     
@@ -144,9 +275,22 @@ String wifi_manager_get_hostname() {
     return hostname;
 }
 
+uint32_t wifi_manager_get_connect_time_ms(bool& usedLink) {
+    uint32_t connectMs = HalWifi_getConnectTimeMs(usedLink);
+    if (connectMs != 0) return connectMs;
+    usedLink = s_lastConnectUsedLink;
+    return s_lastConnectMs;
+}
+
+void wifi_manager_forget_lease() {
+    if (!s_offeredLease) return;
+    LOG_WARN(LOG_TAG, "Cached lease may be stale. Using DHCP next time.");
+    s_leaseValid = false;
+}
+
 void wifi_manager_turnOff() {
+    if (HalWifi_isConnected()) _saveLink_internal();
     LOG_INFO(LOG_TAG, "Turning off Wi-Fi radio...");
-    WiFi.softAPdisconnect(true);
-    WiFi.disconnect(true);  // true = turn off WiFi radio
-    WiFi.mode(WIFI_OFF);
+    HalWifi_turnOff();
+    Subsystem_release(SUBSYSTEM_WIFI);
 }
@@ -1,7 +1,7 @@
 // wifi_manager.h
 
 #pragma once
-#include <WiFi.h>
+#include <Arduino.h>
 
 /**
  * @brief Initializes WiFi in Access Point (AP) mode.
@@ -11,11 +11,17 @@
 bool wifi_manager_init_AP();
 
 /**
- * @brief Connects to WiFi in Station mode using stored credentials.
- * Retrieves SSID and password from Settings Manager.
- * @return true if connected successfully, false otherwise.
+ * @brief Starts connecting to WiFi in Station mode using stored credentials.
+ * Does not wait: the connection completes in the background (see
+ * HalWifi_setStationHandler()). Used for the background time sync.
+ * @return true if a connection attempt was started (an SSID is configured).
  */
-bool wifi_manager_connect_STA();
+bool wifi_manager_begin_STA();
+
+/**
+ * @brief Checks whether a station SSID is configured (opens NVS, not the radio).
+ */
+bool wifi_manager_has_credentials();
 
 /**
  * @brief Activates Dual Mode: AP + Station.
@@ -31,7 +37,24 @@ bool wifi_manager_start_Interactive_DualMode();
  */
 String wifi_manager_get_hostname();
 
+/**
+ * @brief Time from starting the station to its IP address: the current
+ * connection, or else the last one (RTC memory).
+ * @param usedLink Set if the cached BSSID/channel worked (no scan).
+ * @return Milliseconds, 0 if the station never connected since power-on.
+ */
+uint32_t wifi_manager_get_connect_time_ms(bool& usedLink);
+
+/**
+ * @brief Stops reusing the cached DHCP lease, if this connection did.
+ * Call when the network did not answer (e.g. no SNTP reply): the address
+ * may have been handed to another device.
+ */
+void wifi_manager_forget_lease();
+
 /**
  * @brief Turns off the Wi-Fi radio completely.
+ * A connected station's link (BSSID, channel, lease) and connect time are
+ * kept in RTC memory first, so the next connect can skip the scan.
  */
 void wifi_manager_turnOff();
@@ -0,0 +1,163 @@
+// test_data_logger.cpp
+// Datalog round trips through the native file system (a fresh temp directory).
+
+#include <unity.h>
+#include <stdlib.h>
+#include "config.h"
+#include "data_logger.h"
+#include "hal/native/native_runtime.h"
+
+static constexpr time_t BASE_EPOCH = 1767225600; // 2026-01-01 00:00:00 UTC
+static constexpr uint32_t STEP_S = 3600;
+static constexpr size_t SAMPLE_COUNT = 20;       // More than one flush batch
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Moves the virtual clock (real time and RTC timer) forward.
+ */
+static void advanceClock(uint32_t seconds) {
+    NativeClockState state = NativeClock_getState();
+    state.utcMicros += (uint64_t)seconds * 1000000ULL;
+    state.rtcMicros += (uint64_t)seconds * 1000000ULL;
+    NativeClock_setState(state);
+}
+
+/**
+ * @brief Logs count samples STEP_S apart, each outside the previous one's deadband.
+ */
+static void logSamples(size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        advanceClock(STEP_S);
+        TEST_ASSERT_EQUAL(DATALOG_WRITE_LOGGED, DataLogger_logSensorData((i % 2) ? 21.0f : 20.0f, 50.0f));
+    }
+}
+
+static time_t currentEpoch() {
+    NativeClockState state = NativeClock_getState();
+    return (time_t)(((int64_t)state.rtcMicros + state.systemOffsetMicros) / 1000000LL);
+}
+
+// --- TESTS ---
+
+void setUp() {}
+void tearDown() {}
+
+void test_logged_samples_read_back() {
+    size_t first = DataLogger_getRecordCount();
+    uint32_t firstEpoch = 0;
+
+    // 1. Log (each sample outside the deadband of the previous one)
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        advanceClock(STEP_S);
+        if (i == 0) firstEpoch = (uint32_t)currentEpoch();
+        float temperature = 18.0f + 0.5f * i;
+        float humidity = 40.0f + 2.5f * i;
+        TEST_ASSERT_EQUAL(DATALOG_WRITE_LOGGED, DataLogger_logSensorData(temperature, humidity, i == 3));
+    }
+    TEST_ASSERT_TRUE(DataLogger_flush());
+    TEST_ASSERT_EQUAL(0, DataLogger_getPendingCount());
+    TEST_ASSERT_EQUAL(first + SAMPLE_COUNT, DataLogger_getRecordCount());
+
+    // 2. Read back
+    SensorRecord records[SAMPLE_COUNT];
+    TEST_ASSERT_EQUAL(SAMPLE_COUNT, DataLogger_readRecords(first, records, SAMPLE_COUNT));
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        TEST_ASSERT_TRUE(DataLogger_isRecordValid(records[i]));
+        TEST_ASSERT_EQUAL_UINT32(firstEpoch + i * STEP_S, records[i].epoch);
+        TEST_ASSERT_EQUAL_INT16((int16_t)(1800 + 50 * i), records[i].temperature);
+        TEST_ASSERT_EQUAL_UINT16((uint16_t)(4000 + 250 * i), records[i].humidity);
+        TEST_ASSERT_TRUE(records[i].flags & RECORD_FLAG_TIME_VALID);
+        TEST_ASSERT_EQUAL(i == 3, (records[i].flags & RECORD_FLAG_DEGRADED) != 0);
+    }
+
+    // 3. Time lookup lands on the same records
+    TEST_ASSERT_EQUAL(first + 7, DataLogger_findFirstRecordAtOrAfter(firstEpoch + 7 * STEP_S));
+    TEST_ASSERT_EQUAL(first + 8, DataLogger_findFirstRecordAtOrAfter(firstEpoch + 7 * STEP_S + 1));
+    TEST_ASSERT_EQUAL(DataLogger_getRecordCount(), DataLogger_findFirstRecordAtOrAfter(currentEpoch() + 1));
+}
+
+void test_read_past_end_returns_nothing() {
+    SensorRecord record;
+    TEST_ASSERT_EQUAL(0, DataLogger_readRecords(DataLogger_getRecordCount(), &record, 1));
+}
+
+void test_deadband_skips_write_but_updates_latest() {
+    TEST_ASSERT_EQUAL(DATALOG_WRITE_LOGGED, DataLogger_logSensorData(22.0f, 50.0f));
+    TEST_ASSERT_TRUE(DataLogger_flush());
+    size_t count = DataLogger_getRecordCount();
+    uint32_t sequence = DataLogger_getSampleSequence();
+
+    // 1. Within the deadband, heartbeat not due: not written
+    advanceClock(STEP_S);
+    TEST_ASSERT_EQUAL(DATALOG_WRITE_SKIPPED, DataLogger_logSensorData(22.2f, 50.5f));
+    TEST_ASSERT_TRUE(DataLogger_flush());
+    TEST_ASSERT_EQUAL(count, DataLogger_getRecordCount());
+
+    // 2. The getters still show it
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 22.2f, DataLogger_getLastTemperature());
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 50.5f, DataLogger_getLastHumidity());
+    TEST_ASSERT_EQUAL_UINT32(sequence + 1, DataLogger_getSampleSequence());
+    TEST_ASSERT_EQUAL(1, DataLogger_getSkippedCount());
+
+    // 3. Compared with the last written sample, not the skipped one
+    advanceClock(STEP_S);
+    TEST_ASSERT_EQUAL(DATALOG_WRITE_LOGGED, DataLogger_logSensorData(22.35f, 50.0f));
+}
+
+void test_provisional_block_keeps_index_sorted() {
+    static SensorRecord records[400];
+    TEST_ASSERT_TRUE(DataLogger_flush());
+    size_t first = DataLogger_getRecordCount();
+
+    // 1. Trusted time
+    logSamples(100);
+    uint32_t trustedEnd = (uint32_t)currentEpoch();
+
+    // 2. Clock lost: provisional samples, several blocks of them
+    NativeClockState state = NativeClock_getState();
+    state.systemOffsetMicros = 0;
+    NativeClock_setState(state);
+    logSamples(200);
+
+    // 3. RTC timer reset with the time back: the stamps can no longer be
+    // resolved, so those blocks stay provisional in the middle of the file
+    state = NativeClock_getState();
+    state.rtcMicros = 1000000ULL;
+    state.systemOffsetMicros = ((int64_t)trustedEnd + 201LL * STEP_S) * 1000000LL - (int64_t)state.rtcMicros;
+    NativeClock_setState(state);
+    logSamples(100);
+    TEST_ASSERT_TRUE(DataLogger_flush());
+
+    TEST_ASSERT_EQUAL(first + 400, DataLogger_getRecordCount());
+    TEST_ASSERT_EQUAL(400, DataLogger_readRecords(first, records, 400));
+    TEST_ASSERT_TRUE(records[150].flags & RECORD_FLAG_PROVISIONAL);
+    TEST_ASSERT_FALSE(records[150].flags & RECORD_FLAG_TIME_VALID);
+
+    // 4. Time lookups on both sides of the provisional blocks
+    TEST_ASSERT_EQUAL(first + 50, DataLogger_findFirstRecordAtOrAfter(records[50].epoch));
+    TEST_ASSERT_EQUAL(first + 99, DataLogger_findFirstRecordAtOrAfter(trustedEnd));
+    TEST_ASSERT_EQUAL(first + 300, DataLogger_findFirstRecordAtOrAfter(trustedEnd + 1));
+    TEST_ASSERT_EQUAL(first + 350, DataLogger_findFirstRecordAtOrAfter(records[350].epoch));
+    TEST_ASSERT_EQUAL(first + 399, DataLogger_findFirstRecordAtOrAfter(records[399].epoch));
+}
+
+int main(int argc, char** argv) {
+    // Fresh simulation directory: empty file system, clock set to BASE_EPOCH
+    char root[] = "/tmp/datalogger_test_XXXXXX";
+    setenv("NATIVE_ROOT", mkdtemp(root), 1);
+    char* args[] = {argv[0], (char*)"--reset"};
+    NativeRuntime_begin(2, args);
+
+    NativeClockState state = NativeClock_getState();
+    state.systemOffsetMicros = (int64_t)BASE_EPOCH * 1000000LL - (int64_t)state.rtcMicros;
+    NativeClock_setState(state);
+    DataLogger_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_logged_samples_read_back);
+    RUN_TEST(test_read_past_end_returns_nothing);
+    RUN_TEST(test_deadband_skips_write_but_updates_latest);
+    RUN_TEST(test_provisional_block_keeps_index_sorted);
+    return UNITY_END();
+}
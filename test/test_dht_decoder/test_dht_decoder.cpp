@@ -0,0 +1,124 @@
+// test_dht_decoder.cpp
+// DhtDecoder_decode() against recorded pulse trains, as the ESP32 sensor HAL
+// hands them over: the short high after the line is released, the response,
+// 40 bits (low, then high) and the closing low. Timings jitter by a few us.
+
+#include <unity.h>
+#include <string.h>
+#include "dht_decoder.h"
+
+// DHT11: 45 %, 23.4 C (bytes 45 0 23 4, checksum 72)
+static const DhtPulse DHT11_TRAIN[] = {
+    {1, 26}, {0, 79}, {1, 84}, {0, 49}, {1, 25}, {0, 55}, {1, 25}, {0, 54},
+    {1, 74}, {0, 51}, {1, 22}, {0, 55}, {1, 68}, {0, 54}, {1, 71}, {0, 48},
+    {1, 27}, {0, 55}, {1, 70}, {0, 51}, {1, 26}, {0, 49}, {1, 24}, {0, 48},
+    {1, 22}, {0, 48}, {1, 27}, {0, 56}, {1, 22}, {0, 54}, {1, 27}, {0, 51},
+    {1, 25}, {0, 48}, {1, 26}, {0, 51}, {1, 28}, {0, 55}, {1, 25}, {0, 56},
+    {1, 23}, {0, 53}, {1, 69}, {0, 51}, {1, 28}, {0, 55}, {1, 70}, {0, 48},
+    {1, 71}, {0, 56}, {1, 73}, {0, 49}, {1, 23}, {0, 52}, {1, 22}, {0, 53},
+    {1, 27}, {0, 56}, {1, 25}, {0, 56}, {1, 28}, {0, 51}, {1, 70}, {0, 52},
+    {1, 26}, {0, 55}, {1, 28}, {0, 56}, {1, 25}, {0, 48}, {1, 71}, {0, 51},
+    {1, 27}, {0, 54}, {1, 25}, {0, 50}, {1, 70}, {0, 56}, {1, 27}, {0, 53},
+    {1, 22}, {0, 55}, {1, 27}, {0, 56},
+};
+
+// DHT22: 65.2 %, -10.1 C (bytes 0x02 0x8C 0x80 0x65, checksum 0x73)
+static const DhtPulse DHT22_TRAIN[] = {
+    {1, 23}, {0, 79}, {1, 81}, {0, 53}, {1, 28}, {0, 50}, {1, 27}, {0, 52},
+    {1, 24}, {0, 51}, {1, 26}, {0, 48}, {1, 26}, {0, 50}, {1, 25}, {0, 54},
+    {1, 74}, {0, 56}, {1, 24}, {0, 56}, {1, 71}, {0, 56}, {1, 24}, {0, 48},
+    {1, 28}, {0, 48}, {1, 24}, {0, 55}, {1, 70}, {0, 54}, {1, 71}, {0, 56},
+    {1, 23}, {0, 56}, {1, 23}, {0, 51}, {1, 69}, {0, 48}, {1, 23}, {0, 53},
+    {1, 23}, {0, 50}, {1, 26}, {0, 56}, {1, 24}, {0, 56}, {1, 27}, {0, 56},
+    {1, 23}, {0, 55}, {1, 28}, {0, 54}, {1, 27}, {0, 56}, {1, 74}, {0, 53},
+    {1, 74}, {0, 53}, {1, 24}, {0, 55}, {1, 23}, {0, 54}, {1, 73}, {0, 55},
+    {1, 27}, {0, 56}, {1, 69}, {0, 55}, {1, 24}, {0, 55}, {1, 72}, {0, 56},
+    {1, 74}, {0, 53}, {1, 73}, {0, 55}, {1, 25}, {0, 53}, {1, 26}, {0, 56},
+    {1, 73}, {0, 55}, {1, 71}, {0, 51},
+};
+
+static constexpr size_t TRAIN_LENGTH = 84;
+static_assert(sizeof(DHT11_TRAIN) / sizeof(DhtPulse) == TRAIN_LENGTH, "DHT11 train length");
+static_assert(sizeof(DHT22_TRAIN) / sizeof(DhtPulse) == TRAIN_LENGTH, "DHT22 train length");
+
+static constexpr size_t FIRST_BIT_LOW = 3;  // After the release high and the response
+static constexpr size_t CHECKSUM_LSB = 82;  // High pulse of the last bit
+
+static DhtPulse s_pulses[TRAIN_LENGTH];
+static float s_temperature;
+static float s_humidity;
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Decodes the working copy (s_pulses) starting at first.
+ */
+static DhtDecodeStatus decode(size_t first, size_t count, uint8_t sensorType) {
+    return DhtDecoder_decode(s_pulses + first, count, sensorType, s_temperature, s_humidity);
+}
+
+// --- TESTS ---
+
+void setUp() {
+    memcpy(s_pulses, DHT22_TRAIN, sizeof(s_pulses));
+    s_temperature = -99.0f;
+    s_humidity = -99.0f;
+}
+
+void tearDown() {}
+
+void test_dht11_ok() {
+    memcpy(s_pulses, DHT11_TRAIN, sizeof(s_pulses));
+    TEST_ASSERT_EQUAL(DHT_DECODE_OK, decode(0, TRAIN_LENGTH, 11));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 23.4f, s_temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 45.0f, s_humidity);
+}
+
+void test_dht22_negative_temperature() {
+    TEST_ASSERT_EQUAL(DHT_DECODE_OK, decode(0, TRAIN_LENGTH, 22));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -10.1f, s_temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 65.2f, s_humidity);
+}
+
+void test_truncated_leading_response_still_decodes() {
+    // Capture started late: release high and response missed
+    TEST_ASSERT_EQUAL(DHT_DECODE_OK, decode(FIRST_BIT_LOW, TRAIN_LENGTH - FIRST_BIT_LOW, 22));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -10.1f, s_temperature);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 65.2f, s_humidity);
+}
+
+void test_checksum_mismatch() {
+    s_pulses[CHECKSUM_LSB].durationUs = 25; // Last checksum bit read as 0
+    TEST_ASSERT_EQUAL(DHT_DECODE_CHECKSUM, decode(0, TRAIN_LENGTH, 22));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -99.0f, s_temperature); // Not written
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, -99.0f, s_humidity);
+}
+
+void test_missed_edge_is_bad_timing() {
+    // A missed edge merges a bit's low and high into one long pulse
+    s_pulses[41].durationUs = DHT_MAX_PULSE_US + 50;
+    TEST_ASSERT_EQUAL(DHT_DECODE_BAD_TIMING, decode(0, TRAIN_LENGTH, 22));
+}
+
+void test_first_bit_without_low_is_bad_timing() {
+    // Capture starts on the first bit's high pulse: nothing to compare it with
+    TEST_ASSERT_EQUAL(DHT_DECODE_BAD_TIMING, decode(FIRST_BIT_LOW + 1, TRAIN_LENGTH - FIRST_BIT_LOW - 1, 22));
+}
+
+void test_no_response() {
+    TEST_ASSERT_EQUAL(DHT_DECODE_NO_RESPONSE, decode(0, 0, 22));
+    TEST_ASSERT_EQUAL(DHT_DECODE_NO_RESPONSE, decode(0, 3, 22));  // Response only
+    TEST_ASSERT_EQUAL(DHT_DECODE_NO_RESPONSE, decode(10, 70, 22)); // Cut short
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_dht11_ok);
+    RUN_TEST(test_dht22_negative_temperature);
+    RUN_TEST(test_truncated_leading_response_still_decodes);
+    RUN_TEST(test_checksum_mismatch);
+    RUN_TEST(test_missed_edge_is_bad_timing);
+    RUN_TEST(test_first_bit_without_low_is_bad_timing);
+    RUN_TEST(test_no_response);
+    return UNITY_END();
+}
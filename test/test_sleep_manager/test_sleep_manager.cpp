@@ -0,0 +1,93 @@
+// test_sleep_manager.cpp
+// Sleep time calculations against the virtual clock of the native build.
+
+#include <unity.h>
+#include <stdlib.h>
+#include "config.h"
+#include "sleep_manager.h"
+#include "hal/native/native_runtime.h"
+
+static constexpr int64_t INTERVAL_MS = (int64_t)LOG_INTERVAL_SECONDS * 1000LL;
+static constexpr time_t BASE_EPOCH = 1767225600; // 2026-01-01 00:00:00 UTC
+
+// --- PRIVATE HELPER FUNCTIONS ---
+
+/**
+ * @brief Puts the RTC timer at rtcMs and, unless epoch is 0, sets the
+ * system clock to epoch at that moment (0 = never set since power-on).
+ */
+static void setClock(time_t epoch, uint64_t rtcMs) {
+    NativeClockState state = NativeClock_getState();
+    state.rtcMicros = rtcMs * 1000ULL;
+    state.systemOffsetMicros = epoch ? (int64_t)epoch * 1000000LL - (int64_t)state.rtcMicros : 0;
+    NativeClock_setState(state);
+}
+
+/**
+ * @brief First slot boundary of the wall-clock grid after BASE_EPOCH.
+ */
+static time_t firstSlot() {
+    int64_t intervalS = (int64_t)LOG_INTERVAL_SECONDS;
+    return (time_t)(((BASE_EPOCH + SLEEP_ALIGN_OFFSET_SEC) / intervalS + 1) * intervalS - SLEEP_ALIGN_OFFSET_SEC);
+}
+
+// --- TESTS ---
+
+void setUp() {}
+void tearDown() {}
+
+void test_sleep_time_subtracts_elapsed_and_overhead() {
+    TEST_ASSERT_EQUAL_INT64(8500000LL, calculateSleepTime(1000, 2000, 500, 10000));
+}
+
+void test_sleep_time_is_negative_when_overdue() {
+    // Unsigned inputs must not wrap around to a huge sleep
+    TEST_ASSERT_EQUAL_INT64(-5500000LL, calculateSleepTime(1000, 16000, 500, 10000));
+}
+
+void test_aligned_falls_back_without_valid_time() {
+    setClock(0, 90000);
+    int64_t expected = calculateSleepTime(60000, 90000, getWakeOverheadMs(), INTERVAL_MS);
+    TEST_ASSERT_EQUAL_INT64(expected, calculateAlignedSleepTime(60000, 90000));
+}
+
+void test_aligned_wakes_on_next_slot() {
+    // Sampled 100 s after a slot, 5 s ago: the next slot is one interval later
+    uint64_t sampleMs = 50000;
+    setClock(firstSlot() + 105, sampleMs + 5000);
+    int64_t expectedMs = INTERVAL_MS - 105000 - (int64_t)getWakeOverheadMs();
+    TEST_ASSERT_EQUAL_INT64(expectedMs * 1000LL, calculateAlignedSleepTime(sampleMs, sampleMs + 5000));
+}
+
+void test_aligned_early_wake_skips_its_own_slot() {
+    // Sampled 2 s before a slot: that slot is this sample's, not the next one
+    uint64_t sampleMs = 50000;
+    setClock(firstSlot() - 2, sampleMs);
+    int64_t expectedMs = INTERVAL_MS + 2000 - (int64_t)getWakeOverheadMs();
+    TEST_ASSERT_EQUAL_INT64(expectedMs * 1000LL, calculateAlignedSleepTime(sampleMs, sampleMs));
+}
+
+void test_aligned_is_negative_when_slot_passed() {
+    // Awake past the next slot (e.g. a long web session)
+    uint64_t sampleMs = 50000;
+    uint64_t nowMs = sampleMs + (uint64_t)INTERVAL_MS;
+    setClock(firstSlot() + 10 + LOG_INTERVAL_SECONDS, nowMs);
+    TEST_ASSERT_LESS_THAN(0, calculateAlignedSleepTime(sampleMs, nowMs));
+}
+
+int main(int argc, char** argv) {
+    // Fresh simulation directory: power-on reset, clock not set
+    char root[] = "/tmp/datalogger_test_XXXXXX";
+    setenv("NATIVE_ROOT", mkdtemp(root), 1);
+    char* args[] = {argv[0], (char*)"--reset"};
+    NativeRuntime_begin(2, args);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_sleep_time_subtracts_elapsed_and_overhead);
+    RUN_TEST(test_sleep_time_is_negative_when_overdue);
+    RUN_TEST(test_aligned_falls_back_without_valid_time);
+    RUN_TEST(test_aligned_wakes_on_next_slot);
+    RUN_TEST(test_aligned_early_wake_skips_its_own_slot);
+    RUN_TEST(test_aligned_is_negative_when_slot_passed);
+    return UNITY_END();
+}
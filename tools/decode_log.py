@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Decode a tokenized system log (SYSTEM_LOG_TOKENIZED=1) back to text.
+
+Usage:
+    python tools/decode_log.py .pio/build/<env>/firmware.elf syslog.bin [more files...]
+
+The input is the /log download or raw /syslogN.log segment files. Each frame
+holds the flash address of a "TAG\\x1fformat" string; the string is read from
+the firmware ELF, so the ELF must come from the same build as the device.
+See src/log_tokenizer.h for the frame layout.
+
+Requires pyelftools (pip install pyelftools).
+"""
+
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+LEVELS = {1: "ERROR", 2: "WARN ", 3: "INFO ", 4: "DEBUG"}
+TOKEN_DROPPED = 0
+SEGMENT_HEADER = re.compile(rb"#SEG (\d+)\n")
+
+# printf conversion: flags, width, precision, length, conversion
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t|L)?([diouxXcsfFeEgGaAp%])")
+
+
+class StringTable:
+    """Reads NUL-terminated strings from the ELF's allocated sections by address."""
+
+    def __init__(self, path):
+        self._sections = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                addr = section["sh_addr"]
+                if addr and section["sh_type"] == "SHT_PROGBITS":
+                    self._sections.append((addr, section.data()))
+        self._cache = {}
+
+    def lookup(self, address):
+        if address in self._cache:
+            return self._cache[address]
+        for start, data in self._sections:
+            if start <= address < start + len(data):
+                offset = address - start
+                end = data.index(b"\0", offset)
+                text = data[offset:end].decode("utf-8", "replace")
+                self._cache[address] = text
+                return text
+        return None
+
+
+class ArgReader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while self.pos < len(self.data):
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return value
+            shift += 7
+        raise ValueError("truncated varint")
+
+    def signed(self):
+        v = self.varint()
+        return (v >> 1) ^ -(v & 1)
+
+    def float(self):
+        if self.pos + 4 > len(self.data):
+            raise ValueError("truncated float")
+        (value,) = struct.unpack_from("<f", self.data, self.pos)
+        self.pos += 4
+        return value
+
+    def string(self):
+        length = self.data[self.pos]
+        self.pos += 1
+        text = self.data[self.pos:self.pos + length].decode("utf-8", "replace")
+        self.pos += length
+        return text
+
+
+def format_message(fmt, args):
+    """Rebuilds the message by decoding one argument per conversion in fmt."""
+    reader = ArgReader(args)
+    out = []
+    last = 0
+    for m in CONVERSION.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, width, precision, _length, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        try:
+            if width == "*":
+                width = str(reader.signed())
+            if precision == "*":
+                precision = str(reader.signed())
+            spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+            if conv in "fFeEgGaA":
+                out.append((spec + (conv if conv not in "aA" else "e")) % reader.float())
+            elif conv == "s":
+                out.append((spec + "s") % reader.string())
+            elif conv == "c":
+                out.append((spec + "c") % chr(reader.signed() & 0xFF))
+            elif conv == "p":
+                out.append("0x%08x" % (reader.signed() & 0xFFFFFFFF))
+            elif conv in "uxXo":
+                value = reader.signed()
+                if value < 0:
+                    value &= 0xFFFFFFFF  # Negative int printed as unsigned, as on the device
+                out.append((spec + conv) % value)
+            else:
+                out.append((spec + "d") % reader.signed())
+        except (ValueError, IndexError):
+            out.append("<?>")
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode(data, table):
+    pos = 0
+    while pos < len(data):
+        header = SEGMENT_HEADER.match(data, pos)
+        if header:
+            yield "--- segment %s ---" % header.group(1).decode()
+            pos = header.end()
+            continue
+
+        length = data[pos]
+        frame = data[pos + 1:pos + 1 + length]
+        pos += 1 + length
+        if len(frame) < 9:
+            yield "--- truncated frame ---"
+            break
+
+        token, millis, level = struct.unpack_from("<IIB", frame)
+        args = frame[9:]
+        stamp = "[%02d:%02d:%02d.%03d]" % (millis // 3600000, millis // 60000 % 60,
+                                           millis // 1000 % 60, millis % 1000)
+        level_str = LEVELS.get(level, "?    ")
+
+        if token == TOKEN_DROPPED:
+            yield "--- %d log lines dropped (buffer full) ---" % ArgReader(args).signed()
+            continue
+
+        entry = table.lookup(token)
+        if entry is None:
+            yield "%s [%s] [?] <unknown token 0x%08x>" % (stamp, level_str, token)
+            continue
+        tag, _, fmt = entry.partition("\x1f")
+        yield "%s [%s] [%s] %s" % (stamp, level_str, tag, format_message(fmt, args))
+
+
+def main(argv):
+    if len(argv) < 3:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+    table = StringTable(argv[1])
+    for path in argv[2:]:
+        with open(path, "rb") as f:
+            for line in decode(f.read(), table):
+                print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
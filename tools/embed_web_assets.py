@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Compress the web UI (web/) into src/web_assets.h.
+
+Usage:
+    python tools/embed_web_assets.py
+
+Also runs as a PlatformIO pre-build script (extra_scripts in platformio.ini),
+so editing a file under web/ is enough; the header is rewritten only when
+its content changes.
+
+Each file is gzip-compressed (level 9, no timestamp, so the output is
+reproducible) into a constexpr byte array that the web server sends as-is
+with Content-Encoding: gzip. The ETag is a hash of the compressed bytes.
+References to the other assets in index.html ("/style.css") get a
+"?v=<hash>" suffix, so those can be cached for a year and still change with
+the firmware; index.html itself is always revalidated (cheap 304).
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+ASSETS = [
+    # (file under web/, URL path, content type)
+    ("index.html", "/", "text/html"),
+    ("style.css", "/style.css", "text/css"),
+    ("app.js", "/app.js", "application/javascript"),
+]
+
+CACHE_REVALIDATE = "no-cache"
+CACHE_IMMUTABLE = "public, max-age=31536000, immutable"
+
+
+def compress(data):
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def etag(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def c_array(name, data):
+    lines = ["static constexpr uint8_t %s[] = {" % name]
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def build(root):
+    web_dir = os.path.join(root, "web")
+    sources = {}
+    for filename, path, _ in ASSETS:
+        with open(os.path.join(web_dir, filename), "rb") as f:
+            sources[filename] = f.read()
+
+    # Versioned references: the page names exactly the asset it was built with
+    compressed = {}
+    for filename, path, _ in ASSETS:
+        if filename.endswith(".html"):
+            continue
+        compressed[filename] = compress(sources[filename])
+    for filename, path, _ in ASSETS:
+        if not filename.endswith(".html"):
+            continue
+        page = sources[filename]
+        for other, other_path, _ in ASSETS:
+            if other in compressed:
+                ref = ('"%s"' % other_path).encode()
+                versioned = ('"%s?v=%s"' % (other_path, etag(compressed[other])[:8])).encode()
+                page = page.replace(ref, versioned)
+        compressed[filename] = compress(page)
+
+    out = [
+        "// web_assets.h",
+        "// Generated by tools/embed_web_assets.py from web/. Do not edit.",
+        "",
+        "#pragma once",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+        "struct WebAsset {",
+        "    const char* path;          // URL",
+        "    const char* contentType;",
+        "    const uint8_t* data;       // gzip, served as-is from flash",
+        "    size_t length;",
+        "    const char* etag;          // Quoted strong ETag",
+        "    const char* cacheControl;",
+        "};",
+        "",
+    ]
+    table = []
+    for i, (filename, path, content_type) in enumerate(ASSETS):
+        data = compressed[filename]
+        name = "WEB_ASSET_" + filename.upper().replace(".", "_") + "_GZ"
+        out.append("// %s: %d bytes, %d gzipped" % (filename, len(sources[filename]), len(data)))
+        out.append(c_array(name, data))
+        out.append("")
+        cache = CACHE_REVALIDATE if filename.endswith(".html") else CACHE_IMMUTABLE
+        table.append('    { "%s", "%s", %s, sizeof(%s), "\\"%s\\"", "%s" },'
+                     % (path, content_type, name, name, etag(data), cache))
+    out.append("static constexpr WebAsset WEB_ASSETS[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("")
+    return "\n".join(out)
+
+
+def write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path, "r", encoding="utf-8") as f:
+            if f.read() == text:
+                return False
+    with open(path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+    return True
+
+
+def main(root):
+    header = os.path.join(root, "src", "web_assets.h")
+    if write_if_changed(header, build(root)):
+        print("embed_web_assets: wrote %s" % os.path.relpath(header, root))
+    return 0
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run by PlatformIO
+    main(env["PROJECT_DIR"])  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        sys.exit(main(os.path.dirname(os.path.dirname(os.path.abspath(__file__)))))
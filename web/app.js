@@ -0,0 +1,85 @@
+// History is fetched one page at a time (newest first), so the
+// browser never holds more than PAGE_SIZE rows.
+const PAGE_SIZE = 50;
+let currentPage = 0;
+
+// The page itself is static (cached by the browser); the values come from the JSON API
+function loadCurrent() {
+    fetch('/api/current')
+    .then(response => response.json())
+    .then(data => {
+        document.getElementById('temperature').textContent = (data.temperature === null) ? '--' : data.temperature.toFixed(1);
+        document.getElementById('humidity').textContent = (data.humidity === null) ? '--' : data.humidity.toFixed(1);
+        document.getElementById('measuredAt').textContent = data.time;
+    })
+    .catch(error => console.error('Error:', error));
+
+    fetch('/api/status')
+    .then(response => response.json())
+    .then(data => { document.getElementById('systemTime').textContent = data.time; })
+    .catch(error => console.error('Error:', error));
+
+    fetch('/api/config')
+    .then(response => response.json())
+    .then(data => { document.getElementById('ssid').textContent = data.ssid; })
+    .catch(error => console.error('Error:', error));
+}
+
+// Live readings while the device is awake (Server-Sent Events from /events).
+// The browser reconnects on its own and sends Last-Event-ID, so the device
+// replays what was missed. Once the device sleeps, the last values stay shown.
+function startLive() {
+    if (!window.EventSource) return;
+    const source = new EventSource('/events');
+    source.addEventListener('sample', event => {
+        const s = JSON.parse(event.data);
+        if (s.temperature === null || s.humidity === null) return;
+        document.getElementById('temperature').textContent = s.temperature.toFixed(1);
+        document.getElementById('humidity').textContent = s.humidity.toFixed(1);
+        document.getElementById('measuredAt').textContent = 'Live, ' + new Date().toLocaleTimeString();
+    });
+}
+
+function loadPage(page) {
+    if (page < 0) return;
+    document.getElementById('newerBtn').disabled = true;
+    document.getElementById('olderBtn').disabled = true;
+
+    fetch('/api/history?page=' + page + '&size=' + PAGE_SIZE)
+    .then(response => {
+        if (!response.ok) throw new Error("No data");
+        return response.json();
+    })
+    .then(data => {
+        if (data.total === 0) {
+            document.getElementById('dataTable').innerHTML = "<div style='padding:20px'>No data logged yet.</div>";
+            return;
+        }
+
+        let tableHtml = '<table><thead><tr><th>Timestamp</th><th>Humidity (%)</th><th>Temperature (C)</th></tr></thead><tbody>';
+        data.records.forEach(r => {
+            // flags bit 0 = timestamp valid, bit 2 = provisional (seconds since power-on)
+            const ts = (r[3] & 1) ? new Date(r[0] * 1000).toLocaleString()
+                     : (r[3] & 4) ? 'Provisional (+' + r[0] + ' s)' : 'Time Not Set';
+            tableHtml += '<tr><td>' + ts + '</td><td>' + r[2].toFixed(1) + '</td><td>' + r[1].toFixed(1) + '</td></tr>';
+        });
+        tableHtml += '</tbody></table>';
+
+        currentPage = page;
+        const pageCount = Math.ceil(data.total / PAGE_SIZE);
+        document.getElementById('dataTable').innerHTML = tableHtml;
+        document.getElementById('pageInfo').textContent = 'Page ' + (page + 1) + ' of ' + pageCount + ' (' + data.total + ' entries)';
+        document.getElementById('newerBtn').disabled = (page === 0);
+        document.getElementById('olderBtn').disabled = (page + 1 >= pageCount);
+    })
+    .catch(error => {
+        console.error('Error:', error);
+        document.getElementById('dataTable').innerHTML = "<div style='padding:20px; color:red'>Error loading data.</div>";
+    });
+}
+
+document.addEventListener('DOMContentLoaded', function() {
+    loadCurrent();
+    loadPage(0);
+    startLive();
+});